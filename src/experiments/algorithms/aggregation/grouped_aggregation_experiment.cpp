@@ -0,0 +1,131 @@
+/**
+ * @file grouped_aggregation_experiment.cpp
+ * @brief Grouped SUM / MIN / MAX / AVG with slot reuse compared to one probing pass per aggregate.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <limits>
+#include <cstdint>
+#include <cstdlib>
+
+#include "../../../main/algorithms/aggregation/grouped_aggregation.h"
+
+#define DATACOUNT_AGGREGATION_EXPERIMENT_L3 4096000
+#define DATACOUNT_AGGREGATION_EXPERIMENT_BLOB_400MB 100000000
+#define PAYLOAD_COUNT_AGGREGATION_EXPERIMENT 2
+
+//#define NUM_AGGREGATION_EXPERIMENT_REP 5
+int NUM_AGGREGATION_EXPERIMENT_REP;
+
+/* Baseline: the histogramm only counts, every aggregate of every column probes all keys again. */
+template< uint32_t loadFactor, uint32_t DATACOUNT_AGGREGATION_EXPERIMENT >
+int64_t separate_passes( uint32_t const * const keys, int64_t const * const * const columns, size_t & group_count ) {
+   const_sized_basic_histogramm< uint32_t > histogramm{ DATACOUNT_AGGREGATION_EXPERIMENT, loadFactor };
+   histogramm.build_vectorized_batch( keys );
+   size_t const size = histogramm.get_size( );
+   int64_t * const sums = new int64_t[ size ]( );
+   int64_t * const mins = new int64_t[ size ];
+   int64_t * const maxs = new int64_t[ size ];
+   int64_t checksum = 0;
+   for( size_t column = 0; column < PAYLOAD_COUNT_AGGREGATION_EXPERIMENT; ++column ) {
+      for( size_t slot = 0; slot < size; ++slot ) {
+         sums[ slot ] = 0;
+         mins[ slot ] = std::numeric_limits< int64_t >::max( );
+         maxs[ slot ] = std::numeric_limits< int64_t >::lowest( );
+      }
+      int64_t const * const values = columns[ column ];
+      for( size_t row = 0; row < DATACOUNT_AGGREGATION_EXPERIMENT; ++row )
+         sums[ histogramm.probe( keys[ row ] ) ] += values[ row ];
+      for( size_t row = 0; row < DATACOUNT_AGGREGATION_EXPERIMENT; ++row ) {
+         size_t const slot = histogramm.probe( keys[ row ] );
+         mins[ slot ] = ( values[ row ] < mins[ slot ] ) ? values[ row ] : mins[ slot ];
+      }
+      for( size_t row = 0; row < DATACOUNT_AGGREGATION_EXPERIMENT; ++row ) {
+         size_t const slot = histogramm.probe( keys[ row ] );
+         maxs[ slot ] = ( values[ row ] > maxs[ slot ] ) ? values[ row ] : maxs[ slot ];
+      }
+      checksum += sums[ histogramm.probe( keys[ 0 ] ) ] + mins[ histogramm.probe( keys[ 0 ] ) ] + maxs[ histogramm.probe( keys[ 0 ] ) ];
+   }
+   group_count = histogramm.key_count( );
+   delete[ ] maxs;
+   delete[ ] mins;
+   delete[ ] sums;
+   return checksum;
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_AGGREGATION_EXPERIMENT, uint32_t GroupSize >
+void test_grouped_aggregation( void ) {
+   uint32_t * keys = ( uint32_t * ) malloc( DATACOUNT_AGGREGATION_EXPERIMENT * sizeof( uint32_t ) );
+   int64_t * columns[ PAYLOAD_COUNT_AGGREGATION_EXPERIMENT ];
+   std::mt19937 generator( 65536 );
+   std::uniform_int_distribution< uint32_t > key_dist( 1, DATACOUNT_AGGREGATION_EXPERIMENT / GroupSize );
+   std::uniform_int_distribution< int64_t > value_dist( -1000000, 1000000 );
+   for( size_t column = 0; column < PAYLOAD_COUNT_AGGREGATION_EXPERIMENT; ++column )
+      columns[ column ] = ( int64_t * ) malloc( DATACOUNT_AGGREGATION_EXPERIMENT * sizeof( int64_t ) );
+   for( size_t position = 0; position < DATACOUNT_AGGREGATION_EXPERIMENT; ++position ) {
+      keys[ position ] = key_dist( generator );
+      for( size_t column = 0; column < PAYLOAD_COUNT_AGGREGATION_EXPERIMENT; ++column )
+         columns[ column ][ position ] = value_dist( generator );
+   }
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_AGGREGATION_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_AGGREGATION_EXPERIMENT << " Grouped Aggregation ( GroupSize " << GroupSize << " ): Loadfactor: "
+                << loadFactor << " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_AGGREGATION_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      auto start = std::chrono::high_resolution_clock::now( );
+      grouped_aggregation< uint32_t > aggregation{ DATACOUNT_AGGREGATION_EXPERIMENT, loadFactor, PAYLOAD_COUNT_AGGREGATION_EXPERIMENT,
+                                                   AGGREGATE_SUM | AGGREGATE_MIN | AGGREGATE_MAX | AGGREGATE_AVG };
+      aggregation.build( keys, columns );
+      auto end_fused = std::chrono::high_resolution_clock::now( );
+      size_t group_count = 0;
+      int64_t const checksum = separate_passes< loadFactor, DATACOUNT_AGGREGATION_EXPERIMENT >( keys, columns, group_count );
+      auto end_separate = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;SLOT_REUSE;32;" << i << ";" << DATACOUNT_AGGREGATION_EXPERIMENT << ";" << GroupSize << ";"
+                   << loadFactor << ";" << aggregation.get_histogramm( ).get_size( ) << ";" << aggregation.get_group_count( ) << ";"
+                   << std::chrono::duration< double, std::milli >( end_fused - start ).count( ) << "\n";
+         std::cout << "BUILD;PASS_PER_AGGREGATE;32;" << i << ";" << DATACOUNT_AGGREGATION_EXPERIMENT << ";" << GroupSize << ";"
+                   << loadFactor << ";" << aggregation.get_histogramm( ).get_size( ) << ";" << group_count << ";"
+                   << std::chrono::duration< double, std::milli >( end_separate - end_fused ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end_fused - start ).count( ) << " ms / "
+                << std::chrono::duration< double, std::milli >( end_separate - end_fused ).count( ) << " ms, checksum "
+                << checksum << " )\n";
+   }
+   for( size_t column = 0; column < PAYLOAD_COUNT_AGGREGATION_EXPERIMENT; ++column )
+      free( ( void * ) columns[ column ] );
+   free( ( void * ) keys );
+}
+
+template< uint32_t DATACOUNT_AGGREGATION_EXPERIMENT >
+void test( void ) {
+   test_grouped_aggregation< 50, DATACOUNT_AGGREGATION_EXPERIMENT, 1 >( );
+   test_grouped_aggregation< 50, DATACOUNT_AGGREGATION_EXPERIMENT, 16 >( );
+   test_grouped_aggregation< 90, DATACOUNT_AGGREGATION_EXPERIMENT, 1 >( );
+   test_grouped_aggregation< 90, DATACOUNT_AGGREGATION_EXPERIMENT, 16 >( );
+}
+
+int main( int argc, char** argv ) {
+
+   if( argc == 1 )
+      NUM_AGGREGATION_EXPERIMENT_REP = 10;
+   else
+      NUM_AGGREGATION_EXPERIMENT_REP = std::atoi( argv[ 1 ] );
+
+   std::cout << "#Data:\n" <<
+             "#         Generator: " << "std::mt19937\n" <<
+             "#              Seed: " << "65536\n" <<
+             "#      Distribution: " << "uniform over DataCount / GroupSize keys, payload uniform in [ -1e6, 1e6 ]\n" <<
+             "#        Aggregates: " << "SUM, MIN, MAX, AVG of " << PAYLOAD_COUNT_AGGREGATION_EXPERIMENT << " payload columns\n" <<
+             "Phase;Variant;BitWidth;Rep;DataCount;GroupSize;LoadFactor;ContainerSize;GroupCount;TimeMs\n";
+
+   test< DATACOUNT_AGGREGATION_EXPERIMENT_L3 >( );
+   test< DATACOUNT_AGGREGATION_EXPERIMENT_BLOB_400MB >( );
+
+   return 0;
+}
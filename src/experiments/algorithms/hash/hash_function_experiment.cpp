@@ -0,0 +1,198 @@
+/**
+ * @file hash_function_experiment.cpp
+ * @brief Throughput of the hash function policies and the probe lengths they cause in the histogramm.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <limits>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include "../../../main/datastructures/set/hash_set.h"
+#include "../../../main/algorithms/hash/murmur3.h"
+#include "../../../main/algorithms/hash/multiply_shift.h"
+#include "../../../main/algorithms/hash/crc32c.h"
+#include "../../../main/algorithms/hash/tabulation.h"
+
+#define DATACOUNT_HASHFUNCTION_EXPERIMENT_L3 4096000
+#define DATACOUNT_HASHFUNCTION_EXPERIMENT_BLOB_400MB 100000000
+
+//#define NUM_HASHFUNCTION_EXPERIMENT_REP 5
+int NUM_HASHFUNCTION_EXPERIMENT_REP;
+
+enum key_distribution {
+   DISTRIBUTION_UNIFORM,
+   DISTRIBUTION_SEQUENTIAL,
+   DISTRIBUTION_SKEWED
+};
+
+template< class HashFunction >
+std::string hash_function_name( void );
+template< >
+std::string hash_function_name< murmur3< uint32_t > >( void ) {
+   return "MURMUR3";
+}
+template< >
+std::string hash_function_name< multiply_shift< uint32_t > >( void ) {
+   return "MULTIPLY_SHIFT";
+}
+template< >
+std::string hash_function_name< crc32c< uint32_t > >( void ) {
+   return "CRC32C";
+}
+template< >
+std::string hash_function_name< tabulation< uint32_t > >( void ) {
+   return "TABULATION";
+}
+
+std::string distribution_name( key_distribution const distribution ) {
+   switch( distribution ) {
+      case DISTRIBUTION_UNIFORM:
+         return "UNIFORM";
+      case DISTRIBUTION_SEQUENTIAL:
+         return "SEQUENTIAL";
+      case DISTRIBUTION_SKEWED:
+         return "SKEWED";
+   }
+   return "";
+}
+
+/* uniform over [ 1, 2^32 - 1 ], the dense range 1..count, or log-uniform over [ 1, count ] (small keys are frequent) */
+void generate( uint32_t * const data, size_t const count, key_distribution const distribution ) {
+   std::mt19937 generator( 65536 );
+   std::uniform_int_distribution< uint32_t > uniform( 1, std::numeric_limits< uint32_t >::max( ) );
+   std::uniform_real_distribution< double > exponent( 0.0, std::log( ( double ) count ) );
+   for( size_t position = 0; position < count; ++position ) {
+      switch( distribution ) {
+         case DISTRIBUTION_UNIFORM:
+            data[ position ] = uniform( generator );
+            break;
+         case DISTRIBUTION_SEQUENTIAL:
+            data[ position ] = ( uint32_t ) ( position + 1 );
+            break;
+         case DISTRIBUTION_SKEWED:
+            data[ position ] = ( uint32_t ) std::exp( exponent( generator ) );
+            break;
+      }
+   }
+}
+
+/**
+ * HASH: time to hash all keys. BUILD: build_vectorized_batch with the policy. PROBE: probe_grouped of all keys.
+ * The probe length of a distinct key is the number of slots from its home slot to its slot, the BUILD row reports
+ * mean, median, 90th and 99th percentile and maximum over all distinct keys.
+ */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHFUNCTION_EXPERIMENT, class HashFunction >
+void test_hash_function( uint32_t const * const data, key_distribution const distribution ) {
+   typedef const_sized_basic_histogramm< uint32_t, slot_mapping_modulo, HashFunction > histogramm_t;
+   uint32_t * probe_result = ( uint32_t * ) malloc( DATACOUNT_HASHFUNCTION_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * probe_result_count = ( uint32_t * ) malloc( DATACOUNT_HASHFUNCTION_EXPERIMENT * sizeof( uint32_t ) );
+   std::string const name = hash_function_name< HashFunction >( ) + ";" + distribution_name( distribution );
+   HashFunction const hash_fn;
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHFUNCTION_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHFUNCTION_EXPERIMENT << " " << hash_function_name< HashFunction >( ) << " "
+                << distribution_name( distribution ) << ": Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHFUNCTION_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      uint32_t checksum = 0;
+      auto start = std::chrono::high_resolution_clock::now( );
+      for( size_t position = 0; position < DATACOUNT_HASHFUNCTION_EXPERIMENT; ++position ) {
+         checksum ^= ( uint32_t ) hash_fn( data[ position ] );
+      }
+      auto end_hash = std::chrono::high_resolution_clock::now( );
+      histogramm_t histogramm{ DATACOUNT_HASHFUNCTION_EXPERIMENT, loadFactor };
+      auto start_build = std::chrono::high_resolution_clock::now( );
+      histogramm.build_vectorized_batch( data );
+      auto end_build = std::chrono::high_resolution_clock::now( );
+      size_t const result_size =
+         histogramm.probe_grouped( data, DATACOUNT_HASHFUNCTION_EXPERIMENT, probe_result, probe_result_count );
+      auto end_probe = std::chrono::high_resolution_clock::now( );
+
+      size_t const container_size = histogramm.get_size( );
+      slot_mapping_modulo const slot_mapping{ container_size };
+      uint32_t const * const keys = histogramm.get_key_container( );
+      std::vector< size_t > probe_lengths;
+      for( size_t slot = 0; slot < container_size; ++slot ) {
+         if( keys[ slot ] == 0 )
+            continue;
+         size_t const home = slot_mapping( hash_fn( keys[ slot ] ), 0 );
+         probe_lengths.push_back( ( slot + container_size - home ) % container_size + 1 );
+      }
+      std::sort( probe_lengths.begin( ), probe_lengths.end( ) );
+      double mean = 0.0;
+      for( size_t const length : probe_lengths )
+         mean += ( double ) length;
+      mean /= ( double ) probe_lengths.size( );
+      size_t const distinct = probe_lengths.size( );
+
+      if( i > 0 ) {
+         std::cout << "HASH;" << name << ";32;" << i << ";" << DATACOUNT_HASHFUNCTION_EXPERIMENT << ";" << loadFactor << ";"
+                   << container_size << ";" << distinct << ";"
+                   << std::chrono::duration< double, std::milli >( end_hash - start ).count( ) << ";;;;;\n";
+         std::cout << "BUILD;" << name << ";32;" << i << ";" << DATACOUNT_HASHFUNCTION_EXPERIMENT << ";" << loadFactor << ";"
+                   << container_size << ";" << distinct << ";"
+                   << std::chrono::duration< double, std::milli >( end_build - start_build ).count( ) << ";"
+                   << mean << ";" << probe_lengths[ distinct / 2 ] << ";" << probe_lengths[ distinct * 9 / 10 ] << ";"
+                   << probe_lengths[ distinct * 99 / 100 ] << ";" << probe_lengths.back( ) << "\n";
+         std::cout << "PROBE;" << name << ";32;" << i << ";" << DATACOUNT_HASHFUNCTION_EXPERIMENT << ";" << loadFactor << ";"
+                   << container_size << ";" << result_size << ";"
+                   << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << ";;;;;\n";
+      }
+      std::cerr << "Done ( hash " << std::chrono::duration< double, std::milli >( end_hash - start ).count( ) << " ms, build "
+                << std::chrono::duration< double, std::milli >( end_build - start_build ).count( ) << " ms, probe "
+                << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << " ms, mean probe length "
+                << mean << ", max " << probe_lengths.back( ) << ", checksum " << checksum << " )\n";
+   }
+   free( ( void * ) probe_result_count );
+   free( ( void * ) probe_result );
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHFUNCTION_EXPERIMENT >
+void test_hash_functions( uint32_t const * const data, key_distribution const distribution ) {
+   test_hash_function< loadFactor, DATACOUNT_HASHFUNCTION_EXPERIMENT, murmur3< uint32_t > >( data, distribution );
+   test_hash_function< loadFactor, DATACOUNT_HASHFUNCTION_EXPERIMENT, multiply_shift< uint32_t > >( data, distribution );
+   test_hash_function< loadFactor, DATACOUNT_HASHFUNCTION_EXPERIMENT, crc32c< uint32_t > >( data, distribution );
+   test_hash_function< loadFactor, DATACOUNT_HASHFUNCTION_EXPERIMENT, tabulation< uint32_t > >( data, distribution );
+}
+
+template< uint32_t DATACOUNT_HASHFUNCTION_EXPERIMENT >
+void test( void ) {
+   uint32_t * data = ( uint32_t * ) malloc( DATACOUNT_HASHFUNCTION_EXPERIMENT * sizeof( uint32_t ) );
+   key_distribution const distributions[ 3 ] = { DISTRIBUTION_UNIFORM, DISTRIBUTION_SEQUENTIAL, DISTRIBUTION_SKEWED };
+   for( key_distribution const distribution : distributions ) {
+      generate( data, DATACOUNT_HASHFUNCTION_EXPERIMENT, distribution );
+      test_hash_functions< 50, DATACOUNT_HASHFUNCTION_EXPERIMENT >( data, distribution );
+      test_hash_functions< 90, DATACOUNT_HASHFUNCTION_EXPERIMENT >( data, distribution );
+   }
+   free( ( void * ) data );
+}
+
+int main( int argc, char** argv ) {
+
+   if( argc == 1 )
+      NUM_HASHFUNCTION_EXPERIMENT_REP = 10;
+   else
+      NUM_HASHFUNCTION_EXPERIMENT_REP = std::atoi( argv[ 1 ] );
+
+   std::cout << "#Data:\n" <<
+             "#         Generator: " << "std::mt19937\n" <<
+             "#              Seed: " << "65536\n" <<
+             "#      Distribution: " << "UNIFORM [ 1, 2^32 - 1 ], SEQUENTIAL 1..DataCount, SKEWED log-uniform [ 1, DataCount ]\n" <<
+             "Phase;Hash;Distribution;BitWidth;Rep;DataCount;LoadFactor;ContainerSize;DistinctKeysInContainer;TimeMs;"
+             "MeanProbeLength;P50ProbeLength;P90ProbeLength;P99ProbeLength;MaxProbeLength\n";
+
+   test< DATACOUNT_HASHFUNCTION_EXPERIMENT_L3 >( );
+   test< DATACOUNT_HASHFUNCTION_EXPERIMENT_BLOB_400MB >( );
+
+   return 0;
+}
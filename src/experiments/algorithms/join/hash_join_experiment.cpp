@@ -0,0 +1,106 @@
+/**
+ * @file hash_join_experiment.cpp
+ * @brief Build and probe time of the histogramm hash join for different load factors and build key multiplicities.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <limits>
+#include <cstdint>
+#include <cstdlib>
+
+#include "../../../main/algorithms/join/hash_join.h"
+
+#define DATACOUNT_HASHJOIN_EXPERIMENT_L3 4096000
+#define DATACOUNT_HASHJOIN_EXPERIMENT_BLOB_400MB 100000000
+#define HASHJOIN_EXPERIMENT_OUTPUT_CAPACITY 65536
+
+//#define NUM_HASHJOIN_EXPERIMENT_REP 5
+int NUM_HASHJOIN_EXPERIMENT_REP;
+
+/* Every build key occurs Multiplicity times on average. Probe keys are drawn from twice the build key domain, so
+ * about half of them hit. */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHJOIN_EXPERIMENT, uint32_t Multiplicity >
+void test_hash_join( void ) {
+   uint32_t * build_keys = ( uint32_t * ) malloc( DATACOUNT_HASHJOIN_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * probe_keys = ( uint32_t * ) malloc( DATACOUNT_HASHJOIN_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * out_build = ( uint32_t * ) malloc( HASHJOIN_EXPERIMENT_OUTPUT_CAPACITY * sizeof( uint32_t ) );
+   uint32_t * out_probe = ( uint32_t * ) malloc( HASHJOIN_EXPERIMENT_OUTPUT_CAPACITY * sizeof( uint32_t ) );
+   std::mt19937 generator( 65536 );
+   std::uniform_int_distribution< uint32_t > build_dist( 1, DATACOUNT_HASHJOIN_EXPERIMENT / Multiplicity );
+   std::uniform_int_distribution< uint32_t > probe_dist( 1, 2 * ( DATACOUNT_HASHJOIN_EXPERIMENT / Multiplicity ) );
+   for( size_t position = 0; position < DATACOUNT_HASHJOIN_EXPERIMENT; ++position ) {
+      build_keys[ position ] = build_dist( generator );
+      probe_keys[ position ] = probe_dist( generator );
+   }
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHJOIN_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHJOIN_EXPERIMENT << " Hash Join ( Multiplicity " << Multiplicity << " ): Loadfactor: "
+                << loadFactor << " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHJOIN_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      histogramm_hash_join< uint32_t > join{ DATACOUNT_HASHJOIN_EXPERIMENT, loadFactor };
+      auto start = std::chrono::high_resolution_clock::now( );
+      join.build( build_keys );
+      auto end_build = std::chrono::high_resolution_clock::now( );
+      histogramm_hash_join< uint32_t >::probe_cursor cursor;
+      size_t pair_count = 0;
+      uint64_t checksum = 0;
+      while( cursor.probe_position < DATACOUNT_HASHJOIN_EXPERIMENT ) {
+         size_t const written = join.probe( probe_keys, DATACOUNT_HASHJOIN_EXPERIMENT,
+                                            out_build, out_probe, HASHJOIN_EXPERIMENT_OUTPUT_CAPACITY, cursor );
+         pair_count += written;
+         /* consumes the buffer, so the stores can not be optimized away */
+         for( size_t j = 0; j < written; ++j )
+            checksum += out_build[ j ] ^ out_probe[ j ];
+      }
+      auto end_probe = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;HASH_JOIN;32;" << i << ";" << DATACOUNT_HASHJOIN_EXPERIMENT << ";" << Multiplicity << ";"
+                   << loadFactor << ";" << join.get_histogramm( ).get_size( ) << ";" << join.get_histogramm( ).key_count( ) << ";"
+                   << std::chrono::duration< double, std::milli >( end_build - start ).count( ) << "\n";
+         std::cout << "PROBE;HASH_JOIN;32;" << i << ";" << DATACOUNT_HASHJOIN_EXPERIMENT << ";" << Multiplicity << ";"
+                   << loadFactor << ";" << join.get_histogramm( ).get_size( ) << ";" << pair_count << ";"
+                   << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end_build - start ).count( ) << " ms / "
+                << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << " ms, checksum "
+                << checksum << " )\n";
+   }
+   free( ( void * ) out_probe );
+   free( ( void * ) out_build );
+   free( ( void * ) probe_keys );
+   free( ( void * ) build_keys );
+}
+
+template< uint32_t DATACOUNT_HASHJOIN_EXPERIMENT >
+void test( void ) {
+   test_hash_join< 50, DATACOUNT_HASHJOIN_EXPERIMENT, 1 >( );
+   test_hash_join< 50, DATACOUNT_HASHJOIN_EXPERIMENT, 4 >( );
+   test_hash_join< 50, DATACOUNT_HASHJOIN_EXPERIMENT, 16 >( );
+   test_hash_join< 90, DATACOUNT_HASHJOIN_EXPERIMENT, 1 >( );
+   test_hash_join< 90, DATACOUNT_HASHJOIN_EXPERIMENT, 4 >( );
+   test_hash_join< 90, DATACOUNT_HASHJOIN_EXPERIMENT, 16 >( );
+}
+
+int main( int argc, char** argv ) {
+
+   if( argc == 1 )
+      NUM_HASHJOIN_EXPERIMENT_REP = 10;
+   else
+      NUM_HASHJOIN_EXPERIMENT_REP = std::atoi( argv[ 1 ] );
+
+   std::cout << "#Data:\n" <<
+             "#         Generator: " << "std::mt19937\n" <<
+             "#              Seed: " << "65536\n" <<
+             "#      Distribution: " << "uniform over DataCount / Multiplicity build keys\n" <<
+             "Phase;Variant;BitWidth;Rep;DataCount;Multiplicity;LoadFactor;ContainerSize;ResultCount;TimeMs\n";
+
+   test< DATACOUNT_HASHJOIN_EXPERIMENT_L3 >( );
+   test< DATACOUNT_HASHJOIN_EXPERIMENT_BLOB_400MB >( );
+
+   return 0;
+}
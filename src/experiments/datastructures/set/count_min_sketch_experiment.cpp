@@ -0,0 +1,156 @@
+/**
+ * @file count_min_sketch_experiment.cpp
+ * @brief Accuracy against memory of the count-min and count sketch, compared with the exact histogramm.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "../../../main/datastructures/set/hash_set.h"
+#include "../../../main/datastructures/set/count_min_sketch.h"
+
+#define DATACOUNT_COUNT_MIN_EXPERIMENT_L2 64000
+#define DATACOUNT_COUNT_MIN_EXPERIMENT_L3 4096000
+#define DATACOUNT_COUNT_MIN_EXPERIMENT_BLOB_400MB 100000000
+
+#define LOADFACTOR_COUNT_MIN_EXPERIMENT 90
+
+int NUM_HASHSET_EXPERIMENT_REP;
+
+/* Build, batched lookup of all distinct keys and the error of the estimates against the exact counts: ERROR rows
+ * hold the mean ( _AVG ) and maximum ( _MAX ) absolute error in TimeMs. */
+template< uint32_t DATACOUNT_COUNT_MIN_EXPERIMENT, bool Signed, size_t Width, size_t Depth >
+void test_sketch( uint32_t const * const data, std::vector< uint32_t > const & distinct_keys,
+                  std::vector< uint64_t > const & exact_counts ) {
+   typedef count_min_sketch< uint32_t, Signed > sketch_t;
+   std::string const variant = std::string{ Signed ? "CS" : "CMS" } + "_W" + std::to_string( Width ) + "_D" + std::to_string( Depth );
+   std::vector< typename sketch_t::counter_t > estimates( distinct_keys.size( ) );
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_COUNT_MIN_EXPERIMENT << "  " << variant
+                << ": [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: " << std::flush;
+      sketch_t sketch{ Width, Depth };
+      auto start = std::chrono::high_resolution_clock::now( );
+      sketch.build( data, DATACOUNT_COUNT_MIN_EXPERIMENT );
+      auto end_build = std::chrono::high_resolution_clock::now( );
+      sketch.get_counts( distinct_keys.data( ), distinct_keys.size( ), estimates.data( ) );
+      auto end_probe = std::chrono::high_resolution_clock::now( );
+      double error_sum = 0.0;
+      double error_max = 0.0;
+      for( size_t key = 0; key < distinct_keys.size( ); ++key ) {
+         double const error = std::fabs( ( double ) ( int64_t ) estimates[ key ] - ( double ) exact_counts[ key ] );
+         error_sum += error;
+         error_max = ( error > error_max ) ? error : error_max;
+      }
+      double const error_avg = error_sum / ( double ) distinct_keys.size( );
+      if( i > 0 ) {
+         std::cout << "BUILD;" << variant << ";32;" << i << ";" << DATACOUNT_COUNT_MIN_EXPERIMENT << ";"
+                   << LOADFACTOR_COUNT_MIN_EXPERIMENT << ";" << sketch.get_memory_footprint( ) << ";"
+                   << distinct_keys.size( ) << ";"
+                   << std::chrono::duration< double, std::milli >( end_build - start ).count( ) << "\n";
+         std::cout << "PROBE;" << variant << ";32;" << i << ";" << DATACOUNT_COUNT_MIN_EXPERIMENT << ";"
+                   << LOADFACTOR_COUNT_MIN_EXPERIMENT << ";" << sketch.get_memory_footprint( ) << ";"
+                   << distinct_keys.size( ) << ";"
+                   << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << "\n";
+         std::cout << "ERROR;" << variant << "_AVG;32;" << i << ";" << DATACOUNT_COUNT_MIN_EXPERIMENT << ";"
+                   << LOADFACTOR_COUNT_MIN_EXPERIMENT << ";" << sketch.get_memory_footprint( ) << ";"
+                   << distinct_keys.size( ) << ";" << error_avg << "\n";
+         std::cout << "ERROR;" << variant << "_MAX;32;" << i << ";" << DATACOUNT_COUNT_MIN_EXPERIMENT << ";"
+                   << LOADFACTOR_COUNT_MIN_EXPERIMENT << ";" << sketch.get_memory_footprint( ) << ";"
+                   << distinct_keys.size( ) << ";" << error_max << "\n";
+      }
+      std::cerr << "Done ( build " << std::chrono::duration< double, std::milli >( end_build - start ).count( ) << " ms, probe "
+                << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << " ms, avg error "
+                << error_avg << ", max error " << error_max << " )\n";
+   }
+}
+
+/* the exact histogramm, ContainerSize slots of a 32-bit key and a 64-bit count */
+template< uint32_t DATACOUNT_COUNT_MIN_EXPERIMENT >
+void test_exact( uint32_t const * const data ) {
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_COUNT_MIN_EXPERIMENT << "  Exact: [ " << std::setw( 2 ) << i << " / "
+                << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: " << std::flush;
+      auto start = std::chrono::high_resolution_clock::now( );
+      const_sized_basic_histogramm< uint32_t > histogramm{ DATACOUNT_COUNT_MIN_EXPERIMENT, LOADFACTOR_COUNT_MIN_EXPERIMENT };
+      histogramm.build_vectorized_batch( data );
+      auto end = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;EXACT;32;" << i << ";" << DATACOUNT_COUNT_MIN_EXPERIMENT << ";"
+                   << LOADFACTOR_COUNT_MIN_EXPERIMENT << ";" << histogramm.get_size( ) << ";"
+                   << histogramm.key_count( ) << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+   }
+}
+
+template< uint32_t DATACOUNT_COUNT_MIN_EXPERIMENT >
+void test( void ) {
+   uint32_t * data = ( uint32_t * ) malloc( DATACOUNT_COUNT_MIN_EXPERIMENT * sizeof( uint32_t ) );
+   /* log-uniform ranks ( Zipf with s = 1 ), scrambled into non zero keys by an odd multiplier */
+   std::mt19937 generator( 65536 );
+   std::uniform_real_distribution< double > dist( 0.0, 1.0 );
+   double const log_range = std::log( ( double ) DATACOUNT_COUNT_MIN_EXPERIMENT );
+   for( size_t position = 0; position < DATACOUNT_COUNT_MIN_EXPERIMENT; ++position ) {
+      uint32_t const rank = ( uint32_t ) std::exp( dist( generator ) * log_range );
+      data[ position ] = rank * 0x9e3779b1U;
+   }
+   std::vector< uint32_t > distinct_keys;
+   std::vector< uint64_t > exact_counts;
+   {
+      const_sized_basic_histogramm< uint32_t > histogramm{ DATACOUNT_COUNT_MIN_EXPERIMENT, LOADFACTOR_COUNT_MIN_EXPERIMENT };
+      histogramm.build_vectorized_batch( data );
+      for( size_t slot = 0; slot < histogramm.get_size( ); ++slot ) {
+         if( histogramm.get_key_count_container( )[ slot ] != 0 ) {
+            distinct_keys.push_back( histogramm.get_key_container( )[ slot ] );
+            exact_counts.push_back( histogramm.get_key_count_container( )[ slot ] );
+         }
+      }
+   }
+   test_exact< DATACOUNT_COUNT_MIN_EXPERIMENT >( data );
+   test_sketch< DATACOUNT_COUNT_MIN_EXPERIMENT, false, 256, 4 >( data, distinct_keys, exact_counts );
+   test_sketch< DATACOUNT_COUNT_MIN_EXPERIMENT, false, 4096, 4 >( data, distinct_keys, exact_counts );
+   test_sketch< DATACOUNT_COUNT_MIN_EXPERIMENT, false, 65536, 1 >( data, distinct_keys, exact_counts );
+   test_sketch< DATACOUNT_COUNT_MIN_EXPERIMENT, false, 65536, 2 >( data, distinct_keys, exact_counts );
+   test_sketch< DATACOUNT_COUNT_MIN_EXPERIMENT, false, 65536, 4 >( data, distinct_keys, exact_counts );
+   test_sketch< DATACOUNT_COUNT_MIN_EXPERIMENT, false, 65536, 8 >( data, distinct_keys, exact_counts );
+   test_sketch< DATACOUNT_COUNT_MIN_EXPERIMENT, false, 1048576, 4 >( data, distinct_keys, exact_counts );
+   test_sketch< DATACOUNT_COUNT_MIN_EXPERIMENT, true, 256, 5 >( data, distinct_keys, exact_counts );
+   test_sketch< DATACOUNT_COUNT_MIN_EXPERIMENT, true, 4096, 5 >( data, distinct_keys, exact_counts );
+   test_sketch< DATACOUNT_COUNT_MIN_EXPERIMENT, true, 65536, 5 >( data, distinct_keys, exact_counts );
+   test_sketch< DATACOUNT_COUNT_MIN_EXPERIMENT, true, 1048576, 5 >( data, distinct_keys, exact_counts );
+   free( ( void * ) data );
+}
+
+int main( int argc, char** argv ) {
+
+   if( argc == 1 )
+      NUM_HASHSET_EXPERIMENT_REP = 10;
+   else
+      NUM_HASHSET_EXPERIMENT_REP = std::atoi( argv[ 1 ] );
+
+   std::cout << "#Data:\n" <<
+             "#         Generator: " << "std::mt19937\n" <<
+             "#              Seed: " << "65536\n" <<
+             "#      Distribution: " << "exp( U[ 0, 1 ) * ln( DataCount ) ) * 0x9e3779b1 ( Zipf, s = 1 )\n" <<
+             "#Sketch: ContainerSize holds the bytes of the sketch ( slots of the EXACT histogramm ), ERROR rows hold the\n" <<
+             "#        absolute error of the estimated counts of all distinct keys in TimeMs.\n" <<
+             "Phase;Variant;BitWidth;Rep;DataCount;LoadFactor;ContainerSize;DistinctKeysInContainer;TimeMs\n";
+
+   test< DATACOUNT_COUNT_MIN_EXPERIMENT_L2 >( );
+   test< DATACOUNT_COUNT_MIN_EXPERIMENT_L3 >( );
+   test< DATACOUNT_COUNT_MIN_EXPERIMENT_BLOB_400MB >( );
+
+   return 0;
+}
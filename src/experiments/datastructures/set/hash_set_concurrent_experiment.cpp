@@ -0,0 +1,131 @@
+/**
+ * @file hash_set_concurrent_experiment.cpp
+ * @brief Contention of the concurrent histogramm builds on uniform and zipf distributed keys.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <limits>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <string>
+
+#include "../../../main/datastructures/set/hash_set.h"
+#include "../../../main/utils/threading.h"
+
+#define DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT_L3 4096000
+#define DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT_BLOB_400MB 100000000
+#define DISTINCT_HASHSET_CONCURRENT_EXPERIMENT 1000000
+
+//#define NUM_HASHSET_CONCURRENT_EXPERIMENT_REP 5
+int NUM_HASHSET_CONCURRENT_EXPERIMENT_REP;
+
+/* Draws ranks with probability proportional to 1 / rank^skew and scrambles them, so hot keys are spread over the
+ * key domain. Skew 0 yields uniformly distributed keys. Keys are never 0. */
+void generate_zipf( uint32_t * const data, size_t const count, double const skew ) {
+   std::vector< double > weights( DISTINCT_HASHSET_CONCURRENT_EXPERIMENT );
+   for( size_t rank = 0; rank < DISTINCT_HASHSET_CONCURRENT_EXPERIMENT; ++rank ) {
+      weights[ rank ] = 1.0 / std::pow( ( double ) ( rank + 1 ), skew );
+   }
+   std::mt19937 generator( 65536 );
+   std::discrete_distribution< uint32_t > dist( weights.begin( ), weights.end( ) );
+   for( size_t position = 0; position < count; ++position ) {
+      data[ position ] = ( dist( generator ) + 1 ) * 0x9e3779b1u;
+      if( data[ position ] == 0 )
+         data[ position ] = 1;
+   }
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT, bool Delta >
+void test_concurrent_build( uint32_t const * const data, double const skew ) {
+#pragma _NEC novector
+   for( size_t thread_count = 1; thread_count <= MAX_THREAD_COUNT; ++thread_count ) {
+#pragma _NEC novector
+      for( size_t i = 0; i < NUM_HASHSET_CONCURRENT_EXPERIMENT_REP+1; ++i ) {
+         std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT << " Concurrent "
+                   << ( Delta ? "Delta" : "Atomic" ) << " ( Skew " << skew << ", " << thread_count << " Threads ): Loadfactor: "
+                   << loadFactor << " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_CONCURRENT_EXPERIMENT_REP << " ]: "
+                   << std::flush;
+         const_sized_basic_histogramm< uint32_t > concurrent_histogramm{ DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT, loadFactor };
+         auto start = std::chrono::high_resolution_clock::now( );
+         run_on_even_chunks( data, DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT, thread_count,
+            [ &concurrent_histogramm ]( size_t, uint32_t const * chunk, size_t chunk_size ) {
+               if( Delta )
+                  concurrent_histogramm.build_concurrent_delta( chunk, chunk_size );
+               else
+                  concurrent_histogramm.build_concurrent_atomic( chunk, chunk_size );
+            } );
+         auto end = std::chrono::high_resolution_clock::now( );
+         if( i > 0 ) {
+            std::cout << "BUILD;" << ( Delta ? "CONCURRENT_DELTA" : "CONCURRENT_ATOMIC" ) << ";32;" << i << ";"
+                      << DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT << ";" << skew << ";" << thread_count << ";"
+                      << loadFactor << ";" << concurrent_histogramm.get_size() << ";"
+                      << concurrent_histogramm.key_count() << ";"
+                      << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+         }
+         std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+      }
+   }
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT >
+void test_scalar_elem_build( uint32_t const * const data, double const skew ) {
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_CONCURRENT_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT << " Elemwise Scalar ( Skew " << skew << " ): Loadfactor: "
+                << loadFactor << " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_CONCURRENT_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      const_sized_basic_histogramm< uint32_t > scalar_histogramm{ DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT, loadFactor };
+      auto start = std::chrono::high_resolution_clock::now( );
+      scalar_histogramm.build_scalar_elem( data );
+      auto end = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;SCALAR_ELEM;32;" << i << ";" << DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT << ";" << skew << ";1;"
+                   << loadFactor << ";" << scalar_histogramm.get_size() << ";"
+                   << scalar_histogramm.key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+   }
+}
+
+template< uint32_t DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT >
+void test( double const skew ) {
+   uint32_t * data = ( uint32_t * ) malloc( DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT * sizeof( uint32_t ) );
+   generate_zipf( data, DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT, skew );
+
+   test_scalar_elem_build< 50, DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT >( data, skew );
+   test_concurrent_build< 50, DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT, false >( data, skew );
+   test_concurrent_build< 50, DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT, true >( data, skew );
+   test_scalar_elem_build< 90, DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT >( data, skew );
+   test_concurrent_build< 90, DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT, false >( data, skew );
+   test_concurrent_build< 90, DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT, true >( data, skew );
+
+   free( ( void * ) data );
+}
+
+int main( int argc, char** argv ) {
+
+   if( argc == 1 )
+      NUM_HASHSET_CONCURRENT_EXPERIMENT_REP = 10;
+   else
+      NUM_HASHSET_CONCURRENT_EXPERIMENT_REP = std::atoi( argv[ 1 ] );
+
+   std::cout << "#Data:\n" <<
+             "#         Generator: " << "std::mt19937\n" <<
+             "#              Seed: " << "65536\n" <<
+             "#      Distribution: " << "zipf over " << DISTINCT_HASHSET_CONCURRENT_EXPERIMENT << " distinct keys\n" <<
+             "Phase;Variant;BitWidth;Rep;DataCount;Skew;Threads;LoadFactor;ContainerSize;DistinctKeysInContainer;TimeMs\n";
+
+   for( double skew : { 0.0, 0.5, 1.0, 1.5, 2.0 } ) {
+      test< DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT_L3 >( skew );
+      test< DATACOUNT_HASHSET_CONCURRENT_EXPERIMENT_BLOB_400MB >( skew );
+   }
+
+   return 0;
+}
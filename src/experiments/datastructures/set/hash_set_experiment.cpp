@@ -13,8 +13,21 @@
 #include <limits>
 #include <cstdint>
 #include <unordered_map>
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <utility>
 
 #include "../../../main/datastructures/set/hash_set.h"
+#include "../../../main/datastructures/set/partitioned_hash_set.h"
+#include "../../../main/datastructures/set/radix_partitioned_hash_set.h"
+#include "../../../main/datastructures/set/interleaved_hash_set.h"
+#include "../../../main/datastructures/set/cuckoo_hash_set.h"
+#include "../../../main/datastructures/set/robin_hood_hash_set.h"
+#include "../../../main/datastructures/set/filtered_hash_set.h"
+#include "../../../main/datastructures/set/mapped_hash_set.h"
+#include "../../../main/datastructures/set/parallel_merge.h"
+#include "../../../main/datastructures/set/histogramm_export.h"
 
 #define DATACOUNT_HASHSET_EXPERIMENT_L1 8000
 #define DATACOUNT_HASHSET_EXPERIMENT_L2 64000
@@ -25,91 +38,914 @@
 //#define NUM_HASHSET_EXPERIMENT_REP 5
 int NUM_HASHSET_EXPERIMENT_REP;
 
+template< class SlotMapping >
+std::string slot_mapping_suffix( void );
+template< >
+std::string slot_mapping_suffix< slot_mapping_modulo >( void ) {
+   return "";
+}
+template< >
+std::string slot_mapping_suffix< slot_mapping_power_of_two >( void ) {
+   return "_POW2";
+}
+template< >
+std::string slot_mapping_suffix< slot_mapping_fastrange >( void ) {
+   return "_FASTRANGE";
+}
 
+#ifdef HASH_SET_STATISTICS
+/* one STATS row per metric, the value is in the last column */
+template< class Histogramm >
+void print_statistics_row( std::string const & variant, std::string const & metric, size_t const rep, size_t const data_count,
+                           uint32_t const load_factor, Histogramm const & histogramm, double const value ) {
+   std::cout << "STATS;" << variant << "_" << metric << ";32;" << rep << ";" << data_count << ";"
+             << load_factor << ";" << histogramm.get_size() << ";"
+             << histogramm.get_occupied_count() << ";"
+             << value << "\n";
+}
+/* summary and distribution of the probe lengths recorded since the last reset, nothing if there are none */
+template< class Histogramm >
+void print_probe_lengths( std::string const & variant, std::string const & kind, uint64_t const * const lengths, size_t const rep,
+                          size_t const data_count, uint32_t const load_factor, Histogramm const & histogramm ) {
+   if( histogramm_statistics::total( lengths ) == 0 )
+      return;
+   print_statistics_row( variant, kind + "_PROBE_MEAN", rep, data_count, load_factor, histogramm, histogramm_statistics::mean( lengths ) );
+   print_statistics_row( variant, kind + "_PROBE_P99", rep, data_count, load_factor, histogramm,
+                         ( double ) histogramm_statistics::percentile( lengths, 990 ) );
+   print_statistics_row( variant, kind + "_PROBE_MAX", rep, data_count, load_factor, histogramm,
+                         ( double ) histogramm_statistics::percentile( lengths, 1000 ) );
+   for( size_t length = 0; length < histogramm_statistics::PROBE_LENGTH_BUCKETS; ++length ) {
+      if( lengths[ length ] != 0 )
+         print_statistics_row( variant, kind + "_PROBE_" + std::to_string( length ), rep, data_count, load_factor, histogramm,
+                               ( double ) lengths[ length ] );
+   }
+}
+/**
+ * Written after the timing row of the same run, so slowdowns at high load factors can be put down to clustering.
+ * The occupied slots are in the DistinctKeysInContainer column of every STATS row.
+ */
+template< class Histogramm >
+void print_statistics( std::string const & variant, size_t const rep, size_t const data_count, uint32_t const load_factor,
+                       Histogramm const & histogramm ) {
+   histogramm_statistics const & statistics = histogramm.get_statistics( );
+   print_statistics_row( variant, "LONGEST_CLUSTER", rep, data_count, load_factor, histogramm, ( double ) histogramm.longest_cluster( ) );
+   print_statistics_row( variant, "LANE_RETRIES", rep, data_count, load_factor, histogramm, ( double ) statistics.batch_lane_retries );
+   print_probe_lengths( variant, "INSERT", statistics.insert_probe_lengths, rep, data_count, load_factor, histogramm );
+   print_probe_lengths( variant, "LOOKUP", statistics.lookup_probe_lengths, rep, data_count, load_factor, histogramm );
+}
+#endif
 
-template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT >
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, class SlotMapping = slot_mapping_modulo >
 void test_vectorized_elem_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
 #pragma _NEC novector
    for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
       std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << "  Elemwise Vectorized: Loadfactor: "
                 << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
                 << std::flush;
-      const_sized_basic_histogramm< uint32_t > vectorized_histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+      const_sized_basic_histogramm< uint32_t, SlotMapping > vectorized_histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
       auto start = std::chrono::high_resolution_clock::now( );
       vectorized_histogramm.build_vectorized_elem( data );
       auto end = std::chrono::high_resolution_clock::now( );
 
       if( i > 0 ) {
-         std::cout << "BUILD;AUTOVEC_ELEM;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+         std::cout << "BUILD;AUTOVEC_ELEM" << slot_mapping_suffix< SlotMapping >( ) << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
                    << loadFactor << ";" << vectorized_histogramm.get_size() << ";"
                    << vectorized_histogramm.key_count() << ";"
                    << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+#ifdef HASH_SET_STATISTICS
+         print_statistics( "AUTOVEC_ELEM" + slot_mapping_suffix< SlotMapping >( ), i, DATACOUNT_HASHSET_EXPERIMENT, loadFactor, vectorized_histogramm );
+#endif
       }
       std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
    }
 }
-template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT >
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, class SlotMapping = slot_mapping_modulo >
 void test_vectorized_batch_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
 #pragma _NEC novector
    for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
       std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << " Batchwise Vectorized: Loadfactor: "
                 << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
                 << std::flush;
-      const_sized_basic_histogramm< uint32_t > vectorized_histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+      const_sized_basic_histogramm< uint32_t, SlotMapping > vectorized_histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
       auto start = std::chrono::high_resolution_clock::now( );
       vectorized_histogramm.build_vectorized_batch( data );
       auto end = std::chrono::high_resolution_clock::now( );
 
       if( i > 0 ) {
-         std::cout << "BUILD;AUTOVEC_BATCH;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+         std::cout << "BUILD;AUTOVEC_BATCH" << slot_mapping_suffix< SlotMapping >( ) << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
                    << loadFactor << ";" << vectorized_histogramm.get_size() << ";"
                    << vectorized_histogramm.key_count() << ";"
                    << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+#ifdef HASH_SET_STATISTICS
+         print_statistics( "AUTOVEC_BATCH" + slot_mapping_suffix< SlotMapping >( ), i, DATACOUNT_HASHSET_EXPERIMENT, loadFactor, vectorized_histogramm );
+#endif
       }
       std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
    }
 }
-template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT >
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, class SlotMapping = slot_mapping_modulo >
 void test_scalar_elem_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
 #pragma _NEC novector
    for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
       std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << "  Elemwise Scalar: Loadfactor: "
                 << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
                 << std::flush;
-      const_sized_basic_histogramm< uint32_t > scalar_histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+      const_sized_basic_histogramm< uint32_t, SlotMapping > scalar_histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
       auto start = std::chrono::high_resolution_clock::now( );
       scalar_histogramm.build_scalar_elem( data );
       auto end = std::chrono::high_resolution_clock::now( );
       if( i > 0 ) {
-         std::cout << "BUILD;SCALAR_ELEM;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+         std::cout << "BUILD;SCALAR_ELEM" << slot_mapping_suffix< SlotMapping >( ) << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
                    << loadFactor << ";" << scalar_histogramm.get_size() << ";"
                    << scalar_histogramm.key_count() << ";"
                    << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+#ifdef HASH_SET_STATISTICS
+         print_statistics( "SCALAR_ELEM" + slot_mapping_suffix< SlotMapping >( ), i, DATACOUNT_HASHSET_EXPERIMENT, loadFactor, scalar_histogramm );
+#endif
       }
       std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
    }
 }
-template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT >
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, class SlotMapping = slot_mapping_modulo >
 void test_scalar_batch_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
 #pragma _NEC novector
    for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
       std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << " Batchwise Scalar: Loadfactor: "
                 << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
                 << std::flush;
-      const_sized_basic_histogramm< uint32_t > scalar_histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+      const_sized_basic_histogramm< uint32_t, SlotMapping > scalar_histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
       auto start = std::chrono::high_resolution_clock::now( );
       scalar_histogramm.build_scalar_batch( data );
       auto end = std::chrono::high_resolution_clock::now( );
       if( i > 0 ) {
-         std::cout << "BUILD;SCALAR_BATCH;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+         std::cout << "BUILD;SCALAR_BATCH" << slot_mapping_suffix< SlotMapping >( ) << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
                    << loadFactor << ";" << scalar_histogramm.get_size() << ";"
                    << scalar_histogramm.key_count() << ";"
                    << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+#ifdef HASH_SET_STATISTICS
+         print_statistics( "SCALAR_BATCH" + slot_mapping_suffix< SlotMapping >( ), i, DATACOUNT_HASHSET_EXPERIMENT, loadFactor, scalar_histogramm );
+#endif
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+   }
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT >
+void test_growable_elem_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << "  Elemwise Growable: Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      growable_basic_histogramm< uint32_t > growable_histogramm{ loadFactor };
+      auto start = std::chrono::high_resolution_clock::now( );
+      growable_histogramm.build_scalar_elem( data, DATACOUNT_HASHSET_EXPERIMENT );
+      auto end = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;GROW_SCALAR_ELEM;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << growable_histogramm.get_size() << ";"
+                   << growable_histogramm.key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+   }
+}
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT >
+void test_growable_batch_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << " Batchwise Growable: Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      growable_basic_histogramm< uint32_t > growable_histogramm{ loadFactor };
+      auto start = std::chrono::high_resolution_clock::now( );
+      growable_histogramm.build_vectorized_batch( data, DATACOUNT_HASHSET_EXPERIMENT );
+      auto end = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;GROW_AUTOVEC_BATCH;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << growable_histogramm.get_size() << ";"
+                   << growable_histogramm.key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+   }
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, bool Batch >
+void test_partitioned_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+#pragma _NEC novector
+   for( size_t thread_count = 1; thread_count <= MAX_THREAD_COUNT; ++thread_count ) {
+#pragma _NEC novector
+      for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+         std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << " Partitioned " << ( Batch ? "Batchwise" : "Elemwise" )
+                   << " ( " << thread_count << " Threads ): Loadfactor: "
+                   << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                   << std::flush;
+         partitioned_basic_histogramm< uint32_t > partitioned_histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+         auto start = std::chrono::high_resolution_clock::now( );
+         if( Batch )
+            partitioned_histogramm.build_vectorized_batch( data, thread_count );
+         else
+            partitioned_histogramm.build_scalar_elem( data, thread_count );
+         auto end = std::chrono::high_resolution_clock::now( );
+         if( i > 0 ) {
+            std::cout << "BUILD;PARTITIONED_" << ( Batch ? "AUTOVEC_BATCH_" : "SCALAR_ELEM_" ) << thread_count << "T;32;"
+                      << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                      << loadFactor << ";" << partitioned_histogramm.get_size() << ";"
+                      << partitioned_histogramm.key_count() << ";"
+                      << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+         }
+         std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+      }
+   }
+}
+
+/* FanoutBits == 0 splits the partition bits which make an average sub table fit into 1 MiB evenly over the passes */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, uint32_t FanoutBits, uint32_t Passes >
+void test_radix_build( uint32_t const * const data ) {
+   uint32_t const cache_bits = radix_partitioned_histogramm< uint32_t >::partition_bits_for_cache(
+      DATACOUNT_HASHSET_EXPERIMENT, loadFactor, 1 << 20 );
+   uint32_t const fanout_bits = ( FanoutBits != 0 ) ? FanoutBits : std::max( 1U, ( cache_bits + Passes - 1 ) / Passes );
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << " Radix Partitioned ( " << Passes << " x " << fanout_bits
+                << " Bits ): Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      radix_partitioned_histogramm< uint32_t > radix_histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor, fanout_bits, Passes };
+      auto start = std::chrono::high_resolution_clock::now( );
+      radix_histogramm.build_vectorized_batch( data );
+      auto end = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;RADIX_" << Passes << "P_" << fanout_bits << "B;32;"
+                   << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << radix_histogramm.get_size() << ";"
+                   << radix_histogramm.key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+   }
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, bool Grouped >
+void test_probe( uint32_t const * const data ) {
+   uint32_t * probe_result = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * probe_result_count = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   const_sized_basic_histogramm< uint32_t > histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+   histogramm.build_vectorized_batch( data );
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << ( Grouped ? "  Probe Grouped" : "  Probe Scalar" ) << ": Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      size_t result_size;
+      HISTOGRAMM_STATISTICS_( histogramm.reset_statistics( ); )
+      auto start = std::chrono::high_resolution_clock::now( );
+      if( Grouped )
+         result_size = histogramm.probe_grouped( data, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count );
+      else
+         result_size = histogramm.probe( data, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count );
+      auto end = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "PROBE;" << ( Grouped ? "GROUP_PREFETCH" : "SCALAR" ) << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << result_size << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+#ifdef HASH_SET_STATISTICS
+         print_statistics( Grouped ? "GROUP_PREFETCH" : "SCALAR", i, DATACOUNT_HASHSET_EXPERIMENT, loadFactor, histogramm );
+#endif
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+   }
+   free( ( void * ) probe_result_count );
+   free( ( void * ) probe_result );
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, bool Avx512, class SlotMapping = slot_mapping_modulo >
+void test_simd_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << " " << ( Avx512 ? "AVX-512" : "AVX2" ) << ": Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      const_sized_basic_histogramm< uint32_t, SlotMapping > simd_histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+      auto start = std::chrono::high_resolution_clock::now( );
+#if defined( __AVX512F__ ) && defined( __AVX512CD__ )
+      if( Avx512 )
+         simd_histogramm.build_avx512( data );
+#endif
+#ifdef __AVX2__
+      if( !Avx512 )
+         simd_histogramm.build_avx2( data );
+#endif
+      auto end = std::chrono::high_resolution_clock::now( );
+
+      if( i > 0 ) {
+         std::cout << "BUILD;" << ( Avx512 ? "AVX512_BATCH" : "AVX2_BATCH" ) << slot_mapping_suffix< SlotMapping >( ) << ";32;" << i << ";"
+                   << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << simd_histogramm.get_size() << ";"
+                   << simd_histogramm.key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+#ifdef HASH_SET_STATISTICS
+         print_statistics( std::string{ Avx512 ? "AVX512_BATCH" : "AVX2_BATCH" } + slot_mapping_suffix< SlotMapping >( ), i,
+                           DATACOUNT_HASHSET_EXPERIMENT, loadFactor, simd_histogramm );
+#endif
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+   }
+}
+/* builds and probes the interleaved layout, the probe keys are the build keys */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, typename CountT >
+void test_interleaved( uint32_t const * const data ) {
+   uint32_t * probe_result = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * probe_result_count = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << " Interleaved " << 8 * sizeof( CountT ) << " bit counters: Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      interleaved_basic_histogramm< uint32_t, CountT > histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+      auto start = std::chrono::high_resolution_clock::now( );
+      histogramm.build_vectorized_batch( data );
+      auto end_build = std::chrono::high_resolution_clock::now( );
+      size_t result_size = histogramm.probe( data, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count );
+      auto end_probe = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;INTERLEAVED_C" << 8 * sizeof( CountT ) << "_AUTOVEC_BATCH;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << histogramm.key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end_build - start ).count( ) << "\n";
+         std::cout << "PROBE;INTERLEAVED_C" << 8 * sizeof( CountT ) << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << result_size << ";"
+                   << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end_build - start ).count( ) << " ms / "
+                << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << " ms, "
+                << histogramm.get_memory_footprint( ) << " bytes )\n";
+   }
+   free( ( void * ) probe_result_count );
+   free( ( void * ) probe_result );
+}
+
+/* builds and probes the bucketized cuckoo table, the probe keys are the build keys */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, size_t Ways, bool Vectorized >
+void test_cuckoo( uint32_t const * const data ) {
+   uint32_t * probe_result = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * probe_result_count = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << " Cuckoo " << Ways << "-way " << ( Vectorized ? "Vectorized" : "Scalar" )
+                << ": Loadfactor: " << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      cuckoo_basic_histogramm< uint32_t, Ways > histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+      auto start = std::chrono::high_resolution_clock::now( );
+      if( Vectorized )
+         histogramm.build_vectorized_batch( data );
+      else
+         histogramm.build_scalar_batch( data );
+      auto end_build = std::chrono::high_resolution_clock::now( );
+      size_t result_size = histogramm.probe( data, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count );
+      auto end_probe = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;CUCKOO" << Ways << ( Vectorized ? "_SIMD_BATCH" : "_SCALAR_BATCH" ) << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << histogramm.key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end_build - start ).count( ) << "\n";
+         std::cout << "PROBE;CUCKOO" << Ways << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << result_size << ";"
+                   << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end_build - start ).count( ) << " ms / "
+                << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << " ms, stash "
+                << histogramm.get_stash_size( ) << " )\n";
+   }
+   free( ( void * ) probe_result_count );
+   free( ( void * ) probe_result );
+}
+
+/* HitPercent % of the probe keys are build keys, the others are shifted build keys and mostly absent */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, bool RobinHood, uint32_t HitPercent >
+void test_hit_ratio( uint32_t const * const data ) {
+   uint32_t * probe_keys = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * probe_result = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * probe_result_count = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_EXPERIMENT; ++i ) {
+      if( i % 100 < HitPercent )
+         probe_keys[ i ] = data[ i ];
+      else
+         probe_keys[ i ] = ( data[ i ] == std::numeric_limits< uint32_t >::max( ) ) ? 1 : data[ i ] + 1;
+   }
+   const_sized_basic_histogramm< uint32_t > linear_histogramm{ RobinHood ? 1 : DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+   robin_hood_basic_histogramm< uint32_t > rh_histogramm{ RobinHood ? DATACOUNT_HASHSET_EXPERIMENT : 1, loadFactor };
+   if( RobinHood )
+      rh_histogramm.build_vectorized_batch( data );
+   else
+      linear_histogramm.build_vectorized_batch( data );
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << ( RobinHood ? "  Probe Robin Hood" : "  Probe Linear" )
+                << " ( " << HitPercent << " % hits ): Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      size_t result_size;
+      auto start = std::chrono::high_resolution_clock::now( );
+      if( RobinHood )
+         result_size = rh_histogramm.probe( probe_keys, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count );
+      else
+         result_size = linear_histogramm.probe( probe_keys, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count );
+      auto end = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "PROBE;" << ( RobinHood ? "ROBIN_HOOD_H" : "LINEAR_H" ) << HitPercent << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << ( RobinHood ? rh_histogramm.get_size( ) : ( size_t ) linear_histogramm.get_size( ) ) << ";"
+                   << result_size << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+   }
+   free( ( void * ) probe_result_count );
+   free( ( void * ) probe_result );
+   free( ( void * ) probe_keys );
+}
+
+/* insert and lookup cost of robin hood hashing against plain linear probing */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT >
+void test_robin_hood( uint32_t const * const data ) {
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << " Robin Hood Batchwise: Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      robin_hood_basic_histogramm< uint32_t > histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+      auto start = std::chrono::high_resolution_clock::now( );
+      histogramm.build_vectorized_batch( data );
+      auto end = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;ROBIN_HOOD_BATCH;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << histogramm.key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms, max displacement "
+                << histogramm.get_max_displacement( ) << " )\n";
+   }
+   test_hit_ratio< loadFactor, DATACOUNT_HASHSET_EXPERIMENT, false, 0 >( data );
+   test_hit_ratio< loadFactor, DATACOUNT_HASHSET_EXPERIMENT, true, 0 >( data );
+   test_hit_ratio< loadFactor, DATACOUNT_HASHSET_EXPERIMENT, false, 10 >( data );
+   test_hit_ratio< loadFactor, DATACOUNT_HASHSET_EXPERIMENT, true, 10 >( data );
+   test_hit_ratio< loadFactor, DATACOUNT_HASHSET_EXPERIMENT, false, 50 >( data );
+   test_hit_ratio< loadFactor, DATACOUNT_HASHSET_EXPERIMENT, true, 50 >( data );
+   test_hit_ratio< loadFactor, DATACOUNT_HASHSET_EXPERIMENT, false, 100 >( data );
+   test_hit_ratio< loadFactor, DATACOUNT_HASHSET_EXPERIMENT, true, 100 >( data );
+}
+
+/* Probe with HitPercent % build keys through the Bloom filter and without it. The FILTER row counts the candidates
+ * which pass the filter, false positives are candidates minus hits. */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, uint32_t HitPercent, size_t BitsPerKey >
+void test_bloom_filter( uint32_t const * const data ) {
+   uint32_t * probe_keys = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * candidates = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * probe_result = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * probe_result_count = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_EXPERIMENT; ++i ) {
+      if( i % 100 < HitPercent )
+         probe_keys[ i ] = data[ i ];
+      else
+         probe_keys[ i ] = ( data[ i ] == std::numeric_limits< uint32_t >::max( ) ) ? 1 : data[ i ] + 1;
+   }
+   bloom_filtered_histogramm< uint32_t > histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor, BitsPerKey };
+   histogramm.build_vectorized_batch( data );
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << "  Probe Bloom " << BitsPerKey << " bits/key ( " << HitPercent
+                << " % hits ): Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      auto start = std::chrono::high_resolution_clock::now( );
+      size_t const candidate_count = histogramm.get_filter( ).filter( probe_keys, DATACOUNT_HASHSET_EXPERIMENT, candidates );
+      auto end_filter = std::chrono::high_resolution_clock::now( );
+      size_t const filtered_size = histogramm.probe( probe_keys, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count );
+      auto end_filtered = std::chrono::high_resolution_clock::now( );
+      size_t const plain_size = histogramm.get_histogramm( ).probe_grouped( probe_keys, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count );
+      auto end_plain = std::chrono::high_resolution_clock::now( );
+      size_t const absent_count = DATACOUNT_HASHSET_EXPERIMENT - plain_size;
+      double const false_positive_rate =
+         ( absent_count > 0 ) ? ( double ) ( candidate_count - plain_size ) / ( double ) absent_count : 0.0;
+      if( i > 0 ) {
+         std::cout << "FILTER;BLOOM" << BitsPerKey << "_H" << HitPercent << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_filter( ).get_memory_footprint( ) << ";"
+                   << candidate_count << ";"
+                   << std::chrono::duration< double, std::milli >( end_filter - start ).count( ) << "\n";
+         std::cout << "PROBE;BLOOM" << BitsPerKey << "_H" << HitPercent << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size( ) << ";"
+                   << filtered_size << ";"
+                   << std::chrono::duration< double, std::milli >( end_filtered - end_filter ).count( ) << "\n";
+         std::cout << "PROBE;GROUP_PREFETCH_H" << HitPercent << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size( ) << ";"
+                   << plain_size << ";"
+                   << std::chrono::duration< double, std::milli >( end_plain - end_filtered ).count( ) << "\n";
+      }
+      std::cerr << "Done ( filter " << std::chrono::duration< double, std::milli >( end_filter - start ).count( ) << " ms, filtered "
+                << std::chrono::duration< double, std::milli >( end_filtered - end_filter ).count( ) << " ms, plain "
+                << std::chrono::duration< double, std::milli >( end_plain - end_filtered ).count( ) << " ms, FPR "
+                << false_positive_rate << " )\n";
+   }
+   free( ( void * ) probe_result_count );
+   free( ( void * ) probe_result );
+   free( ( void * ) candidates );
+   free( ( void * ) probe_keys );
+}
+
+/* Thread local pre-aggregation: PartCount histogramms over chunks of the data are combined with the parallel tree
+ * merge. SameSize parts have the size of the merged result and use the slot by slot merge, otherwise the chunk sized
+ * parts are folded into one result table by inserting their keys. Only the merge is timed. */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, size_t PartCount, size_t ThreadCount, bool SameSize >
+void test_merge( uint32_t const * const data ) {
+   typedef const_sized_basic_histogramm< uint32_t > histogramm_t;
+   size_t const chunk = DATACOUNT_HASHSET_EXPERIMENT / PartCount;
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << "  Merge " << PartCount << " parts, " << ThreadCount << " threads"
+                << ( SameSize ? " ( same size )" : " ( chunk size )" ) << ": Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      histogramm_t * parts[ PartCount ];
+      for( size_t p = 0; p < PartCount; ++p ) {
+         parts[ p ] = new histogramm_t( SameSize ? DATACOUNT_HASHSET_EXPERIMENT : ( uint32_t ) chunk, loadFactor );
+         parts[ p ]->begin_build( );
+         parts[ p ]->consume( data + p * chunk, chunk );
+         parts[ p ]->finish_build( );
+      }
+      histogramm_t * target = SameSize ? nullptr : new histogramm_t( DATACOUNT_HASHSET_EXPERIMENT, loadFactor );
+      auto start = std::chrono::high_resolution_clock::now( );
+      histogramm_t * merged = target;
+      if( SameSize ) {
+         merged = tree_merge_histogramms( parts, PartCount, ThreadCount );
+      } else {
+         for( size_t p = 0; p < PartCount; ++p )
+            target->merge( *parts[ p ] );
+      }
+      auto end = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "MERGE;" << ( SameSize ? "TREE_SAME_SIZE_" : "FOLD_CHUNK_SIZE_" ) << PartCount << "P_" << ThreadCount << "T;32;"
+                   << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << merged->get_size() << ";"
+                   << merged->key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+      delete target;
+      for( size_t p = 0; p < PartCount; ++p )
+         delete parts[ p ];
+   }
+}
+
+/* Key sorted export: SCAN_STD_SORT is the scan of the containers with a branch per slot followed by std::sort on the
+ * pairs, COMPACT and SORTED are export_histogramm in slot order and radix sorted with ThreadCount threads. */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, size_t ThreadCount >
+void test_export( uint32_t const * const data ) {
+   const_sized_basic_histogramm< uint32_t > histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+   histogramm.build_vectorized_batch( data );
+   size_t const distinct = histogramm.key_count( );
+   uint32_t * keys = ( uint32_t * ) malloc( distinct * sizeof( uint32_t ) );
+   uint64_t * counts = ( uint64_t * ) malloc( distinct * sizeof( uint64_t ) );
+   std::vector< std::pair< uint32_t, uint64_t > > pairs;
+   pairs.reserve( distinct );
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << "  Export " << ThreadCount << " threads: Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      auto start = std::chrono::high_resolution_clock::now( );
+      pairs.clear( );
+      for( size_t slot = 0; slot < histogramm.get_size( ); ++slot ) {
+         if( histogramm.get_key_count_container( )[ slot ] != 0 )
+            pairs.emplace_back( histogramm.get_key_container( )[ slot ], histogramm.get_key_count_container( )[ slot ] );
+      }
+      std::sort( pairs.begin( ), pairs.end( ) );
+      auto end_baseline = std::chrono::high_resolution_clock::now( );
+      size_t const compacted = export_histogramm( histogramm, keys, counts, false, ThreadCount );
+      auto end_compact = std::chrono::high_resolution_clock::now( );
+      size_t const sorted = export_histogramm( histogramm, keys, counts, true, ThreadCount );
+      auto end_sorted = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         if( ThreadCount == 1 ) {
+            std::cout << "EXPORT;SCAN_STD_SORT;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                      << loadFactor << ";" << histogramm.get_size( ) << ";"
+                      << pairs.size( ) << ";"
+                      << std::chrono::duration< double, std::milli >( end_baseline - start ).count( ) << "\n";
+         }
+         std::cout << "EXPORT;COMPACT_" << ThreadCount << "T;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size( ) << ";"
+                   << compacted << ";"
+                   << std::chrono::duration< double, std::milli >( end_compact - end_baseline ).count( ) << "\n";
+         std::cout << "EXPORT;SORTED_" << ThreadCount << "T;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size( ) << ";"
+                   << sorted << ";"
+                   << std::chrono::duration< double, std::milli >( end_sorted - end_compact ).count( ) << "\n";
+      }
+      std::cerr << "Done ( scan + std::sort " << std::chrono::duration< double, std::milli >( end_baseline - start ).count( )
+                << " ms, compact " << std::chrono::duration< double, std::milli >( end_compact - end_baseline ).count( )
+                << " ms, sorted " << std::chrono::duration< double, std::milli >( end_sorted - end_compact ).count( ) << " ms )\n";
+   }
+   free( ( void * ) counts );
+   free( ( void * ) keys );
+}
+
+/* Sliding window of a quarter of the data, moved in steps of an eighth of the window: every step streams the new keys
+ * in and decrements the keys which leave the window. One row per step, DataCount is the number of keys streamed so
+ * far, so the time over DataCount shows whether tombstones and compactions keep the throughput flat. */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, size_t CompactionThreshold >
+void test_sliding_window( uint32_t const * const data ) {
+   size_t const window_size = DATACOUNT_HASHSET_EXPERIMENT / 4;
+   size_t const step = window_size / 8;
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << "  Sliding Window ( compaction at " << CompactionThreshold
+                << " % ): Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      const_sized_basic_histogramm< uint32_t > histogramm{ ( uint32_t ) ( window_size + step ), loadFactor };
+      histogramm.set_compaction_threshold( CompactionThreshold );
+      double total = 0;
+      for( size_t position = 0; position + step <= DATACOUNT_HASHSET_EXPERIMENT; position += step ) {
+         auto start = std::chrono::high_resolution_clock::now( );
+         histogramm.begin_build( );
+         histogramm.consume( data + position, step );
+         histogramm.finish_build( );
+         if( position >= window_size )
+            histogramm.decrement_batch( data + position - window_size, step );
+         auto end = std::chrono::high_resolution_clock::now( );
+         total += std::chrono::duration< double, std::milli >( end - start ).count( );
+         if( i > 0 ) {
+            std::cout << "WINDOW;SLIDING_T" << CompactionThreshold << ";32;" << i << ";" << position + step << ";"
+                      << loadFactor << ";" << histogramm.get_size() << ";"
+                      << histogramm.key_count() << ";"
+                      << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+         }
+      }
+      std::cerr << "Done ( " << total << " ms )\n";
+   }
+}
+
+/* streaming build from chunks of ChunkSize keys, compared with AUTOVEC_BATCH which gets all keys at once */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, size_t ChunkSize >
+void test_stream_build( uint32_t const * const data ) {
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << "  Stream Build ( chunks of " << ChunkSize << " ): Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      const_sized_basic_histogramm< uint32_t > histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+      auto start = std::chrono::high_resolution_clock::now( );
+      histogramm.begin_build( );
+      for( size_t position = 0; position < DATACOUNT_HASHSET_EXPERIMENT; position += ChunkSize )
+         histogramm.consume( data + position, std::min( ChunkSize, DATACOUNT_HASHSET_EXPERIMENT - position ) );
+      histogramm.finish_build( );
+      auto end = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;STREAM_" << ChunkSize << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << histogramm.key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
       }
       std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
    }
 }
 
+/* Startup from a saved histogramm: SAVE writes the file, LOAD maps it, PROBE_MAPPED probes all keys straight after
+ * loading (page faults included) and is compared with the BUILD it replaces. */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT >
+void test_mapped( uint32_t const * const data ) {
+   char const * const path = "hash_set_experiment.histo";
+   uint32_t * probe_result = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * probe_result_count = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << "  Mapped: Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      auto start = std::chrono::high_resolution_clock::now( );
+      size_t container_size;
+      {
+         const_sized_basic_histogramm< uint32_t > histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+         histogramm.build_vectorized_batch( data );
+         start = std::chrono::high_resolution_clock::now( );
+         save_histogramm( histogramm, path );
+         container_size = histogramm.get_size( );
+      }
+      auto end_save = std::chrono::high_resolution_clock::now( );
+      mapped_histogramm< uint32_t > mapped{ path };
+      auto end_load = std::chrono::high_resolution_clock::now( );
+      size_t const result_size = mapped.is_valid( ) ?
+         mapped.get_histogramm( ).probe_grouped( data, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count ) : 0;
+      auto end_probe = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "SAVE;MAPPED;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << container_size << ";"
+                   << mapped.get_file_size( ) << ";"
+                   << std::chrono::duration< double, std::milli >( end_save - start ).count( ) << "\n";
+         std::cout << "LOAD;MAPPED;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << container_size << ";"
+                   << ( mapped.is_valid( ) ? 1 : 0 ) << ";"
+                   << std::chrono::duration< double, std::milli >( end_load - end_save ).count( ) << "\n";
+         std::cout << "PROBE;MAPPED_GROUP_PREFETCH;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << container_size << ";"
+                   << result_size << ";"
+                   << std::chrono::duration< double, std::milli >( end_probe - end_load ).count( ) << "\n";
+      }
+      std::cerr << "Done ( save " << std::chrono::duration< double, std::milli >( end_save - start ).count( ) << " ms, load "
+                << std::chrono::duration< double, std::milli >( end_load - end_save ).count( ) << " ms, probe "
+                << std::chrono::duration< double, std::milli >( end_probe - end_load ).count( ) << " ms )\n";
+   }
+   ::unlink( path );
+   free( ( void * ) probe_result_count );
+   free( ( void * ) probe_result );
+}
+
+/* Allocation only changes where the containers live: ALLOC is the constructor ( allocation and zeroing ), followed by a
+ * build and the scalar and grouped probe of all build keys */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, class Allocation >
+void test_allocation( uint32_t const * const data, char const * const name ) {
+   uint32_t * probe_result = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+   uint32_t * probe_result_count = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << "  Allocation " << name << ": Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      auto start = std::chrono::high_resolution_clock::now( );
+      const_sized_basic_histogramm< uint32_t, slot_mapping_modulo, murmur3< uint32_t >, Allocation > histogramm{
+         DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+      auto end_alloc = std::chrono::high_resolution_clock::now( );
+      histogramm.build_vectorized_batch( data );
+      auto end_build = std::chrono::high_resolution_clock::now( );
+      size_t const result_size = histogramm.probe( data, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count );
+      auto end_probe = std::chrono::high_resolution_clock::now( );
+      histogramm.probe_grouped( data, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count );
+      auto end_grouped = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "ALLOC;" << name << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";0;"
+                   << std::chrono::duration< double, std::milli >( end_alloc - start ).count( ) << "\n";
+         std::cout << "BUILD;" << name << ";32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << histogramm.key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end_build - end_alloc ).count( ) << "\n";
+         std::cout << "PROBE;" << name << "_SCALAR;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << result_size << ";"
+                   << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << "\n";
+         std::cout << "PROBE;" << name << "_GROUP_PREFETCH;32;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << result_size << ";"
+                   << std::chrono::duration< double, std::milli >( end_grouped - end_probe ).count( ) << "\n";
+      }
+      std::cerr << "Done ( alloc " << std::chrono::duration< double, std::milli >( end_alloc - start ).count( ) << " ms, build "
+                << std::chrono::duration< double, std::milli >( end_build - end_alloc ).count( ) << " ms, probe "
+                << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << " ms, grouped "
+                << std::chrono::duration< double, std::milli >( end_grouped - end_probe ).count( ) << " ms )\n";
+   }
+   free( ( void * ) probe_result_count );
+   free( ( void * ) probe_result );
+}
+
+/* 64-bit surrogate keys: the 32-bit data shifted into both halves of the key. Build: 0 scalar elem, 1 vectorized
+ * elem, 2 scalar batch, 3 vectorized batch. The probe looks up all build keys. */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_EXPERIMENT, int Build >
+void test_uint64( uint32_t const * const data ) {
+   static char const * const variants[ 4 ] = { "SCALAR_ELEM", "AUTOVEC_ELEM", "SCALAR_BATCH", "AUTOVEC_BATCH" };
+   uint64_t * keys = ( uint64_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint64_t ) );
+   uint64_t * probe_result = ( uint64_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint64_t ) );
+   uint64_t * probe_result_count = ( uint64_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint64_t ) );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_EXPERIMENT; ++i )
+      keys[ i ] = ( uint64_t ) data[ i ] << 20;
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << DATACOUNT_HASHSET_EXPERIMENT << "  64 bit " << variants[ Build ] << ": Loadfactor: "
+                << loadFactor<< " %  [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: "
+                << std::flush;
+      const_sized_basic_histogramm< uint64_t > histogramm{ DATACOUNT_HASHSET_EXPERIMENT, loadFactor };
+      auto start = std::chrono::high_resolution_clock::now( );
+      if( Build == 0 )
+         histogramm.build_scalar_elem( keys );
+      else if( Build == 1 )
+         histogramm.build_vectorized_elem( keys );
+      else if( Build == 2 )
+         histogramm.build_scalar_batch( keys );
+      else
+         histogramm.build_vectorized_batch( keys );
+      auto end_build = std::chrono::high_resolution_clock::now( );
+      size_t const result_size = histogramm.probe_grouped( keys, DATACOUNT_HASHSET_EXPERIMENT, probe_result, probe_result_count );
+      auto end_probe = std::chrono::high_resolution_clock::now( );
+      if( i > 0 ) {
+         std::cout << "BUILD;" << variants[ Build ] << ";64;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << histogramm.key_count() << ";"
+                   << std::chrono::duration< double, std::milli >( end_build - start ).count( ) << "\n";
+         std::cout << "PROBE;GROUP_PREFETCH_" << variants[ Build ] << ";64;" << i << ";" << DATACOUNT_HASHSET_EXPERIMENT << ";"
+                   << loadFactor << ";" << histogramm.get_size() << ";"
+                   << result_size << ";"
+                   << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end_build - start ).count( ) << " ms / "
+                << std::chrono::duration< double, std::milli >( end_probe - end_build ).count( ) << " ms )\n";
+   }
+   free( ( void * ) probe_result_count );
+   free( ( void * ) probe_result );
+   free( ( void * ) keys );
+}
+
+template< class SlotMapping, uint32_t DATACOUNT_HASHSET_EXPERIMENT >
+void test_slot_mapping( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   test_scalar_elem_build< 10, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 20, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 30, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 40, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 50, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 60, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 70, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 80, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 90, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 91, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 92, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 93, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 94, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 95, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 96, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 97, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 98, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_elem_build< 99, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 10, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 20, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 30, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 40, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 50, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 60, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 70, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 80, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 90, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 91, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 92, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 93, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 94, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 95, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 96, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 97, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 98, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_scalar_batch_build< 99, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 10, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 20, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 30, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 40, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 50, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 60, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 70, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 80, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 90, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 91, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 92, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 93, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 94, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 95, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 96, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 97, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 98, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_elem_build< 99, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 10, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 20, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 30, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 40, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 50, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 60, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 70, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 80, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 90, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 91, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 92, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 93, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 94, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 95, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 96, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 97, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 98, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+   test_vectorized_batch_build< 99, DATACOUNT_HASHSET_EXPERIMENT, SlotMapping >( data, result, result_count );
+#ifdef __AVX2__
+   test_simd_build< 50, DATACOUNT_HASHSET_EXPERIMENT, false, SlotMapping >( data, result, result_count );
+   test_simd_build< 90, DATACOUNT_HASHSET_EXPERIMENT, false, SlotMapping >( data, result, result_count );
+   test_simd_build< 95, DATACOUNT_HASHSET_EXPERIMENT, false, SlotMapping >( data, result, result_count );
+   test_simd_build< 99, DATACOUNT_HASHSET_EXPERIMENT, false, SlotMapping >( data, result, result_count );
+#endif
+#if defined( __AVX512F__ ) && defined( __AVX512CD__ )
+   test_simd_build< 50, DATACOUNT_HASHSET_EXPERIMENT, true, SlotMapping >( data, result, result_count );
+   test_simd_build< 90, DATACOUNT_HASHSET_EXPERIMENT, true, SlotMapping >( data, result, result_count );
+   test_simd_build< 95, DATACOUNT_HASHSET_EXPERIMENT, true, SlotMapping >( data, result, result_count );
+   test_simd_build< 99, DATACOUNT_HASHSET_EXPERIMENT, true, SlotMapping >( data, result, result_count );
+#endif
+}
+
 template< uint32_t DATACOUNT_HASHSET_EXPERIMENT >
 void test( )  {
    uint32_t * data = ( uint32_t * ) malloc( DATACOUNT_HASHSET_EXPERIMENT * sizeof( uint32_t ) );
@@ -122,79 +958,156 @@ void test( )  {
    for( size_t position = 0; position < DATACOUNT_HASHSET_EXPERIMENT; ++position ) {
       data[ position ] = dist( generator );
    }
-   test_scalar_elem_build< 10, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 20, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 30, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 40, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 50, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 60, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 70, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 80, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 90, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 91, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 92, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 93, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 94, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 95, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 96, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 97, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 98, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_elem_build< 99, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 10, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 20, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 30, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 40, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 50, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 60, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 70, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 80, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 90, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 91, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 92, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 93, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 94, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 95, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 96, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 97, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 98, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_scalar_batch_build< 99, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 10, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 20, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 30, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 40, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 50, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 60, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 70, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 80, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 90, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 91, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 92, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 93, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 94, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 95, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 96, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 97, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 98, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_elem_build< 99, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 10, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 20, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 30, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 40, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 50, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 60, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 70, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 80, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 90, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 91, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 92, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 93, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 94, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 95, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 96, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 97, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 98, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
-   test_vectorized_batch_build< 99, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_slot_mapping< slot_mapping_modulo, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_slot_mapping< slot_mapping_power_of_two, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_slot_mapping< slot_mapping_fastrange, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+
+   test_growable_elem_build< 10, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 20, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 30, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 40, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 50, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 60, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 70, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 80, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 90, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 91, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 92, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 93, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 94, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 95, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 96, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 97, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 98, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_elem_build< 99, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 10, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 20, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 30, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 40, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 50, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 60, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 70, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 80, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 90, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 91, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 92, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 93, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 94, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 95, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 96, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 97, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 98, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_growable_batch_build< 99, DATACOUNT_HASHSET_EXPERIMENT >( data, result, result_count );
+   test_partitioned_build< 50, DATACOUNT_HASHSET_EXPERIMENT, false >( data, result, result_count );
+   test_partitioned_build< 90, DATACOUNT_HASHSET_EXPERIMENT, false >( data, result, result_count );
+   test_partitioned_build< 99, DATACOUNT_HASHSET_EXPERIMENT, false >( data, result, result_count );
+   test_partitioned_build< 50, DATACOUNT_HASHSET_EXPERIMENT, true >( data, result, result_count );
+   test_partitioned_build< 90, DATACOUNT_HASHSET_EXPERIMENT, true >( data, result, result_count );
+   test_partitioned_build< 99, DATACOUNT_HASHSET_EXPERIMENT, true >( data, result, result_count );
+   test_radix_build< 50, DATACOUNT_HASHSET_EXPERIMENT, 0, 1 >( data );
+   test_radix_build< 50, DATACOUNT_HASHSET_EXPERIMENT, 0, 2 >( data );
+   test_radix_build< 90, DATACOUNT_HASHSET_EXPERIMENT, 0, 1 >( data );
+   test_radix_build< 90, DATACOUNT_HASHSET_EXPERIMENT, 0, 2 >( data );
+   test_radix_build< 90, DATACOUNT_HASHSET_EXPERIMENT, 4, 1 >( data );
+   test_radix_build< 90, DATACOUNT_HASHSET_EXPERIMENT, 4, 2 >( data );
+   test_radix_build< 90, DATACOUNT_HASHSET_EXPERIMENT, 8, 1 >( data );
+   test_radix_build< 90, DATACOUNT_HASHSET_EXPERIMENT, 5, 2 >( data );
+   test_probe< 50, DATACOUNT_HASHSET_EXPERIMENT, false >( data );
+   test_probe< 50, DATACOUNT_HASHSET_EXPERIMENT, true >( data );
+   test_probe< 90, DATACOUNT_HASHSET_EXPERIMENT, false >( data );
+   test_probe< 90, DATACOUNT_HASHSET_EXPERIMENT, true >( data );
+   test_probe< 99, DATACOUNT_HASHSET_EXPERIMENT, false >( data );
+   test_probe< 99, DATACOUNT_HASHSET_EXPERIMENT, true >( data );
+
+   test_interleaved< 50, DATACOUNT_HASHSET_EXPERIMENT, uint8_t >( data );
+   test_interleaved< 50, DATACOUNT_HASHSET_EXPERIMENT, uint16_t >( data );
+   test_interleaved< 50, DATACOUNT_HASHSET_EXPERIMENT, uint32_t >( data );
+   test_interleaved< 90, DATACOUNT_HASHSET_EXPERIMENT, uint8_t >( data );
+   test_interleaved< 90, DATACOUNT_HASHSET_EXPERIMENT, uint16_t >( data );
+   test_interleaved< 90, DATACOUNT_HASHSET_EXPERIMENT, uint32_t >( data );
+   test_interleaved< 99, DATACOUNT_HASHSET_EXPERIMENT, uint8_t >( data );
+   test_interleaved< 99, DATACOUNT_HASHSET_EXPERIMENT, uint16_t >( data );
+   test_interleaved< 99, DATACOUNT_HASHSET_EXPERIMENT, uint32_t >( data );
+
+   test_cuckoo< 50, DATACOUNT_HASHSET_EXPERIMENT, 8, false >( data );
+   test_cuckoo< 50, DATACOUNT_HASHSET_EXPERIMENT, 8, true >( data );
+   test_cuckoo< 50, DATACOUNT_HASHSET_EXPERIMENT, 4, true >( data );
+   test_cuckoo< 90, DATACOUNT_HASHSET_EXPERIMENT, 8, false >( data );
+   test_cuckoo< 90, DATACOUNT_HASHSET_EXPERIMENT, 8, true >( data );
+   test_cuckoo< 90, DATACOUNT_HASHSET_EXPERIMENT, 4, true >( data );
+   test_cuckoo< 95, DATACOUNT_HASHSET_EXPERIMENT, 8, false >( data );
+   test_cuckoo< 95, DATACOUNT_HASHSET_EXPERIMENT, 8, true >( data );
+   test_cuckoo< 95, DATACOUNT_HASHSET_EXPERIMENT, 4, true >( data );
+   test_cuckoo< 97, DATACOUNT_HASHSET_EXPERIMENT, 8, true >( data );
+   test_cuckoo< 99, DATACOUNT_HASHSET_EXPERIMENT, 8, false >( data );
+   test_cuckoo< 99, DATACOUNT_HASHSET_EXPERIMENT, 8, true >( data );
+
+   test_robin_hood< 50, DATACOUNT_HASHSET_EXPERIMENT >( data );
+   test_robin_hood< 90, DATACOUNT_HASHSET_EXPERIMENT >( data );
+   test_robin_hood< 95, DATACOUNT_HASHSET_EXPERIMENT >( data );
+   test_robin_hood< 99, DATACOUNT_HASHSET_EXPERIMENT >( data );
+
+   test_bloom_filter< 50, DATACOUNT_HASHSET_EXPERIMENT, 0, 10 >( data );
+   test_bloom_filter< 50, DATACOUNT_HASHSET_EXPERIMENT, 10, 10 >( data );
+   test_bloom_filter< 50, DATACOUNT_HASHSET_EXPERIMENT, 50, 10 >( data );
+   test_bloom_filter< 50, DATACOUNT_HASHSET_EXPERIMENT, 100, 10 >( data );
+   test_bloom_filter< 90, DATACOUNT_HASHSET_EXPERIMENT, 0, 10 >( data );
+   test_bloom_filter< 90, DATACOUNT_HASHSET_EXPERIMENT, 10, 10 >( data );
+   test_bloom_filter< 90, DATACOUNT_HASHSET_EXPERIMENT, 50, 10 >( data );
+   test_bloom_filter< 90, DATACOUNT_HASHSET_EXPERIMENT, 100, 10 >( data );
+   test_bloom_filter< 90, DATACOUNT_HASHSET_EXPERIMENT, 0, 16 >( data );
+
+   test_uint64< 50, DATACOUNT_HASHSET_EXPERIMENT, 0 >( data );
+   test_uint64< 50, DATACOUNT_HASHSET_EXPERIMENT, 1 >( data );
+   test_uint64< 50, DATACOUNT_HASHSET_EXPERIMENT, 2 >( data );
+   test_uint64< 50, DATACOUNT_HASHSET_EXPERIMENT, 3 >( data );
+   test_uint64< 90, DATACOUNT_HASHSET_EXPERIMENT, 0 >( data );
+   test_uint64< 90, DATACOUNT_HASHSET_EXPERIMENT, 1 >( data );
+   test_uint64< 90, DATACOUNT_HASHSET_EXPERIMENT, 2 >( data );
+   test_uint64< 90, DATACOUNT_HASHSET_EXPERIMENT, 3 >( data );
+   test_uint64< 99, DATACOUNT_HASHSET_EXPERIMENT, 0 >( data );
+   test_uint64< 99, DATACOUNT_HASHSET_EXPERIMENT, 1 >( data );
+   test_uint64< 99, DATACOUNT_HASHSET_EXPERIMENT, 2 >( data );
+   test_uint64< 99, DATACOUNT_HASHSET_EXPERIMENT, 3 >( data );
+
+   test_mapped< 50, DATACOUNT_HASHSET_EXPERIMENT >( data );
+   test_mapped< 90, DATACOUNT_HASHSET_EXPERIMENT >( data );
+
+   test_allocation< 90, DATACOUNT_HASHSET_EXPERIMENT, container_allocation_new >( data, "NEW" );
+   test_allocation< 90, DATACOUNT_HASHSET_EXPERIMENT,
+      container_allocation_mapped< huge_pages::none, numa_placement::first_touch, 1 > >( data, "MAPPED_4K_1T" );
+   test_allocation< 90, DATACOUNT_HASHSET_EXPERIMENT,
+      container_allocation_mapped< huge_pages::none, numa_placement::first_touch > >( data, "MAPPED_4K_FIRST_TOUCH" );
+   test_allocation< 90, DATACOUNT_HASHSET_EXPERIMENT,
+      container_allocation_mapped< huge_pages::transparent, numa_placement::first_touch > >( data, "THP_FIRST_TOUCH" );
+   test_allocation< 90, DATACOUNT_HASHSET_EXPERIMENT,
+      container_allocation_mapped< huge_pages::transparent, numa_placement::interleave > >( data, "THP_INTERLEAVE" );
+   test_allocation< 90, DATACOUNT_HASHSET_EXPERIMENT,
+      container_allocation_mapped< huge_pages::reserved, numa_placement::local > >( data, "HUGETLB_LOCAL" );
+
+   test_stream_build< 50, DATACOUNT_HASHSET_EXPERIMENT, 1024 >( data );
+   test_stream_build< 50, DATACOUNT_HASHSET_EXPERIMENT, 65536 >( data );
+   test_stream_build< 90, DATACOUNT_HASHSET_EXPERIMENT, 1024 >( data );
+   test_stream_build< 90, DATACOUNT_HASHSET_EXPERIMENT, 65536 >( data );
+   test_stream_build< 99, DATACOUNT_HASHSET_EXPERIMENT, 1024 >( data );
+   test_stream_build< 99, DATACOUNT_HASHSET_EXPERIMENT, 65536 >( data );
+
+   test_sliding_window< 50, DATACOUNT_HASHSET_EXPERIMENT, 10 >( data );
+   test_sliding_window< 50, DATACOUNT_HASHSET_EXPERIMENT, 40 >( data );
+   test_sliding_window< 80, DATACOUNT_HASHSET_EXPERIMENT, 5 >( data );
+   test_sliding_window< 80, DATACOUNT_HASHSET_EXPERIMENT, 15 >( data );
+
+   test_merge< 50, DATACOUNT_HASHSET_EXPERIMENT, 8, 1, false >( data );
+   test_merge< 50, DATACOUNT_HASHSET_EXPERIMENT, 8, 1, true >( data );
+   test_merge< 50, DATACOUNT_HASHSET_EXPERIMENT, 8, 4, true >( data );
+   test_merge< 90, DATACOUNT_HASHSET_EXPERIMENT, 8, 1, false >( data );
+   test_merge< 90, DATACOUNT_HASHSET_EXPERIMENT, 8, 1, true >( data );
+   test_merge< 90, DATACOUNT_HASHSET_EXPERIMENT, 8, 4, true >( data );
 
+   test_export< 50, DATACOUNT_HASHSET_EXPERIMENT, 1 >( data );
+   test_export< 50, DATACOUNT_HASHSET_EXPERIMENT, 4 >( data );
+   test_export< 90, DATACOUNT_HASHSET_EXPERIMENT, 1 >( data );
+   test_export< 90, DATACOUNT_HASHSET_EXPERIMENT, 4 >( data );
    free( ( void * ) result_count );
    free( ( void * ) result );
    free( ( void * ) data );
@@ -213,6 +1126,10 @@ int main( int argc, char** argv ) {
              "#      Distribution: " << "std::uniform_int_distribution< uint32_t >\n" <<
              "#  [ lower, upper ]: " << "[ 1, " << std::numeric_limits< uint32_t > ::max() << " ]\n" <<
              "Phase;Variant;BitWidth;Rep;DataCount;LoadFactor;ContainerSize;DistinctKeysInContainer;TimeMs\n";
+#ifdef HASH_SET_STATISTICS
+   std::cout << "#Statistics: built with HASH_SET_STATISTICS, the timings include the counting. STATS rows hold the\n" <<
+                "#            occupied slots in DistinctKeysInContainer and the metric in TimeMs.\n";
+#endif
 
    test< DATACOUNT_HASHSET_EXPERIMENT_L1 >( );
    test< DATACOUNT_HASHSET_EXPERIMENT_L2 >( );
@@ -0,0 +1,180 @@
+/**
+ * @file hyperloglog_experiment.cpp
+ * @brief HyperLogLog sketch against the exact histogramm on the ComplexDataGenerator distributions.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <string>
+
+#include "../../../main/datastructures/set/hash_set.h"
+#include "../../../main/datastructures/set/hyperloglog.h"
+
+#include "../../BenchmarkFramework/datagen/BinomialDistribution.h"
+#include "../../BenchmarkFramework/datagen/CompositeDistribution.h"
+#include "../../BenchmarkFramework/datagen/ConstantDistribution.h"
+#include "../../BenchmarkFramework/datagen/UniformDistributionBw.h"
+#include "../../BenchmarkFramework/general/buffers.h"
+#include "../../BenchmarkFramework/datagen/ComplexDataGenerator.h"
+
+#define DATACOUNT_HYPERLOGLOG_EXPERIMENT_L2 64000
+#define DATACOUNT_HYPERLOGLOG_EXPERIMENT_L3 4096000
+#define DATACOUNT_HYPERLOGLOG_EXPERIMENT_BLOB_400MB 100000000
+
+#define LOADFACTOR_HYPERLOGLOG_EXPERIMENT 90
+
+using namespace DresdenDBSystemsGroup::CompressionProject::BenchmarkFramework;
+using namespace DresdenDBSystemsGroup::CompressionProject::DataGenerators;
+
+int NUM_HASHSET_EXPERIMENT_REP;
+
+/* SKETCH builds the sketch ( estimate in DistinctKeysInContainer, registers in ContainerSize ), ERROR is its relative
+ * error in percent against the exact distinct count. */
+template< size_t Precision >
+void test_sketch( std::string const & distribution, uint32_t const * const data, size_t const data_count, size_t const exact ) {
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << data_count << "  Sketch " << distribution << " HLL" << Precision
+                << ": [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: " << std::flush;
+      hyperloglog< uint32_t > sketch{ Precision };
+      auto start = std::chrono::high_resolution_clock::now( );
+      sketch.build( data, data_count );
+      double const estimate = sketch.estimate( );
+      auto end = std::chrono::high_resolution_clock::now( );
+      double const error = 100.0 * ( estimate - ( double ) exact ) / ( double ) exact;
+      if( i > 0 ) {
+         std::cout << "SKETCH;HLL" << Precision << "_" << distribution << ";32;" << i << ";" << data_count << ";"
+                   << LOADFACTOR_HYPERLOGLOG_EXPERIMENT << ";" << sketch.get_memory_footprint( ) << ";"
+                   << ( size_t ) std::llround( estimate ) << ";"
+                   << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+         std::cout << "ERROR;HLL" << Precision << "_" << distribution << ";32;" << i << ";" << data_count << ";"
+                   << LOADFACTOR_HYPERLOGLOG_EXPERIMENT << ";" << sketch.get_memory_footprint( ) << ";"
+                   << exact << ";" << error << "\n";
+      }
+      std::cerr << "Done ( " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms, error "
+                << error << " % )\n";
+   }
+}
+
+/* BUILD;EXACT sizes the table for data_count keys, BUILD;HLL<Precision>_SIZED for the upper bound of the estimate
+ * and streams the keys in, the sketch is included in its time. */
+template< size_t Precision >
+void test_sized_build( std::string const & distribution, uint32_t const * const data, size_t const data_count ) {
+#pragma _NEC novector
+   for( size_t i = 0; i < NUM_HASHSET_EXPERIMENT_REP+1; ++i ) {
+      std::cerr << std::setw( 10 ) << data_count << "  Build " << distribution << " exact / HLL" << Precision
+                << " sized: [ " << std::setw( 2 ) << i << " / " << std::setw( 2 ) << NUM_HASHSET_EXPERIMENT_REP << " ]: " << std::flush;
+      auto start = std::chrono::high_resolution_clock::now( );
+      {
+         const_sized_basic_histogramm< uint32_t > histogramm{ ( uint32_t ) data_count, LOADFACTOR_HYPERLOGLOG_EXPERIMENT };
+         histogramm.build_vectorized_batch( data );
+         auto end = std::chrono::high_resolution_clock::now( );
+         if( i > 0 ) {
+            std::cout << "BUILD;EXACT_" << distribution << ";32;" << i << ";" << data_count << ";"
+                      << LOADFACTOR_HYPERLOGLOG_EXPERIMENT << ";" << histogramm.get_size( ) << ";"
+                      << histogramm.key_count( ) << ";"
+                      << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+         }
+         std::cerr << "Done ( exact " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms, ";
+      }
+      start = std::chrono::high_resolution_clock::now( );
+      {
+         hyperloglog< uint32_t > sketch{ Precision };
+         sketch.build( data, data_count );
+         size_t const upper_bound = sketch.estimate_upper_bound( );
+         const_sized_basic_histogramm< uint32_t > histogramm{
+            ( uint32_t ) ( ( upper_bound < data_count ) ? upper_bound : data_count ), LOADFACTOR_HYPERLOGLOG_EXPERIMENT };
+         histogramm.begin_build( );
+         histogramm.consume( data, data_count );
+         histogramm.finish_build( );
+         auto end = std::chrono::high_resolution_clock::now( );
+         if( i > 0 ) {
+            std::cout << "BUILD;HLL" << Precision << "_SIZED_" << distribution << ";32;" << i << ";" << data_count << ";"
+                      << LOADFACTOR_HYPERLOGLOG_EXPERIMENT << ";" << histogramm.get_size( ) << ";"
+                      << histogramm.key_count( ) << ";"
+                      << std::chrono::duration< double, std::milli >( end - start ).count( ) << "\n";
+         }
+         std::cerr << "sized " << std::chrono::duration< double, std::milli >( end - start ).count( ) << " ms )\n";
+      }
+   }
+}
+
+void test_distribution( std::string const & distribution, ComplexDataGenerator & generator, uint32_t * const data,
+                        size_t const data_count ) {
+   std::cerr << std::setw( 10 ) << data_count << "  Generating " << distribution << "... " << std::flush;
+   generator.generate( data );
+   size_t exact;
+   {
+      const_sized_basic_histogramm< uint32_t > histogramm{ ( uint32_t ) data_count, LOADFACTOR_HYPERLOGLOG_EXPERIMENT };
+      histogramm.build_vectorized_batch( data );
+      exact = histogramm.key_count( );
+   }
+   std::cerr << "OK ( " << exact << " distinct keys )\n";
+   test_sketch< 10 >( distribution, data, data_count, exact );
+   test_sketch< 14 >( distribution, data, data_count, exact );
+   test_sketch< 18 >( distribution, data, data_count, exact );
+   test_sized_build< 14 >( distribution, data, data_count );
+}
+
+template< uint32_t DATACOUNT_HYPERLOGLOG_EXPERIMENT >
+void test( void ) {
+   uint32_t * const data = allocateAlignedBuffer< uint32_t >( DATACOUNT_HYPERLOGLOG_EXPERIMENT, false );
+   /* bit widths from a few hundred distinct keys up to ( nearly ) all keys distinct, all values are non zero */
+   size_t const bit_widths[ 5 ] = { 8, 12, 16, 20, 32 };
+   for( size_t bw = 0; bw < 5; ++bw ) {
+      ComplexDataGenerator generator(
+         DATACOUNT_HYPERLOGLOG_EXPERIMENT,
+         { { new UniformDistributionBw( bit_widths[ bw ] ), new ConstantDistribution( 1 ), true } },
+         ComplexDataGenerator::SortOrder::SORTORDER_NONE
+      );
+      test_distribution( "UNIFORM_BW" + std::to_string( bit_widths[ bw ] ), generator, data, DATACOUNT_HYPERLOGLOG_EXPERIMENT );
+   }
+   /* skewed: most keys from 4 bits, a varying share from 28 bits */
+   size_t const prob_denom = 1024;
+   BinomialDistribution * const chooser = new BinomialDistribution( 1, 1, prob_denom, 0 );
+   ComplexDataGenerator composite_generator(
+      DATACOUNT_HYPERLOGLOG_EXPERIMENT,
+      { { new CompositeDistribution( { new UniformDistributionBw( 4 ), new UniformDistributionBw( 28 ) }, chooser ),
+          new ConstantDistribution( 1 ), true } },
+      ComplexDataGenerator::SortOrder::SORTORDER_NONE
+   );
+   for( size_t prob_num = 1; prob_num <= prob_denom; prob_num *= 16 ) {
+      chooser->setProbNumerator( prob_num );
+      test_distribution( "COMPOSITE_4_28_P" + std::to_string( prob_num ), composite_generator, data, DATACOUNT_HYPERLOGLOG_EXPERIMENT );
+   }
+   /* runs of 16 equal keys */
+   ComplexDataGenerator run_generator(
+      DATACOUNT_HYPERLOGLOG_EXPERIMENT,
+      { { new UniformDistributionBw( 24 ), new ConstantDistribution( 16 ), true } },
+      ComplexDataGenerator::SortOrder::SORTORDER_NONE
+   );
+   test_distribution( "RUNS16_BW24", run_generator, data, DATACOUNT_HYPERLOGLOG_EXPERIMENT );
+   freeAlignedBuffer( data );
+}
+
+int main( int argc, char** argv ) {
+
+   if( argc == 1 )
+      NUM_HASHSET_EXPERIMENT_REP = 10;
+   else
+      NUM_HASHSET_EXPERIMENT_REP = std::atoi( argv[ 1 ] );
+
+   std::cout << "#Data:\n" <<
+             "#         Generator: " << "ComplexDataGenerator\n" <<
+             "#      Distribution: " << "UniformDistributionBw, CompositeDistribution ( Binomial chooser ), runs\n" <<
+             "#Sketch: SKETCH rows hold the estimate in DistinctKeysInContainer and the register bytes in ContainerSize,\n" <<
+             "#        ERROR rows the exact distinct count in DistinctKeysInContainer and the relative error ( % ) in TimeMs.\n" <<
+             "Phase;Variant;BitWidth;Rep;DataCount;LoadFactor;ContainerSize;DistinctKeysInContainer;TimeMs\n";
+
+   test< DATACOUNT_HYPERLOGLOG_EXPERIMENT_L2 >( );
+   test< DATACOUNT_HYPERLOGLOG_EXPERIMENT_L3 >( );
+   test< DATACOUNT_HYPERLOGLOG_EXPERIMENT_BLOB_400MB >( );
+
+   return 0;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file grouped_aggregation.h
+ * @brief SUM / MIN / MAX / AVG of several payload columns grouped by a key column.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_GROUPED_AGGREGATION_H
+#define GENERAL_GROUPED_AGGREGATION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include "../../datastructures/set/hash_set.h"
+
+enum aggregate_function : uint32_t {
+   AGGREGATE_SUM = 1,
+   AGGREGATE_MIN = 2,
+   AGGREGATE_MAX = 4,
+   AGGREGATE_AVG = 8
+};
+
+/**
+ * Group-by aggregation on a const_sized_basic_histogramm. The key column is inserted with the 256-lane
+ * build_vectorized_batch, which also reports the slot of every row, the histogramm counts are the group sizes.
+ * The aggregate states are kept columnar: one array of container_size states per payload column and aggregate
+ * function, indexed by the slot of the group. Every payload column is then folded in a single pass over its rows,
+ * so each update loop touches one input and one state array and stays vectorizable.
+ * Only the states of the requested aggregates (a mask of aggregate_function) are allocated, AVG is computed from
+ * the SUM state and the group size.
+ */
+template< typename T, typename ValueT = int64_t, class SlotMapping = slot_mapping_modulo >
+class grouped_aggregation {
+   private:
+      typedef const_sized_basic_histogramm< T, SlotMapping > histogramm_t;
+
+      size_t         const ElementCount;
+      size_t         const PayloadCount;
+      uint32_t       const Aggregates;
+      histogramm_t         histogramm;
+      size_t         const container_size;
+      size_t         const container_infinity_value;
+      size_t      *  const key_slots;
+      ValueT      ** const sum_states;
+      ValueT      ** const min_states;
+      ValueT      ** const max_states;
+
+      static ValueT ** allocate_states( bool const needed, size_t const columns, size_t const size, ValueT const init ) {
+         if( !needed )
+            return nullptr;
+         ValueT ** states = new ValueT*[ columns ];
+         for( size_t column = 0; column < columns; ++column ) {
+            states[ column ] = new ValueT[ size ];
+            for( size_t slot = 0; slot < size; ++slot )
+               states[ column ][ slot ] = init;
+         }
+         return states;
+      }
+      static void free_states( ValueT ** const states, size_t const columns ) noexcept {
+         if( states == nullptr )
+            return;
+         for( size_t column = 0; column < columns; ++column )
+            delete[ ] states[ column ];
+         delete[ ] states;
+      }
+      size_t slot_of( T const key ) const noexcept {
+         return ( size_t ) histogramm.probe( key );
+      }
+   public:
+      grouped_aggregation( uint32_t _ElemCount, uint32_t _LoadFactor, size_t _PayloadCount, uint32_t _Aggregates ):
+         ElementCount{ _ElemCount },
+         PayloadCount{ _PayloadCount },
+         Aggregates{ _Aggregates },
+         histogramm{ _ElemCount, _LoadFactor },
+         container_size{ ( size_t ) histogramm.get_size( ) },
+         container_infinity_value{ container_size + 1 },
+         key_slots{ new size_t[ ( _ElemCount > 0 ) ? _ElemCount : 1 ] },
+         sum_states{ allocate_states( ( _Aggregates & ( AGGREGATE_SUM | AGGREGATE_AVG ) ) != 0, _PayloadCount, container_size, 0 ) },
+         min_states{ allocate_states( ( _Aggregates & AGGREGATE_MIN ) != 0, _PayloadCount, container_size, std::numeric_limits< ValueT >::max( ) ) },
+         max_states{ allocate_states( ( _Aggregates & AGGREGATE_MAX ) != 0, _PayloadCount, container_size, std::numeric_limits< ValueT >::lowest( ) ) } {
+      }
+      virtual ~grouped_aggregation( void ) noexcept {
+         free_states( max_states, PayloadCount );
+         free_states( min_states, PayloadCount );
+         free_states( sum_states, PayloadCount );
+         delete[ ] key_slots;
+      }
+      histogramm_t const & get_histogramm( void ) const noexcept {
+         return histogramm;
+      }
+      size_t get_group_count( void ) const noexcept {
+         return histogramm.key_count( );
+      }
+      /* payload_columns[ c ] holds the ElementCount values of payload column c, row aligned with keys */
+      void build( T const * const keys, ValueT const * const * const payload_columns ) noexcept {
+         histogramm.build_vectorized_batch( keys, key_slots );
+         for( size_t column = 0; column < PayloadCount; ++column ) {
+            ValueT const * const values = payload_columns[ column ];
+            if( sum_states != nullptr ) {
+               ValueT * const sums = sum_states[ column ];
+               for( size_t row = 0; row < ElementCount; ++row ) {
+                  sums[ key_slots[ row ] ] += values[ row ];
+               }
+            }
+            if( min_states != nullptr ) {
+               ValueT * const mins = min_states[ column ];
+               for( size_t row = 0; row < ElementCount; ++row ) {
+                  ValueT const value = values[ row ];
+                  ValueT const state = mins[ key_slots[ row ] ];
+                  mins[ key_slots[ row ] ] = ( value < state ) ? value : state;
+               }
+            }
+            if( max_states != nullptr ) {
+               ValueT * const maxs = max_states[ column ];
+               for( size_t row = 0; row < ElementCount; ++row ) {
+                  ValueT const value = values[ row ];
+                  ValueT const state = maxs[ key_slots[ row ] ];
+                  maxs[ key_slots[ row ] ] = ( value > state ) ? value : state;
+               }
+            }
+         }
+      }
+      uint64_t get_count( T key ) const noexcept {
+         return histogramm.probe_count_vectorized( key );
+      }
+      /* the getters return 0 for absent keys and for aggregates which were not requested */
+      ValueT get_sum( T key, size_t const column ) const noexcept {
+         if( sum_states == nullptr )
+            return 0;
+         size_t const slot = slot_of( key );
+         return ( slot < container_infinity_value ) ? sum_states[ column ][ slot ] : 0;
+      }
+      ValueT get_min( T key, size_t const column ) const noexcept {
+         if( min_states == nullptr )
+            return 0;
+         size_t const slot = slot_of( key );
+         return ( slot < container_infinity_value ) ? min_states[ column ][ slot ] : 0;
+      }
+      ValueT get_max( T key, size_t const column ) const noexcept {
+         if( max_states == nullptr )
+            return 0;
+         size_t const slot = slot_of( key );
+         return ( slot < container_infinity_value ) ? max_states[ column ][ slot ] : 0;
+      }
+      double get_avg( T key, size_t const column ) const noexcept {
+         if( sum_states == nullptr )
+            return 0.0;
+         size_t const slot = slot_of( key );
+         if( slot >= container_infinity_value )
+            return 0.0;
+         return ( double ) sum_states[ column ][ slot ] / ( double ) histogramm.get_key_count_container( )[ slot ];
+      }
+      /**
+       * State arrays indexed by slot, for scans over all groups together with get_histogramm( ).get_key_container( ).
+       * Slots with key 0 are empty. Returns nullptr for aggregates which were not requested.
+       */
+      ValueT const * get_states( aggregate_function const aggregate, size_t const column ) const noexcept {
+         switch( aggregate ) {
+            case AGGREGATE_SUM:
+            case AGGREGATE_AVG:
+               return ( sum_states != nullptr ) ? sum_states[ column ] : nullptr;
+            case AGGREGATE_MIN:
+               return ( min_states != nullptr ) ? min_states[ column ] : nullptr;
+            case AGGREGATE_MAX:
+               return ( max_states != nullptr ) ? max_states[ column ] : nullptr;
+         }
+         return nullptr;
+      }
+};
+
+#endif //GENERAL_GROUPED_AGGREGATION_H
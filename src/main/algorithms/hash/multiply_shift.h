@@ -0,0 +1,63 @@
+/**
+ * @file multiply_shift.h
+ * @brief Multiply-add-shift hashing (Dietzfelbinger).
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_MULTIPLY_SHIFT_H
+#define GENERAL_MULTIPLY_SHIFT_H
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * h( x ) = ( a * x + b ) >> 32 with 64-bit a and b: one multiplication, one addition and a shift. The hash is the
+ * upper half of the product, whose bits depend on all key bits. Universal, but it keeps the order of dense keys:
+ * consecutive keys get hashes a / 2^32 apart, which spreads them evenly but leaves no randomness.
+ */
+template< typename T >
+class multiply_shift {};
+
+template< >
+class multiply_shift< uint32_t > {
+   public:
+      typedef uint32_t hash_type;
+   private:
+      uint64_t const multiplier;
+      uint64_t const increment;
+   public:
+      multiply_shift( void ) : multiplier{ 0x9e3779b97f4a7c15ULL }, increment{ 0xf39cc0605cedc834ULL } { }
+      multiply_shift( uint64_t _seed ) : multiplier{ ( _seed * 0x9e3779b97f4a7c15ULL ) | 1 }, increment{ _seed ^ 0xf39cc0605cedc834ULL } { }
+      inline uint32_t operator()( uint32_t const _key ) const noexcept {
+         return ( uint32_t ) ( ( multiplier * ( uint64_t ) _key + increment ) >> 32 );
+      }
+      inline void hash_batch( uint32_t const * const keys, size_t const count, uint32_t * const out ) const noexcept {
+         for( size_t i = 0; i < count; ++i ) {
+            out[ i ] = operator()( keys[ i ] );
+         }
+      }
+};
+
+/* 64-bit keys: the product is taken modulo 2^64, so the hash has 32 significant bits */
+template< >
+class multiply_shift< uint64_t > {
+   public:
+      typedef uint64_t hash_type;
+   private:
+      uint64_t const multiplier;
+      uint64_t const increment;
+   public:
+      multiply_shift( void ) : multiplier{ 0x9e3779b97f4a7c15ULL }, increment{ 0xf39cc0605cedc834ULL } { }
+      multiply_shift( uint64_t _seed ) : multiplier{ ( _seed * 0x9e3779b97f4a7c15ULL ) | 1 }, increment{ _seed ^ 0xf39cc0605cedc834ULL } { }
+      inline uint64_t operator()( uint64_t const _key ) const noexcept {
+         return ( multiplier * _key + increment ) >> 32;
+      }
+      inline void hash_batch( uint64_t const * const keys, size_t const count, uint64_t * const out ) const noexcept {
+         for( size_t i = 0; i < count; ++i ) {
+            out[ i ] = operator()( keys[ i ] );
+         }
+      }
+};
+
+#endif //GENERAL_MULTIPLY_SHIFT_H
@@ -7,6 +7,13 @@
 
 #ifndef GENERAL_MURMUR3_H
 #define GENERAL_MURMUR3_H
+
+#include <cstdint>
+#include <cstddef>
+#if defined( __AVX2__ ) || defined( __AVX512F__ )
+#   include <immintrin.h>
+#endif
+
 /* adapted from https://github.com/PeterScott/murmur3 */
 template< typename T >
 class murmur3 {};
@@ -16,6 +23,8 @@ class murmur3< uint32_t > {
    private:
       uint32_t const seed;
    public:
+      typedef uint32_t hash_type;
+
       murmur3( void ) : seed{ 0 } { }
       murmur3( uint32_t _seed ) : seed{ _seed } { }
       inline uint32_t operator()( uint32_t const _key ) const noexcept {
@@ -52,48 +61,155 @@ class murmur3< uint32_t > {
          h1 ^= h1 >> 16;
          return h1;
       }
+#ifdef __AVX512F__
+      inline __m512i operator()( __m512i const _key ) const noexcept {
+         __m512i k1 = _mm512_mullo_epi32( _key, _mm512_set1_epi32( ( int ) 0xcc9e2d51 ) );
+         k1 = _mm512_rol_epi32( k1, 15 );
+         k1 = _mm512_mullo_epi32( k1, _mm512_set1_epi32( ( int ) 0x1b873593 ) );
+         __m512i h1 = _mm512_xor_si512( _mm512_set1_epi32( ( int ) seed ), k1 );
+         h1 = _mm512_rol_epi32( h1, 13 );
+         h1 = _mm512_add_epi32( _mm512_mullo_epi32( h1, _mm512_set1_epi32( 5 ) ), _mm512_set1_epi32( ( int ) 0xe6546b64 ) );
+         h1 = _mm512_xor_si512( h1, _mm512_set1_epi32( 4 ) );
+         h1 = _mm512_xor_si512( h1, _mm512_srli_epi32( h1, 16 ) );
+         h1 = _mm512_mullo_epi32( h1, _mm512_set1_epi32( ( int ) 0x85ebca6b ) );
+         h1 = _mm512_xor_si512( h1, _mm512_srli_epi32( h1, 13 ) );
+         h1 = _mm512_mullo_epi32( h1, _mm512_set1_epi32( ( int ) 0xc2b2ae35 ) );
+         h1 = _mm512_xor_si512( h1, _mm512_srli_epi32( h1, 16 ) );
+         return h1;
+      }
+#endif
+#ifdef __AVX2__
+      inline __m256i operator()( __m256i const _key ) const noexcept {
+         __m256i k1 = _mm256_mullo_epi32( _key, _mm256_set1_epi32( ( int ) 0xcc9e2d51 ) );
+         k1 = _mm256_or_si256( _mm256_slli_epi32( k1, 15 ), _mm256_srli_epi32( k1, 17 ) );
+         k1 = _mm256_mullo_epi32( k1, _mm256_set1_epi32( ( int ) 0x1b873593 ) );
+         __m256i h1 = _mm256_xor_si256( _mm256_set1_epi32( ( int ) seed ), k1 );
+         h1 = _mm256_or_si256( _mm256_slli_epi32( h1, 13 ), _mm256_srli_epi32( h1, 19 ) );
+         h1 = _mm256_add_epi32( _mm256_mullo_epi32( h1, _mm256_set1_epi32( 5 ) ), _mm256_set1_epi32( ( int ) 0xe6546b64 ) );
+         h1 = _mm256_xor_si256( h1, _mm256_set1_epi32( 4 ) );
+         h1 = _mm256_xor_si256( h1, _mm256_srli_epi32( h1, 16 ) );
+         h1 = _mm256_mullo_epi32( h1, _mm256_set1_epi32( ( int ) 0x85ebca6b ) );
+         h1 = _mm256_xor_si256( h1, _mm256_srli_epi32( h1, 13 ) );
+         h1 = _mm256_mullo_epi32( h1, _mm256_set1_epi32( ( int ) 0xc2b2ae35 ) );
+         h1 = _mm256_xor_si256( h1, _mm256_srli_epi32( h1, 16 ) );
+         return h1;
+      }
+#endif
+      /**
+       * Hashes keys[ 0 .. count ) into out. The scalar loop has no dependencies between iterations and vectorizes
+       * on NCC, on x86 explicit AVX-512 / AVX2 kernels are used when available.
+       */
+      inline void hash_batch( uint32_t const * const keys, size_t const count, uint32_t * const out ) const noexcept {
+#if defined( __AVX512F__ )
+         hash_batch_avx512( keys, count, out );
+#elif defined( __AVX2__ )
+         hash_batch_avx2( keys, count, out );
+#else
+         hash_batch_scalar( keys, count, out );
+#endif
+      }
+      inline void hash_batch_scalar( uint32_t const * const keys, size_t const count, uint32_t * const out ) const noexcept {
+         for( size_t i = 0; i < count; ++i ) {
+            out[ i ] = operator()( keys[ i ] );
+         }
+      }
+#ifdef __AVX512F__
+      inline void hash_batch_avx512( uint32_t const * const keys, size_t const count, uint32_t * const out ) const noexcept {
+         size_t const full = count & ~( size_t ) 15;
+         for( size_t i = 0; i < full; i += 16 ) {
+            _mm512_storeu_si512( ( void * ) ( out + i ), operator()( _mm512_loadu_si512( ( void const * ) ( keys + i ) ) ) );
+         }
+         if( full < count ) {
+            __mmask16 const tail = ( __mmask16 ) ( ( 1U << ( count - full ) ) - 1 );
+            _mm512_mask_storeu_epi32( out + full, tail, operator()( _mm512_maskz_loadu_epi32( tail, keys + full ) ) );
+         }
+      }
+#endif
+#ifdef __AVX2__
+      inline void hash_batch_avx2( uint32_t const * const keys, size_t const count, uint32_t * const out ) const noexcept {
+         size_t const full = count & ~( size_t ) 7;
+         for( size_t i = 0; i < full; i += 8 ) {
+            _mm256_storeu_si256( ( __m256i * ) ( out + i ), operator()( _mm256_loadu_si256( ( __m256i const * ) ( keys + i ) ) ) );
+         }
+         hash_batch_scalar( keys + full, count - full, out + full );
+      }
+#endif
 };
 
+/**
+ * 64-bit keys are mixed as one 8 byte block of MurmurHash3_x64 (constants c1 / c2, rotation by 31) and finalized
+ * with fmix64. All 64 key bits take part and the full 64-bit hash is returned. Mixing and finalizer are bijective,
+ * so distinct keys never share a hash value.
+ */
 template< >
 class murmur3< uint64_t > {
    private:
       uint64_t const seed;
+      static inline uint64_t hash( uint64_t const _key, uint64_t const _seed ) noexcept {
+         uint64_t k1 = _key;
+         k1 *= 0x87c37b91114253d5ULL;
+         k1 = (k1 << 31) | (k1 >> 33);
+         k1 *= 0x4cf5ad432745937fULL;
+         uint64_t h1 = _seed ^ k1;
+         h1 ^= 8;
+         h1 ^= h1 >> 33;
+         h1 *= 0xff51afd7ed558ccdULL;
+         h1 ^= h1 >> 33;
+         h1 *= 0xc4ceb9fe1a85ec53ULL;
+         h1 ^= h1 >> 33;
+         return h1;
+      }
    public:
+      typedef uint64_t hash_type;
+
       murmur3( void ) : seed{ 0 } { }
       murmur3( uint64_t _seed ) : seed{ _seed } { }
-      inline uint32_t operator()( uint32_t const _key ) const noexcept {
-         uint32_t h1 = seed;
-         uint32_t k1 = _key;
-         k1 *= 0xcc9e2d51;
-         k1 = (k1 << 15) | (k1 >> 17);
-         k1 *= 0x1b873593;
-         h1 ^= k1;
-         h1 = (h1 << 13) | (h1 >> 19);
-         h1 = h1*5+0xe6546b64;
-         h1 ^= 4;
-         h1 ^= h1 >> 16;
-         h1 *= 0x85ebca6b;
-         h1 ^= h1 >> 13;
-         h1 *= 0xc2b2ae35;
-         h1 ^= h1 >> 16;
-         return h1;
+      inline uint64_t operator()( uint64_t const _key ) const noexcept {
+         return hash( _key, seed );
       }
-      inline uint32_t operator()( uint32_t const _key, uint32_t const _seed ) const noexcept {
-         uint32_t h1 = _seed;
-         uint32_t k1 = _key;
-         k1 *= 0xcc9e2d51;
-         k1 = (k1 << 15) | (k1 >> 17);
-         k1 *= 0x1b873593;
-         h1 ^= k1;
-         h1 = (h1 << 13) | (h1 >> 19);
-         h1 = h1*5+0xe6546b64;
-         h1 ^= 4;
-         h1 ^= h1 >> 16;
-         h1 *= 0x85ebca6b;
-         h1 ^= h1 >> 13;
-         h1 *= 0xc2b2ae35;
-         h1 ^= h1 >> 16;
+      inline uint64_t operator()( uint64_t const _key, uint64_t const _seed ) const noexcept {
+         return hash( _key, _seed );
+      }
+#if defined( __AVX512F__ ) && defined( __AVX512DQ__ )
+      /* 8 keys, 64-bit multiplications need AVX512DQ */
+      inline __m512i operator()( __m512i const _key ) const noexcept {
+         __m512i k1 = _mm512_mullo_epi64( _key, _mm512_set1_epi64( ( long long ) 0x87c37b91114253d5ULL ) );
+         k1 = _mm512_rol_epi64( k1, 31 );
+         k1 = _mm512_mullo_epi64( k1, _mm512_set1_epi64( ( long long ) 0x4cf5ad432745937fULL ) );
+         __m512i h1 = _mm512_xor_si512( _mm512_set1_epi64( ( long long ) seed ), k1 );
+         h1 = _mm512_xor_si512( h1, _mm512_set1_epi64( 8 ) );
+         h1 = _mm512_xor_si512( h1, _mm512_srli_epi64( h1, 33 ) );
+         h1 = _mm512_mullo_epi64( h1, _mm512_set1_epi64( ( long long ) 0xff51afd7ed558ccdULL ) );
+         h1 = _mm512_xor_si512( h1, _mm512_srli_epi64( h1, 33 ) );
+         h1 = _mm512_mullo_epi64( h1, _mm512_set1_epi64( ( long long ) 0xc4ceb9fe1a85ec53ULL ) );
+         h1 = _mm512_xor_si512( h1, _mm512_srli_epi64( h1, 33 ) );
          return h1;
       }
+#endif
+      /* Hashes keys[ 0 .. count ) into out, 8 keys per step with AVX512DQ. */
+      inline void hash_batch( uint64_t const * const keys, size_t const count, uint64_t * const out ) const noexcept {
+#if defined( __AVX512F__ ) && defined( __AVX512DQ__ )
+         hash_batch_avx512( keys, count, out );
+#else
+         hash_batch_scalar( keys, count, out );
+#endif
+      }
+      inline void hash_batch_scalar( uint64_t const * const keys, size_t const count, uint64_t * const out ) const noexcept {
+         for( size_t i = 0; i < count; ++i ) {
+            out[ i ] = operator()( keys[ i ] );
+         }
+      }
+#if defined( __AVX512F__ ) && defined( __AVX512DQ__ )
+      inline void hash_batch_avx512( uint64_t const * const keys, size_t const count, uint64_t * const out ) const noexcept {
+         size_t const full = count & ~( size_t ) 7;
+         for( size_t i = 0; i < full; i += 8 ) {
+            _mm512_storeu_si512( ( void * ) ( out + i ), operator()( _mm512_loadu_si512( ( void const * ) ( keys + i ) ) ) );
+         }
+         if( full < count ) {
+            __mmask8 const tail = ( __mmask8 ) ( ( 1U << ( count - full ) ) - 1 );
+            _mm512_mask_storeu_epi64( out + full, tail, operator()( _mm512_maskz_loadu_epi64( tail, keys + full ) ) );
+         }
+      }
+#endif
 };
 #endif //GENERAL_MURMUR3_H
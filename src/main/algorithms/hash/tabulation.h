@@ -0,0 +1,48 @@
+/**
+ * @file tabulation.h
+ * @brief Simple tabulation hashing.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_TABULATION_H
+#define GENERAL_TABULATION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <random>
+
+/**
+ * Splits the key into bytes and XORs one random table entry per byte (Patrascu / Thorup). Three-independent and
+ * robust for structured keys. The tables hold sizeof( T ) * 256 entries of T and are filled from a std::mt19937_64
+ * with the given seed, so two instances with the same seed hash identically. Every lookup is a load, the tables
+ * have to stay in L1.
+ */
+template< typename T >
+class tabulation {
+   private:
+      T tables[ sizeof( T ) ][ 256 ];
+   public:
+      typedef T hash_type;
+
+      tabulation( void ) : tabulation( 65536 ) { }
+      tabulation( uint64_t _seed ) {
+         std::mt19937_64 generator( _seed );
+         for( size_t byte = 0; byte < sizeof( T ); ++byte )
+            for( size_t value = 0; value < 256; ++value )
+               tables[ byte ][ value ] = ( T ) generator( );
+      }
+      inline T operator()( T const _key ) const noexcept {
+         T result = 0;
+         for( size_t byte = 0; byte < sizeof( T ); ++byte )
+            result ^= tables[ byte ][ ( _key >> ( 8 * byte ) ) & 0xff ];
+         return result;
+      }
+      inline void hash_batch( T const * const keys, size_t const count, T * const out ) const noexcept {
+         for( size_t i = 0; i < count; ++i ) {
+            out[ i ] = operator()( keys[ i ] );
+         }
+      }
+};
+
+#endif //GENERAL_TABULATION_H
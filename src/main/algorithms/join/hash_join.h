@@ -0,0 +1,140 @@
+/**
+ * @file hash_join.h
+ * @brief Equi hash join with the histogramm as build side.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_HASH_JOIN_H
+#define GENERAL_HASH_JOIN_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include "../../datastructures/set/hash_set.h"
+#include "../../../utils/vector.h"
+
+/**
+ * Hash join which materializes ( build_row, probe_row ) pairs of all matching rows.
+ * The build side is a const_sized_basic_histogramm built with build_vectorized_batch, which also reports the slot
+ * of every build row. Afterwards the row ids of the build column are stored contiguously per slot, ordered by slot:
+ * the exclusive prefix sum over the slot counts gives the begin of every list, so duplicate build keys need no
+ * chaining and the matches of a key are read sequentially. Only the end of every list is kept, its begin is the end
+ * minus the slot count.
+ * The probe side is processed in groups of PROBE_GROUP_SIZE keys: the slots of a group are looked up with
+ * probe_slots ( hash_batch over the group ) and the row id lists of the hits are prefetched, then the pairs of the
+ * group are written.
+ * Output buffers are preallocated by the caller. A probe call stops when the buffers are full and continues where it
+ * stopped on the next call with the same probe_cursor, so a key with more matches than the buffers can hold is split
+ * across calls.
+ */
+template< typename T, typename RowT = uint32_t, class SlotMapping = slot_mapping_modulo >
+class histogramm_hash_join {
+   public:
+      struct probe_cursor {
+         size_t probe_position = 0;
+         size_t match_position = 0;
+      };
+   private:
+      typedef const_sized_basic_histogramm< T, SlotMapping > histogramm_t;
+      static constexpr size_t PROBE_GROUP_SIZE = 16;
+
+      size_t         const BuildCount;
+      histogramm_t         histogramm;
+      size_t         const container_size;
+      size_t      *  const payload_end;
+      RowT        *  const build_rows;
+   public:
+      histogramm_hash_join( size_t _BuildCount, uint32_t _LoadFactor ):
+         BuildCount{ _BuildCount },
+         histogramm{ ( uint32_t ) _BuildCount, _LoadFactor },
+         container_size{ ( size_t ) histogramm.get_size( ) },
+         payload_end{ new size_t[ container_size ]( ) },
+         build_rows{ new RowT[ ( _BuildCount > 0 ) ? _BuildCount : 1 ] } {
+      }
+      virtual ~histogramm_hash_join( void ) noexcept {
+         delete[ ] build_rows;
+         delete[ ] payload_end;
+      }
+      histogramm_t const & get_histogramm( void ) const noexcept {
+         return histogramm;
+      }
+      void build( T const * const build_keys ) noexcept {
+         size_t * const build_slots = new size_t[ ( BuildCount > 0 ) ? BuildCount : 1 ];
+         histogramm.build_vectorized_batch( build_keys, build_slots );
+         uint64_t const * const counts = histogramm.get_key_count_container( );
+         size_t offset = 0;
+         for( size_t slot = 0; slot < container_size; ++slot ) {
+            payload_end[ slot ] = offset;
+            offset += ( size_t ) counts[ slot ];
+         }
+         /* scattering advances every begin to the end of its list */
+#pragma _NEC novector
+         for( size_t row = 0; row < BuildCount; ++row ) {
+            build_rows[ payload_end[ build_slots[ row ] ]++ ] = ( RowT ) row;
+         }
+         delete[ ] build_slots;
+      }
+      /* number of pairs a full probe of probe_keys emits, to size the output buffers */
+      size_t count_matches( T const * const probe_keys, size_t const probe_count ) const noexcept {
+         size_t result = 0;
+         for( size_t i = 0; i < probe_count; ++i ) {
+            result += ( size_t ) histogramm.probe_count_vectorized( probe_keys[ i ] );
+         }
+         return result;
+      }
+      /**
+       * Writes up to capacity pairs into out_build_rows / out_probe_rows and returns their number. The probe row is
+       * the position in probe_keys. The probe is complete when cursor.probe_position reaches probe_count, capacity
+       * has to be at least 1 or the cursor never advances.
+       */
+      size_t probe(  T const * const probe_keys, size_t const probe_count,
+                     RowT * const out_build_rows, RowT * const out_probe_rows, size_t const capacity,
+                     probe_cursor & cursor ) const noexcept {
+         assert( capacity > 0 );
+         uint64_t const * const counts = histogramm.get_key_count_container( );
+         size_t const infinity = ( size_t ) histogramm.get_size( ) + 1;
+         size_t slots[ PROBE_GROUP_SIZE ];
+         size_t written = 0;
+#pragma _NEC novector
+         while( cursor.probe_position < probe_count ) {
+            size_t const group_start = cursor.probe_position;
+            size_t const group_size =
+               ( probe_count - group_start < PROBE_GROUP_SIZE ) ? probe_count - group_start : PROBE_GROUP_SIZE;
+            histogramm.template probe_slots< PROBE_GROUP_SIZE >( probe_keys + group_start, group_size, slots );
+#pragma _NEC novector
+            for( size_t i = 0; i < group_size; ++i ) {
+               if( slots[ i ] < infinity )
+                  PREFETCH_READ_( &build_rows[ payload_end[ slots[ i ] ] - counts[ slots[ i ] ] ] );
+            }
+#pragma _NEC novector
+            for( size_t i = 0; i < group_size; ++i ) {
+               if( slots[ i ] >= infinity )
+                  continue;
+               size_t const end = payload_end[ slots[ i ] ];
+               size_t const begin = end - ( size_t ) counts[ slots[ i ] ];
+               size_t const available = capacity - written;
+               size_t const remaining = end - begin - cursor.match_position;
+               size_t const emit = ( remaining < available ) ? remaining : available;
+               RowT const probe_row = ( RowT ) ( group_start + i );
+               RowT const * const matches = build_rows + begin + cursor.match_position;
+               for( size_t m = 0; m < emit; ++m ) {
+                  out_build_rows[ written + m ] = matches[ m ];
+                  out_probe_rows[ written + m ] = probe_row;
+               }
+               written += emit;
+               if( emit < remaining ) {
+                  /* buffers are full, resume within the matches of this key */
+                  cursor.probe_position = group_start + i;
+                  cursor.match_position += emit;
+                  return written;
+               }
+               cursor.match_position = 0;
+            }
+            cursor.probe_position = group_start + group_size;
+         }
+         return written;
+      }
+};
+
+#endif //GENERAL_HASH_JOIN_H
@@ -0,0 +1,194 @@
+/**
+ * @file blocked_bloom_filter.h
+ * @brief Cache line blocked Bloom filter over the murmur3 hash of the histogramms.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_BLOCKED_BLOOM_FILTER_H
+#define GENERAL_BLOCKED_BLOOM_FILTER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include "../../algorithms/hash/murmur3.h"
+#include "slot_mapping.h"
+#include "../../../utils/vector.h"
+
+/**
+ * Bloom filter split into blocks of BLOCK_WORDS 32-bit words. A key sets exactly one bit in every word of a single
+ * block, so an insert or lookup touches one block. Blocks are aligned to their size and never cross a cache line.
+ * The block is chosen from the murmur3 hash with fastrange (the high bits of the hash), the bit within word i is
+ * given by the top five bits of hash * SALT[ i ] (multiply-shift with odd constants), so no further hash is computed.
+ * The same murmur3 hash addresses the slots of const_sized_basic_histogramm, so insert_hashes can take the hashes
+ * its batch build computes anyway and both are built from one pass over the keys.
+ * filter() writes the keys which may be contained in order. With AVX-512 (AVX2) it checks 16 (8) keys at once: the
+ * keys are hashed in registers and word i of all their blocks is fetched with one gather.
+ */
+template< typename T >
+class blocked_bloom_filter {
+   public:
+      static constexpr size_t BLOCK_WORDS = 8;
+      static constexpr size_t BLOCK_SIZE = BLOCK_WORDS * sizeof( uint32_t );
+   private:
+      static constexpr size_t BUILD_HASH_CHUNK = 256;
+      size_t                  const block_count;
+      slot_mapping_fastrange  const block_mapping;
+      uint8_t              *  const block_storage;
+      uint32_t             *  const blocks;
+      murmur3< T >            const hash_fn;
+
+      static uint32_t salt( size_t const word ) noexcept {
+         static uint32_t const salts[ BLOCK_WORDS ] = {
+            0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+         };
+         return salts[ word ];
+      }
+      static uint32_t * align_blocks( uint8_t * const storage ) noexcept {
+         return ( uint32_t * ) ( ( ( uintptr_t ) storage + BLOCK_SIZE - 1 ) & ~( ( uintptr_t ) BLOCK_SIZE - 1 ) );
+      }
+      static size_t blocks_for( size_t const _ElemCount, size_t const _BitsPerKey ) noexcept {
+         size_t const bits = _ElemCount * _BitsPerKey;
+         size_t const result = ( bits + BLOCK_SIZE * 8 - 1 ) / ( BLOCK_SIZE * 8 );
+         return ( result > 0 ) ? result : 1;
+      }
+      inline uint32_t * block_of( uint32_t const hash ) const noexcept {
+         return blocks + block_mapping( hash, 0 ) * BLOCK_WORDS;
+      }
+      size_t filter_scalar( T const * const keys, size_t const count, T * const candidates ) const noexcept {
+         size_t written = 0;
+#pragma _NEC novector
+         for( size_t i = 0; i < count; ++i ) {
+            candidates[ written ] = keys[ i ];
+            written += contains_hash( hash_fn( keys[ i ] ) ) ? 1 : 0;
+         }
+         return written;
+      }
+      /* SIMD kernels hash with murmur3< uint32_t >, wider keys use the scalar loop */
+      size_t filter_dispatch( T const * const keys, size_t const count, T * const candidates, std::false_type ) const noexcept {
+         return filter_scalar( keys, count, candidates );
+      }
+      size_t filter_dispatch( T const * const keys, size_t const count, T * const candidates, std::true_type ) const noexcept {
+#if defined( __AVX512F__ )
+         return filter_avx512( keys, count, candidates );
+#elif defined( __AVX2__ )
+         return filter_avx2( keys, count, candidates );
+#else
+         return filter_scalar( keys, count, candidates );
+#endif
+      }
+   public:
+      blocked_bloom_filter( size_t _ElemCount, size_t _BitsPerKey = 10 ):
+         block_count{ blocks_for( _ElemCount, _BitsPerKey ) },
+         block_mapping{ block_count },
+         block_storage{ new uint8_t[ block_count * BLOCK_SIZE + BLOCK_SIZE - 1 ]( ) },
+         blocks{ align_blocks( block_storage ) } {
+      }
+      virtual ~blocked_bloom_filter( void ) noexcept {
+         delete[ ] block_storage;
+      }
+      size_t get_block_count( void ) const noexcept {
+         return block_count;
+      }
+      size_t get_memory_footprint( void ) const noexcept {
+         return block_count * BLOCK_SIZE;
+      }
+      inline void insert_hash( uint32_t const hash ) noexcept {
+         uint32_t * const block = block_of( hash );
+         for( size_t word = 0; word < BLOCK_WORDS; ++word ) {
+            block[ word ] |= ( uint32_t ) 1 << ( ( hash * salt( word ) ) >> 27 );
+         }
+      }
+      inline bool contains_hash( uint32_t const hash ) const noexcept {
+         uint32_t const * const block = block_of( hash );
+         uint32_t missing = 0;
+         for( size_t word = 0; word < BLOCK_WORDS; ++word ) {
+            uint32_t const bit = ( uint32_t ) 1 << ( ( hash * salt( word ) ) >> 27 );
+            missing |= ~block[ word ] & bit;
+         }
+         return missing == 0;
+      }
+      void insert( T const key ) noexcept {
+         insert_hash( hash_fn( key ) );
+      }
+      bool contains( T const key ) const noexcept {
+         return contains_hash( hash_fn( key ) );
+      }
+      template< typename H >
+      void insert_hashes( H const * const hashes, size_t const count ) noexcept {
+#pragma _NEC novector
+         for( size_t i = 0; i < count; ++i ) {
+            insert_hash( ( uint32_t ) hashes[ i ] );
+         }
+      }
+      void build( T const * const keys, size_t const count ) noexcept {
+         typename murmur3< T >::hash_type hashes[ BUILD_HASH_CHUNK ];
+#pragma _NEC novector
+         for( size_t chunk_start = 0; chunk_start < count; chunk_start += BUILD_HASH_CHUNK ) {
+            size_t const chunk_size = ( count - chunk_start < BUILD_HASH_CHUNK ) ? count - chunk_start : BUILD_HASH_CHUNK;
+            hash_fn.hash_batch( keys + chunk_start, chunk_size, hashes );
+            insert_hashes( hashes, chunk_size );
+         }
+      }
+      /* writes all keys which pass the filter to candidates, keeps their order and returns their number */
+      size_t filter( T const * const keys, size_t const count, T * const candidates ) const noexcept {
+         return filter_dispatch( keys, count, candidates, std::integral_constant< bool, sizeof( T ) == sizeof( uint32_t ) >{ } );
+      }
+#ifdef __AVX512F__
+      size_t filter_avx512( T const * const keys, size_t const count, T * const candidates ) const noexcept {
+         __m512i const one_v = _mm512_set1_epi32( 1 );
+         size_t written = 0;
+         for( size_t i = 0; i < count; i += 16 ) {
+            __mmask16 const load_mask = ( count - i >= 16 ) ? ( __mmask16 ) 0xFFFF : ( __mmask16 ) ( ( 1U << ( count - i ) ) - 1 );
+            __m512i const keys_v = _mm512_maskz_loadu_epi32( load_mask, keys + i );
+            __m512i const hash_v = hash_fn( keys_v );
+            __m512i const word_base_v = _mm512_slli_epi32( block_mapping.base_avx512( hash_v ), 3 );
+            __mmask16 pass = load_mask;
+            for( size_t word = 0; ( word < BLOCK_WORDS ) && ( pass != 0 ); ++word ) {
+               __m512i const shift_v = _mm512_srli_epi32( _mm512_mullo_epi32( hash_v, _mm512_set1_epi32( ( int ) salt( word ) ) ), 27 );
+               __m512i const bit_v = _mm512_sllv_epi32( one_v, shift_v );
+               __m512i const words_v = _mm512_mask_i32gather_epi32(
+                  _mm512_setzero_si512( ), pass, _mm512_add_epi32( word_base_v, _mm512_set1_epi32( ( int ) word ) ), blocks, 4 );
+               pass = _mm512_mask_cmpeq_epi32_mask( pass, _mm512_and_si512( words_v, bit_v ), bit_v );
+            }
+            _mm512_mask_compressstoreu_epi32( candidates + written, pass, keys_v );
+            written += ( size_t ) __builtin_popcount( ( unsigned ) pass );
+         }
+         return written;
+      }
+#endif
+#ifdef __AVX2__
+      size_t filter_avx2( T const * const keys, size_t const count, T * const candidates ) const noexcept {
+         __m256i const one_v = _mm256_set1_epi32( 1 );
+         __m256i const block_count_v = _mm256_set1_epi32( ( int ) block_count );
+         size_t const full = count & ~( size_t ) 7;
+         size_t written = 0;
+         for( size_t i = 0; i < full; i += 8 ) {
+            __m256i const keys_v = _mm256_loadu_si256( ( __m256i const * ) ( keys + i ) );
+            __m256i const hash_v = hash_fn( keys_v );
+            /* fastrange: high half of hash * block_count, even and odd lanes separately */
+            __m256i const block_even_v = _mm256_srli_epi64( _mm256_mul_epu32( hash_v, block_count_v ), 32 );
+            __m256i const block_odd_v = _mm256_mul_epu32( _mm256_srli_epi64( hash_v, 32 ), block_count_v );
+            __m256i const word_base_v = _mm256_slli_epi32( _mm256_blend_epi32( block_even_v, block_odd_v, 0xAA ), 3 );
+            __m256i pass_v = _mm256_set1_epi32( -1 );
+            for( size_t word = 0; word < BLOCK_WORDS; ++word ) {
+               __m256i const shift_v = _mm256_srli_epi32( _mm256_mullo_epi32( hash_v, _mm256_set1_epi32( ( int ) salt( word ) ) ), 27 );
+               __m256i const bit_v = _mm256_sllv_epi32( one_v, shift_v );
+               __m256i const words_v = _mm256_mask_i32gather_epi32(
+                  _mm256_setzero_si256( ), ( int const * ) blocks, _mm256_add_epi32( word_base_v, _mm256_set1_epi32( ( int ) word ) ), pass_v, 4 );
+               pass_v = _mm256_and_si256( pass_v, _mm256_cmpeq_epi32( _mm256_and_si256( words_v, bit_v ), bit_v ) );
+               if( _mm256_testz_si256( pass_v, pass_v ) )
+                  break;
+            }
+            unsigned pass = ( unsigned ) _mm256_movemask_ps( _mm256_castsi256_ps( pass_v ) );
+            while( pass != 0 ) {
+               candidates[ written++ ] = keys[ i + __builtin_ctz( pass ) ];
+               pass &= pass - 1;
+            }
+         }
+         return written + filter_scalar( keys + full, count - full, candidates + written );
+      }
+#endif
+};
+
+#endif //GENERAL_BLOCKED_BLOOM_FILTER_H
@@ -0,0 +1,170 @@
+/**
+ * @file container_allocation.h
+ * @brief Allocation policies for the hash containers: plain new, or huge pages with NUMA placement and parallel first touch.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_CONTAINER_ALLOCATION_H
+#define GENERAL_CONTAINER_ALLOCATION_H
+
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+#include "../../../utils/vector.h"
+#include "../../../utils/threading.h"
+
+/**
+ * An allocation policy hands out zeroed containers of count elements and takes them back with the same count:
+ *    template< typename U > static U * allocate( size_t count );
+ *    template< typename U > static void deallocate( U * container, size_t count ) noexcept;
+ */
+
+/* value initialized new[ ], zeroes the container on the calling thread with the default page size */
+struct container_allocation_new {
+   template< typename U >
+   static U * allocate( size_t const count ) {
+      return new U[ count ]( );
+   }
+   template< typename U >
+   static void deallocate( U * const container, size_t const ) noexcept {
+      delete[ ] container;
+   }
+};
+
+enum class huge_pages {
+   none,          /* 4 KiB pages */
+   transparent,   /* madvise( MADV_HUGEPAGE ), works with THP in "madvise" or "always" mode */
+   reserved       /* MAP_HUGETLB from the reserved pool ( vm.nr_hugepages ), transparent if the pool is exhausted */
+};
+
+enum class numa_placement {
+   first_touch,   /* every page lands on the node of the thread which touches it first */
+   interleave,    /* pages round robin over all nodes, probes from any node see the same average distance */
+   local          /* all pages on the node of the allocating thread */
+};
+
+/**
+ * Anonymous mapping, which the kernel zeroes page by page when it is touched first. With ThreadCount > 1 the pages
+ * are touched by ThreadCount threads on disjoint ranges, so zeroing gigabytes runs in parallel and, with
+ * numa_placement::first_touch, the container is spread over the nodes of the CPUs the threads are pinned to.
+ * Containers smaller than a huge page come from new[ ], a mapping would waste most of a huge page on them.
+ * The placement is a hint: if mbind is not supported ( no NUMA kernel ) the default first touch policy applies.
+ */
+template< huge_pages HugePages = huge_pages::transparent, numa_placement Placement = numa_placement::first_touch,
+          size_t ThreadCount = MAX_THREAD_COUNT >
+struct container_allocation_mapped {
+   static_assert( ThreadCount > 0 && ThreadCount <= MAX_THREAD_COUNT, "ThreadCount has to be in [ 1, MAX_THREAD_COUNT ]" );
+   static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+   static constexpr size_t TOUCH_STRIDE = 4096;
+
+   struct touch_context {
+      char * begin;
+      size_t size;
+      size_t cpu;
+   };
+   static void * touch_pages( void * ctx_ ) {
+      touch_context * ctx = ( touch_context * ) ctx_;
+      cpu_set_t cpu_set;
+      CPU_ZERO( &cpu_set );
+      CPU_SET( ctx->cpu, &cpu_set );
+      /* posix_thread::set_cpu does not pin, but first touch needs the thread to stay on its node */
+      sched_setaffinity( 0, sizeof( cpu_set ), &cpu_set );
+      volatile char * const page = ctx->begin;
+#pragma _NEC novector
+      for( size_t offset = 0; offset < ctx->size; offset += TOUCH_STRIDE ) {
+         page[ offset ] = 0;
+      }
+      return ( void * ) nullptr;
+   }
+   static size_t mapping_size( size_t const bytes ) noexcept {
+      return ( bytes + HUGE_PAGE_SIZE - 1 ) & ~( HUGE_PAGE_SIZE - 1 );
+   }
+   static void place( void * const mapping, size_t const size ) noexcept {
+      if( Placement == numa_placement::first_touch )
+         return;
+      unsigned long nodes = ~0UL;
+      if( Placement == numa_placement::local ) {
+         /* MPOL_LOCAL would follow the touching threads, the node has to be fixed at allocation time */
+         unsigned cpu = 0, node = 0;
+         if( ( syscall( SYS_getcpu, &cpu, &node, nullptr ) != 0 ) || ( node >= sizeof( nodes ) * 8 ) )
+            return;
+         nodes = 1UL << node;
+      }
+      /* preferred instead of bind, a full node falls back to the others instead of failing the page fault */
+      syscall( SYS_mbind, mapping, size, ( Placement == numa_placement::interleave ) ? MPOL_INTERLEAVE : MPOL_PREFERRED,
+               &nodes, sizeof( nodes ) * 8, 0 );
+   }
+   static void touch( char * const mapping, size_t const size ) {
+      size_t const cpu_count = ( size_t ) sysconf( _SC_NPROCESSORS_ONLN );
+      posix_thread threads[ MAX_THREAD_COUNT ];
+      touch_context contexts[ MAX_THREAD_COUNT ];
+      /* whole huge pages per thread, so no huge page is split between two nodes */
+      size_t const chunk = ( size / HUGE_PAGE_SIZE + ThreadCount - 1 ) / ThreadCount * HUGE_PAGE_SIZE;
+      size_t used_threads = 0;
+      for( size_t t = 0; t < ThreadCount && t * chunk < size; ++t ) {
+         size_t const begin = t * chunk;
+         contexts[ t ] = { mapping + begin, ( begin + chunk < size ) ? chunk : size - begin, t * cpu_count / ThreadCount };
+         ++used_threads;
+      }
+      if( used_threads == 1 ) {
+         /* the allocating thread decides the node of a single threaded touch, it is not pinned */
+         volatile char * const page = mapping;
+#pragma _NEC novector
+         for( size_t offset = 0; offset < size; offset += TOUCH_STRIDE ) {
+            page[ offset ] = 0;
+         }
+         return;
+      }
+      for( size_t t = 0; t < used_threads; ++t ) {
+         pthread_create(   threads[ t ].get_thread_ptr( ),
+                           threads[ t ].get_attribute( ),
+                           &container_allocation_mapped::touch_pages,
+                           ( void * ) &contexts[ t ]
+         );
+      }
+      for( size_t t = 0; t < used_threads; ++t ) {
+         pthread_join( threads[ t ].get_thread( ), NULL );
+      }
+   }
+   template< typename U >
+   static U * allocate( size_t const count ) {
+      size_t const bytes = count * sizeof( U );
+      if( bytes < HUGE_PAGE_SIZE )
+         return new U[ count ]( );
+      size_t const size = mapping_size( bytes );
+      void * mapping = MAP_FAILED;
+      if( HugePages == huge_pages::reserved )
+         mapping = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+      if( mapping == MAP_FAILED ) {
+         mapping = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+         if( mapping == MAP_FAILED )
+            throw std::bad_alloc( );
+         if( HugePages != huge_pages::none )
+            madvise( mapping, size, MADV_HUGEPAGE );
+         else
+            madvise( mapping, size, MADV_NOHUGEPAGE );
+      }
+      place( mapping, size );
+      touch( ( char * ) mapping, size );
+      return ( U * ) mapping;
+   }
+   template< typename U >
+   static void deallocate( U * const container, size_t const count ) noexcept {
+      if( container == nullptr )
+         return;
+      size_t const bytes = count * sizeof( U );
+      if( bytes < HUGE_PAGE_SIZE )
+         delete[ ] container;
+      else
+         munmap( ( void * ) container, mapping_size( bytes ) );
+   }
+};
+
+#endif //GENERAL_CONTAINER_ALLOCATION_H
@@ -0,0 +1,267 @@
+/**
+ * @file count_min_sketch.h
+ * @brief Count-min and count sketch over seeded murmur3 hashes, approximate histogramm for inputs beyond the memory.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_COUNT_MIN_SKETCH_H
+#define GENERAL_COUNT_MIN_SKETCH_H
+
+#include <cstdint>
+#include <cstddef>
+#include <type_traits>
+#include "../../algorithms/hash/murmur3.h"
+#include "slot_mapping.h"
+#include "../../../utils/vector.h"
+
+/**
+ * Depth rows of Width counters. Row r hashes a key with murmur3 seeded by seed_of( r ) and maps the hash onto a
+ * column with fastrange. The count-min sketch ( Signed = false ) adds every key to its column in all rows,
+ * get_count( ) is the minimum over the rows, never below the exact count and above it by at most
+ * e * get_total_count( ) / Width with probability 1 - e^-Depth. The count sketch ( Signed = true ) adds +1 or -1
+ * depending on the lowest hash bit and returns the median of the signed counters, which is unbiased and bounded by
+ * the second moment of the counts instead of their sum, an odd Depth avoids averaging two middle rows.
+ * Memory is Width * Depth counters regardless of the number of distinct keys.
+ * build( ) works on chunks of 256 keys row by row, so the counters of one row stay in the cache while the chunk is
+ * hashed with hash_batch of that row's murmur3. With AVX-512 CD the counters of 32-bit keys are updated 16 lanes at a
+ * time: gather, add 1 + the increments of the preceding lanes with the same column ( vpconflictd ) and scatter, as
+ * scatters write from the lowest to the highest lane the last lane of a column stores the sum. The columns are used
+ * as signed 32-bit gather indices, so Width has to stay below 2^31.
+ * Sketches with the same Width and Depth are merged by adding their counters, e.g. per-thread sketches over chunks
+ * of a stream.
+ */
+template< typename T, bool Signed = false >
+class count_min_sketch {
+   public:
+      typedef typename murmur3< T >::hash_type hash_t;
+      typedef typename std::conditional< Signed, int64_t, uint64_t >::type counter_t;
+      static constexpr size_t MAX_DEPTH = 16;
+   private:
+      static constexpr size_t BUILD_HASH_CHUNK = 256;
+      size_t                  const width;
+      size_t                  const depth;
+      slot_mapping_fastrange  const column_mapping;
+      counter_t            *  const counters;
+      size_t                        total_count;
+
+      static size_t clamp_depth( size_t const _Depth ) noexcept {
+         return ( _Depth < 1 ) ? 1 : ( ( _Depth > MAX_DEPTH ) ? MAX_DEPTH : _Depth );
+      }
+      static inline hash_t seed_of( size_t const row ) noexcept {
+         return ( hash_t ) ( 0x9e3779b9U * ( uint32_t ) ( row + 1 ) );
+      }
+      static inline counter_t increment_of( hash_t const hash ) noexcept {
+         return Signed ? ( counter_t ) ( ( hash & 1 ) ? 1 : -1 ) : ( counter_t ) 1;
+      }
+      inline size_t column_of( hash_t const hash ) const noexcept {
+         return column_mapping( ( size_t ) hash, 0 );
+      }
+      inline counter_t * row_of( size_t const row ) const noexcept {
+         return counters + row * width;
+      }
+      /* count-min: minimum, count sketch: median of the signed row values ( destroys the order of values ) */
+      static counter_t combine( counter_t * const values, size_t const count ) noexcept {
+         if( !Signed ) {
+            counter_t result = values[ 0 ];
+            for( size_t row = 1; row < count; ++row ) {
+               result = ( values[ row ] < result ) ? values[ row ] : result;
+            }
+            return result;
+         }
+#pragma _NEC novector
+         for( size_t i = 1; i < count; ++i ) {
+            counter_t const value = values[ i ];
+            size_t position = i;
+            for( ; ( position > 0 ) && ( values[ position - 1 ] > value ); --position ) {
+               values[ position ] = values[ position - 1 ];
+            }
+            values[ position ] = value;
+         }
+         return ( count & 1 ) ? values[ count / 2 ] : ( values[ count / 2 - 1 ] + values[ count / 2 ] ) / 2;
+      }
+      void update_row_scalar( counter_t * const row, hash_t const * const hashes, size_t const count ) noexcept {
+#pragma _NEC novector
+         for( size_t i = 0; i < count; ++i ) {
+            row[ column_of( hashes[ i ] ) ] += increment_of( hashes[ i ] );
+         }
+      }
+#if defined( __AVX512F__ ) && defined( __AVX512CD__ )
+      void update_row_avx512( counter_t * const row, uint32_t const * const hashes, size_t const count ) noexcept {
+         __m512i const zero_v = _mm512_setzero_si512( );
+         __m512i const one_v = _mm512_set1_epi32( 1 );
+         /* distinct negative values per lane, never equal to a column, so tail lanes do not take part in conflicts */
+         __m512i const idle_v = _mm512_setr_epi32( -1, -2, -3, -4, -5, -6, -7, -8, -9, -10, -11, -12, -13, -14, -15, -16 );
+#pragma _NEC novector
+         for( size_t i = 0; i < count; i += 16 ) {
+            __mmask16 const active = ( count - i >= 16 ) ? ( __mmask16 ) 0xFFFF : ( __mmask16 ) ( ( 1U << ( count - i ) ) - 1 );
+            __m512i const hash_v = _mm512_maskz_loadu_epi32( active, hashes + i );
+            __m512i const columns_v = _mm512_mask_mov_epi32( idle_v, active, column_mapping.base_avx512( hash_v ) );
+            /* -1 for an even hash, +1 for an odd one */
+            __m512i const own_v = Signed ?
+               _mm512_sub_epi32( _mm512_slli_epi32( _mm512_and_si512( hash_v, one_v ), 1 ), one_v ) : one_v;
+            __m512i const conflicts_v = _mm512_conflict_epi32( columns_v );
+            __m512i increments_v = own_v;
+            if( _mm512_mask_test_epi32_mask( active, conflicts_v, conflicts_v ) != 0 ) {
+               alignas( 64 ) uint32_t conflicts[ 16 ];
+               alignas( 64 ) int32_t increments[ 16 ];
+               _mm512_store_si512( ( void * ) conflicts, conflicts_v );
+               _mm512_store_si512( ( void * ) increments, own_v );
+               uint32_t const positive = ( uint32_t ) _mm512_mask_cmpgt_epi32_mask( active, own_v, zero_v );
+               for( size_t lane = 0; lane < 16; ++lane ) {
+                  increments[ lane ] += Signed ?
+                     __builtin_popcount( conflicts[ lane ] & positive ) - __builtin_popcount( conflicts[ lane ] & ~positive ) :
+                     __builtin_popcount( conflicts[ lane ] );
+               }
+               increments_v = _mm512_load_si512( ( void const * ) increments );
+            }
+            __m256i const columns_lo_v = _mm512_castsi512_si256( columns_v );
+            __m256i const columns_hi_v = _mm512_extracti64x4_epi64( columns_v, 1 );
+            __mmask8 const active_lo = ( __mmask8 ) active;
+            __mmask8 const active_hi = ( __mmask8 ) ( active >> 8 );
+            __m512i counts_lo_v = _mm512_mask_i32gather_epi64( zero_v, active_lo, columns_lo_v, row, 8 );
+            __m512i counts_hi_v = _mm512_mask_i32gather_epi64( zero_v, active_hi, columns_hi_v, row, 8 );
+            counts_lo_v = _mm512_add_epi64( counts_lo_v, _mm512_cvtepi32_epi64( _mm512_castsi512_si256( increments_v ) ) );
+            counts_hi_v = _mm512_add_epi64( counts_hi_v, _mm512_cvtepi32_epi64( _mm512_extracti64x4_epi64( increments_v, 1 ) ) );
+            _mm512_mask_i32scatter_epi64( row, active_lo, columns_lo_v, counts_lo_v, 8 );
+            _mm512_mask_i32scatter_epi64( row, active_hi, columns_hi_v, counts_hi_v, 8 );
+         }
+      }
+#endif
+      /* SIMD kernels take the 32-bit hashes of murmur3< uint32_t >, wider keys use the scalar loop */
+      void update_row_dispatch( counter_t * const row, hash_t const * const hashes, size_t const count, std::false_type ) noexcept {
+         update_row_scalar( row, hashes, count );
+      }
+      void update_row_dispatch( counter_t * const row, hash_t const * const hashes, size_t const count, std::true_type ) noexcept {
+#if defined( __AVX512F__ ) && defined( __AVX512CD__ )
+         update_row_avx512( row, hashes, count );
+#else
+         update_row_scalar( row, hashes, count );
+#endif
+      }
+   public:
+      count_min_sketch( size_t _Width, size_t _Depth = 4 ):
+         width{ ( _Width > 0 ) ? _Width : 1 },
+         depth{ clamp_depth( _Depth ) },
+         column_mapping{ width },
+         counters{ new counter_t[ width * depth ]( ) },
+         total_count{ 0 } {
+      }
+      count_min_sketch( count_min_sketch const & ) = delete;
+      count_min_sketch & operator=( count_min_sketch const & ) = delete;
+      virtual ~count_min_sketch( void ) noexcept {
+         delete[ ] counters;
+      }
+      size_t get_width( void ) const noexcept {
+         return width;
+      }
+      size_t get_depth( void ) const noexcept {
+         return depth;
+      }
+      counter_t const * get_counters( void ) const noexcept {
+         return counters;
+      }
+      size_t get_memory_footprint( void ) const noexcept {
+         return width * depth * sizeof( counter_t );
+      }
+      /* number of keys added, the count-min error bound is e * get_total_count( ) / get_width( ) */
+      size_t get_total_count( void ) const noexcept {
+         return total_count;
+      }
+      void clear( void ) noexcept {
+         for( size_t position = 0; position < width * depth; ++position ) {
+            counters[ position ] = 0;
+         }
+         total_count = 0;
+      }
+      void insert( T const key ) noexcept {
+         murmur3< T > const hash_fn{ };
+         for( size_t row = 0; row < depth; ++row ) {
+            hash_t const hash = hash_fn( key, seed_of( row ) );
+            row_of( row )[ column_of( hash ) ] += increment_of( hash );
+         }
+         ++total_count;
+      }
+      void build_scalar( T const * const keys, size_t const count ) noexcept {
+#pragma _NEC novector
+         for( size_t i = 0; i < count; ++i ) {
+            insert( keys[ i ] );
+         }
+      }
+      /* adds keys to the sketch, may be called for any number of chunks */
+      void build( T const * const keys, size_t const count ) noexcept {
+         hash_t hashes[ BUILD_HASH_CHUNK ];
+#pragma _NEC novector
+         for( size_t chunk_start = 0; chunk_start < count; chunk_start += BUILD_HASH_CHUNK ) {
+            size_t const chunk_size = ( count - chunk_start < BUILD_HASH_CHUNK ) ? count - chunk_start : BUILD_HASH_CHUNK;
+            for( size_t row = 0; row < depth; ++row ) {
+               murmur3< T > const row_hash{ seed_of( row ) };
+               row_hash.hash_batch( keys + chunk_start, chunk_size, hashes );
+               update_row_dispatch( row_of( row ), hashes, chunk_size,
+                                    std::integral_constant< bool, sizeof( T ) == sizeof( uint32_t ) >{ } );
+            }
+         }
+         total_count += count;
+      }
+      counter_t get_count( T const key ) const noexcept {
+         murmur3< T > const hash_fn{ };
+         counter_t values[ MAX_DEPTH ] = { };
+         for( size_t row = 0; row < depth; ++row ) {
+            hash_t const hash = hash_fn( key, seed_of( row ) );
+            values[ row ] = row_of( row )[ column_of( hash ) ] * increment_of( hash );
+         }
+         return combine( values, depth );
+      }
+      /* get_count of count keys, hashed row by row in chunks like build( ) */
+      void get_counts( T const * const keys, size_t const count, counter_t * const result_counts ) const noexcept {
+         hash_t hashes[ BUILD_HASH_CHUNK ];
+         counter_t values[ BUILD_HASH_CHUNK ][ MAX_DEPTH ];
+#pragma _NEC novector
+         for( size_t chunk_start = 0; chunk_start < count; chunk_start += BUILD_HASH_CHUNK ) {
+            size_t const chunk_size = ( count - chunk_start < BUILD_HASH_CHUNK ) ? count - chunk_start : BUILD_HASH_CHUNK;
+            for( size_t row = 0; row < depth; ++row ) {
+               murmur3< T > const row_hash{ seed_of( row ) };
+               row_hash.hash_batch( keys + chunk_start, chunk_size, hashes );
+               counter_t const * const counters_row = row_of( row );
+               for( size_t i = 0; i < chunk_size; ++i ) {
+                  values[ i ][ row ] = counters_row[ column_of( hashes[ i ] ) ] * increment_of( hashes[ i ] );
+               }
+            }
+            for( size_t i = 0; i < chunk_size; ++i ) {
+               result_counts[ chunk_start + i ] = combine( values[ i ], depth );
+            }
+         }
+      }
+      /* adds the counters of other, returns false ( and leaves this sketch untouched ) if the dimensions differ */
+      bool merge( count_min_sketch const & other ) noexcept {
+         if( ( other.width != width ) || ( other.depth != depth ) )
+            return false;
+         size_t const size = width * depth;
+         size_t position = 0;
+#if defined( __AVX512F__ )
+#pragma _NEC novector
+         for( ; position + 8 <= size; position += 8 ) {
+            _mm512_storeu_si512( ( void * ) ( counters + position ), _mm512_add_epi64(
+               _mm512_loadu_si512( ( void const * ) ( counters + position ) ),
+               _mm512_loadu_si512( ( void const * ) ( other.counters + position ) ) ) );
+         }
+#elif defined( __AVX2__ )
+#pragma _NEC novector
+         for( ; position + 4 <= size; position += 4 ) {
+            _mm256_storeu_si256( ( __m256i * ) ( counters + position ), _mm256_add_epi64(
+               _mm256_loadu_si256( ( __m256i const * ) ( counters + position ) ),
+               _mm256_loadu_si256( ( __m256i const * ) ( other.counters + position ) ) ) );
+         }
+#endif
+         for( ; position < size; ++position ) {
+            counters[ position ] += other.counters[ position ];
+         }
+         total_count += other.total_count;
+         return true;
+      }
+};
+
+template< typename T >
+using count_sketch = count_min_sketch< T, true >;
+
+#endif //GENERAL_COUNT_MIN_SKETCH_H
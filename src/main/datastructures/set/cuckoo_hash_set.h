@@ -0,0 +1,304 @@
+/**
+ * @file cuckoo_hash_set.h
+ * @brief Histogram on a bucketized cuckoo hash table.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_CUCKOO_HASH_SET_H
+#define GENERAL_CUCKOO_HASH_SET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "../../algorithms/hash/murmur3.h"
+#include "slot_mapping.h"
+#include "../../../utils/vector.h"
+#if defined( __AVX2__ ) || defined( __SSE2__ )
+#   include <immintrin.h>
+#endif
+
+/**
+ * Histogram on a cuckoo hash table with Ways slots per bucket. Every key has two candidate buckets, taken from two
+ * murmur3 hashes with different seeds, and lives in one of them. A bucket holds its keys followed by their counters,
+ * for 32-bit keys and Ways = 8 this is exactly one cache line, so a lookup touches at most two cache lines.
+ * An insert into two full buckets evicts a random key of the first one and moves it to its alternate bucket, and so
+ * on for at most MAX_KICKS evictions. A key which is still homeless afterwards goes to a small stash, which is only
+ * scanned while it is not empty.
+ * The build_vectorized_* variants compare all keys of a bucket at once with SIMD instructions (AVX2 for 8 ways,
+ * SSE2 for 4 ways of 32-bit keys), the build_scalar_* variants compare slot by slot. The batch builds hash and
+ * prefetch the candidate buckets of BATCH_SIZE keys before inserting them.
+ * Counters are 32 bit, as ElementCount is at most 2^32 - 1 no counter can overflow.
+ */
+template< typename T, size_t Ways = 8, class SlotMapping = slot_mapping_modulo >
+class cuckoo_basic_histogramm {
+   private:
+      static constexpr size_t CACHE_LINE_SIZE = 64;
+      static constexpr size_t BATCH_SIZE = 256;
+      static constexpr size_t MAX_KICKS = 500;
+      static constexpr uint32_t ALTERNATE_SEED = 0x5bd1e995;
+
+      struct bucket {
+         T           keys[ Ways ];
+         uint32_t    counts[ Ways ];
+      };
+      static_assert( Ways > 0 && Ways <= 32, "The slots of a bucket are addressed by a 32-bit match mask." );
+
+      T           const ElementCount;
+      T           const LoadFactor;
+      SlotMapping const bucket_mapping;
+      size_t      const bucket_count;
+      size_t      const container_size;
+      size_t      const container_infinity_value;
+      size_t            container_distinct_count;
+      uint8_t  *  const bucket_storage;
+      bucket   *  const buckets;
+      std::vector< std::pair< T, uint32_t > > stash;
+      uint32_t          kick_state;
+      murmur3< T > const     hash_fn;
+      murmur3< T > const     alternate_hash_fn;
+
+      static bucket * align_buckets( uint8_t * const storage ) noexcept {
+         return ( bucket * ) ( ( ( uintptr_t ) storage + CACHE_LINE_SIZE - 1 ) & ~( ( uintptr_t ) CACHE_LINE_SIZE - 1 ) );
+      }
+      inline size_t first_bucket( T const key ) const noexcept {
+         return bucket_mapping( hash_fn( key ), 0 );
+      }
+      inline size_t second_bucket( T const key ) const noexcept {
+         return bucket_mapping( alternate_hash_fn( key ), 0 );
+      }
+      /* bit i is set if slot i of the bucket holds key */
+      template< bool Simd >
+      static inline uint32_t match( T const * const bucket_keys, T const key ) noexcept {
+#ifdef __AVX2__
+         if( Simd && sizeof( T ) == 4 && Ways == 8 ) {
+            __m256i const keys_v = _mm256_loadu_si256( ( __m256i const * ) bucket_keys );
+            __m256i const key_v = _mm256_set1_epi32( ( int ) key );
+            return ( uint32_t ) _mm256_movemask_ps( _mm256_castsi256_ps( _mm256_cmpeq_epi32( keys_v, key_v ) ) );
+         }
+#endif
+#ifdef __SSE2__
+         if( Simd && sizeof( T ) == 4 && Ways == 4 ) {
+            __m128i const keys_v = _mm_loadu_si128( ( __m128i const * ) bucket_keys );
+            __m128i const key_v = _mm_set1_epi32( ( int ) key );
+            return ( uint32_t ) _mm_movemask_ps( _mm_castsi128_ps( _mm_cmpeq_epi32( keys_v, key_v ) ) );
+         }
+#endif
+         uint32_t result = 0;
+         if( Simd ) {
+            for( size_t i = 0; i < Ways; ++i ) {
+               result |= ( uint32_t ) ( bucket_keys[ i ] == key ) << i;
+            }
+         } else {
+#pragma _NEC novector
+            for( size_t i = 0; i < Ways; ++i ) {
+               if( bucket_keys[ i ] == key )
+                  return ( uint32_t ) 1 << i;
+            }
+         }
+         return result;
+      }
+      /* returns the counter of key or nullptr */
+      template< bool Simd >
+      inline uint32_t * find( T const key, size_t const first, size_t const second ) const noexcept {
+         uint32_t mask = match< Simd >( buckets[ first ].keys, key );
+         if( mask != 0 )
+            return &buckets[ first ].counts[ __builtin_ctz( mask ) ];
+         mask = match< Simd >( buckets[ second ].keys, key );
+         if( mask != 0 )
+            return &buckets[ second ].counts[ __builtin_ctz( mask ) ];
+         if( !stash.empty( ) ) {
+#pragma _NEC novector
+            for( size_t i = 0; i < stash.size( ); ++i ) {
+               if( stash[ i ].first == key )
+                  return const_cast< uint32_t * >( &stash[ i ].second );
+            }
+         }
+         return nullptr;
+      }
+      template< bool Simd >
+      inline bool place( size_t const bucket_idx, T const key, uint32_t const count ) noexcept {
+         uint32_t const empty = match< Simd >( buckets[ bucket_idx ].keys, 0 );
+         if( empty == 0 )
+            return false;
+         size_t const slot = __builtin_ctz( empty );
+         buckets[ bucket_idx ].keys[ slot ] = key;
+         buckets[ bucket_idx ].counts[ slot ] = count;
+         return true;
+      }
+      template< bool Simd >
+      void insert( T const key, size_t const first, size_t const second ) {
+         uint32_t * const count = find< Simd >( key, first, second );
+         if( count != nullptr ) {
+            ++( *count );
+            return;
+         }
+         ++container_distinct_count;
+         if( place< Simd >( first, key, 1 ) || place< Simd >( second, key, 1 ) )
+            return;
+         T homeless_key = key;
+         uint32_t homeless_count = 1;
+         size_t bucket_idx = first;
+#pragma _NEC novector
+         for( size_t kick = 0; kick < MAX_KICKS; ++kick ) {
+            /* xorshift32, picks the victim slot */
+            kick_state ^= kick_state << 13;
+            kick_state ^= kick_state >> 17;
+            kick_state ^= kick_state << 5;
+            size_t const victim = kick_state % Ways;
+            std::swap( homeless_key, buckets[ bucket_idx ].keys[ victim ] );
+            std::swap( homeless_count, buckets[ bucket_idx ].counts[ victim ] );
+            size_t const victim_first = first_bucket( homeless_key );
+            bucket_idx = ( victim_first != bucket_idx ) ? victim_first : second_bucket( homeless_key );
+            if( place< Simd >( bucket_idx, homeless_key, homeless_count ) )
+               return;
+         }
+         stash.emplace_back( homeless_key, homeless_count );
+      }
+      template< bool Simd >
+      void build_elem( T const * const keys ) {
+#pragma _NEC novector
+         for( size_t keys_position = 0; keys_position < ElementCount; ++keys_position ) {
+            T const key = keys[ keys_position ];
+            insert< Simd >( key, first_bucket( key ), second_bucket( key ) );
+         }
+      }
+      template< bool Simd >
+      void build_batch( T const * const keys ) {
+         size_t first[ BATCH_SIZE ];
+         size_t second[ BATCH_SIZE ];
+         typename murmur3< T >::hash_type first_hashes[ BATCH_SIZE ];
+         typename murmur3< T >::hash_type second_hashes[ BATCH_SIZE ];
+#pragma _NEC novector
+         for( size_t batch_start = 0; batch_start < ElementCount; batch_start += BATCH_SIZE ) {
+            size_t const batch_size = ( ElementCount - batch_start < BATCH_SIZE ) ? ElementCount - batch_start : BATCH_SIZE;
+            T const * const batch_keys = keys + batch_start;
+            if( Simd ) {
+               hash_fn.hash_batch( batch_keys, batch_size, first_hashes );
+               alternate_hash_fn.hash_batch( batch_keys, batch_size, second_hashes );
+               for( size_t i = 0; i < batch_size; ++i ) {
+                  first[ i ] = bucket_mapping( first_hashes[ i ], 0 );
+                  second[ i ] = bucket_mapping( second_hashes[ i ], 0 );
+               }
+            } else {
+#pragma _NEC novector
+               for( size_t i = 0; i < batch_size; ++i ) {
+                  first[ i ] = first_bucket( batch_keys[ i ] );
+                  second[ i ] = second_bucket( batch_keys[ i ] );
+               }
+            }
+#pragma _NEC novector
+            for( size_t i = 0; i < batch_size; ++i ) {
+               PREFETCH_READ_( &buckets[ first[ i ] ] );
+               PREFETCH_READ_( &buckets[ second[ i ] ] );
+            }
+#pragma _NEC novector
+            for( size_t i = 0; i < batch_size; ++i ) {
+               insert< Simd >( batch_keys[ i ], first[ i ], second[ i ] );
+            }
+         }
+      }
+   public:
+      cuckoo_basic_histogramm( uint32_t _ElemCount, uint32_t _LoadFactor ):
+         ElementCount{ _ElemCount },
+         LoadFactor{ _LoadFactor },
+         bucket_mapping{ ( ( size_t ) ElementCount * 100 / LoadFactor + Ways - 1 ) / Ways },
+         bucket_count{ bucket_mapping.get_size( ) },
+         container_size{ bucket_count * Ways },
+         container_infinity_value{ std::numeric_limits< size_t >::max( ) },
+         container_distinct_count{ 0 },
+         bucket_storage{ new uint8_t[ bucket_count * sizeof( bucket ) + CACHE_LINE_SIZE - 1 ]( ) },
+         buckets{ align_buckets( bucket_storage ) },
+         kick_state{ 2463534242u },
+         hash_fn{ },
+         alternate_hash_fn{ ALTERNATE_SEED } {
+      }
+      virtual ~cuckoo_basic_histogramm( void ) noexcept {
+         delete[ ] bucket_storage;
+      }
+      size_t get_size( void ) const noexcept {
+         return container_size;
+      }
+      size_t get_stash_size( void ) const noexcept {
+         return stash.size( );
+      }
+      size_t get_count( void ) const noexcept {
+         size_t result = 0;
+         for( size_t bucket_idx = 0; bucket_idx < bucket_count; ++bucket_idx ) {
+            for( size_t slot = 0; slot < Ways; ++slot ) {
+               result += ( size_t ) buckets[ bucket_idx ].counts[ slot ];
+            }
+         }
+         for( size_t i = 0; i < stash.size( ); ++i ) {
+            result += ( size_t ) stash[ i ].second;
+         }
+         return result;
+      }
+      size_t key_count( void ) const noexcept {
+         size_t result = stash.size( );
+         for( size_t bucket_idx = 0; bucket_idx < bucket_count; ++bucket_idx ) {
+            for( size_t slot = 0; slot < Ways; ++slot ) {
+               if( buckets[ bucket_idx ].keys[ slot ] != 0 )
+                  ++result;
+            }
+         }
+         return result;
+      }
+      void build_scalar_elem( T const * const keys ) {
+         build_elem< false >( keys );
+      }
+      void build_vectorized_elem( T const * const keys ) {
+         build_elem< true >( keys );
+      }
+      void build_scalar_batch( T const * const keys ) {
+         build_batch< false >( keys );
+      }
+      void build_vectorized_batch( T const * const keys ) {
+         build_batch< true >( keys );
+      }
+      /* slot of key as bucket * Ways + way, container_size + i for the i-th stash entry */
+      size_t probe( T key ) const noexcept {
+         size_t const first = first_bucket( key );
+         uint32_t mask = match< false >( buckets[ first ].keys, key );
+         if( mask != 0 )
+            return first * Ways + __builtin_ctz( mask );
+         size_t const second = second_bucket( key );
+         mask = match< false >( buckets[ second ].keys, key );
+         if( mask != 0 )
+            return second * Ways + __builtin_ctz( mask );
+         for( size_t i = 0; i < stash.size( ); ++i ) {
+            if( stash[ i ].first == key )
+               return container_size + i;
+         }
+         return container_infinity_value;
+      }
+      uint64_t probe_count_vectorized( T key ) const noexcept {
+         uint32_t const * const count = find< true >( key, first_bucket( key ), second_bucket( key ) );
+         return ( count != nullptr ) ? *count : 0;
+      }
+      size_t get_count( T key ) const noexcept {
+         size_t const position = probe( key );
+         if( position == container_infinity_value )
+            return 0;
+         if( position >= container_size )
+            return stash[ position - container_size ].second;
+         return buckets[ position / Ways ].counts[ position % Ways ];
+      }
+      size_t probe(  T const * const probe_keys, size_t const probe_keys_count,
+                     T * const probe_result, T * const probe_result_count ) const noexcept {
+         size_t result_position = 0;
+         for( size_t probe_key_position = 0; probe_key_position < probe_keys_count; ++probe_key_position ) {
+            T const key = probe_keys[ probe_key_position ];
+            uint32_t const * const count = find< true >( key, first_bucket( key ), second_bucket( key ) );
+            if( count != nullptr ) {
+               probe_result[ result_position ] = key;
+               probe_result_count[ result_position++ ] = *count;
+            }
+         }
+         return result_position;
+      }
+};
+
+#endif //GENERAL_CUCKOO_HASH_SET_H
@@ -0,0 +1,86 @@
+/**
+ * @file filtered_hash_set.h
+ * @brief Histogram with a blocked Bloom filter in front of its probes.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_FILTERED_HASH_SET_H
+#define GENERAL_FILTERED_HASH_SET_H
+
+#include <cstdint>
+#include <cstddef>
+#include "hash_set.h"
+#include "blocked_bloom_filter.h"
+
+/**
+ * const_sized_basic_histogramm together with a blocked_bloom_filter over the same keys. The filter is a few bits per
+ * key and stays cache resident while the histogramm does not, so absent probe keys are mostly rejected without
+ * touching the histogramm. The array probe filters FILTER_CHUNK keys with the SIMD filter kernel and probes only the
+ * remaining candidates with probe_grouped. Pays off when most probe keys are absent.
+ */
+template< typename T, class SlotMapping = slot_mapping_modulo >
+class bloom_filtered_histogramm {
+   private:
+      typedef const_sized_basic_histogramm< T, SlotMapping > histogramm_t;
+      static constexpr size_t FILTER_CHUNK = 1024;
+
+      T              const ElementCount;
+      histogramm_t         histogramm;
+      blocked_bloom_filter< T > bloom_filter;
+
+      /* passes the hashes of the histogramm build on to the filter, both use the default murmur3 */
+      struct filter_sink {
+         blocked_bloom_filter< T > * filter;
+         template< typename H >
+         void operator()( H const * const hashes, size_t const count ) const noexcept {
+            filter->insert_hashes( hashes, count );
+         }
+      };
+   public:
+      bloom_filtered_histogramm( uint32_t _ElemCount, uint32_t _LoadFactor, size_t _BitsPerKey = 10 ):
+         ElementCount{ _ElemCount },
+         histogramm{ _ElemCount, _LoadFactor },
+         bloom_filter{ _ElemCount, _BitsPerKey } {
+      }
+      virtual ~bloom_filtered_histogramm( void ) noexcept { }
+      histogramm_t const & get_histogramm( void ) const noexcept {
+         return histogramm;
+      }
+      blocked_bloom_filter< T > const & get_filter( void ) const noexcept {
+         return bloom_filter;
+      }
+      T get_size( void ) const noexcept {
+         return histogramm.get_size( );
+      }
+      size_t key_count( void ) const noexcept {
+         return histogramm.key_count( );
+      }
+      void build_vectorized_batch( T const * const keys ) noexcept {
+         histogramm.build_vectorized_batch( keys, nullptr, filter_sink{ &bloom_filter } );
+      }
+      uint64_t probe_count_vectorized( T key ) const noexcept {
+         if( !bloom_filter.contains( key ) )
+            return 0;
+         return histogramm.probe_count_vectorized( key );
+      }
+      size_t get_count( T key ) const noexcept {
+         return ( size_t ) probe_count_vectorized( key );
+      }
+      size_t probe(  T const * const probe_keys, size_t const probe_keys_count,
+                     T * const probe_result, T * const probe_result_count ) const noexcept {
+         T candidates[ FILTER_CHUNK ];
+         size_t result_position = 0;
+#pragma _NEC novector
+         for( size_t chunk_start = 0; chunk_start < probe_keys_count; chunk_start += FILTER_CHUNK ) {
+            size_t const chunk_size =
+               ( probe_keys_count - chunk_start < FILTER_CHUNK ) ? probe_keys_count - chunk_start : FILTER_CHUNK;
+            size_t const candidate_count = bloom_filter.filter( probe_keys + chunk_start, chunk_size, candidates );
+            result_position += histogramm.probe_grouped(
+               candidates, candidate_count, probe_result + result_position, probe_result_count + result_position );
+         }
+         return result_position;
+      }
+};
+
+#endif //GENERAL_FILTERED_HASH_SET_H
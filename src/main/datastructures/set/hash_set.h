@@ -8,38 +8,429 @@
 #ifndef GENERAL_HASH_SET_H
 #define GENERAL_HASH_SET_H
 
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
 #include "../../algorithms/hash/murmur3.h"
+#include "slot_mapping.h"
+#include "container_allocation.h"
 #include "../../../utils/vector.h"
 
-template< typename T >
+/* Probe length and collision statistics are only compiled in with -DHASH_SET_STATISTICS, see histogramm_statistics. */
+#ifdef HASH_SET_STATISTICS
+#   define HISTOGRAMM_STATISTICS_( ... ) __VA_ARGS__
+#else
+#   define HISTOGRAMM_STATISTICS_( ... )
+#endif
+
+/**
+ * Counters of const_sized_basic_histogramm with HASH_SET_STATISTICS. A probe length is the offset from the home slot
+ * of the slot which ended the probing sequence: the slot of the key, or for a missing key the empty slot. Lengths of
+ * PROBE_LENGTH_BUCKETS - 1 and more share the last bucket.
+ *    insert_probe_lengths  one entry per inserted key occurrence, by every build, consume and merge,
+ *    lookup_probe_lengths  one entry per key looked up by the probe variants and get_count( key ),
+ *    occupied_slots        slots holding a key, tombstones included. Kept up to date by every insert, so it
+ *                          replaces the scan of key_count( ) as long as no keys are removed,
+ *    batch_lane_retries    rounds in which a lane of a batch build ( build_*_batch, consume, build_avx512 ) did not
+ *                          place its key and has to probe again.
+ * The counters are not synchronized, except for the concurrent builds, and probes from several threads race on them.
+ */
+struct histogramm_statistics {
+   static constexpr size_t PROBE_LENGTH_BUCKETS = 64;
+
+   uint64_t insert_probe_lengths[ PROBE_LENGTH_BUCKETS ];
+   uint64_t lookup_probe_lengths[ PROBE_LENGTH_BUCKETS ];
+   uint64_t occupied_slots;
+   uint64_t batch_lane_retries;
+
+   static size_t bucket( size_t const probe_length ) noexcept {
+      return ( probe_length < PROBE_LENGTH_BUCKETS - 1 ) ? probe_length : PROBE_LENGTH_BUCKETS - 1;
+   }
+   static uint64_t total( uint64_t const * const lengths ) noexcept {
+      uint64_t result = 0;
+      for( size_t i = 0; i < PROBE_LENGTH_BUCKETS; ++i ) {
+         result += lengths[ i ];
+      }
+      return result;
+   }
+   static double mean( uint64_t const * const lengths ) noexcept {
+      uint64_t const count = total( lengths );
+      uint64_t sum = 0;
+      for( size_t i = 0; i < PROBE_LENGTH_BUCKETS; ++i ) {
+         sum += lengths[ i ] * i;
+      }
+      return ( count == 0 ) ? 0.0 : ( double ) sum / ( double ) count;
+   }
+   /* smallest probe length which is not exceeded by permille / 1000 of the entries, 1000 gives the maximum */
+   static size_t percentile( uint64_t const * const lengths, size_t const permille ) noexcept {
+      uint64_t const count = total( lengths );
+      uint64_t seen = 0;
+      for( size_t i = 0; i < PROBE_LENGTH_BUCKETS; ++i ) {
+         seen += lengths[ i ];
+         if( ( seen != 0 ) && ( seen * 1000 >= count * permille ) )
+            return i;
+      }
+      return 0;
+   }
+   void record_insert( size_t const probe_length ) noexcept {
+      insert_probe_lengths[ bucket( probe_length ) ]++;
+   }
+   void record_lookup( size_t const probe_length ) noexcept {
+      lookup_probe_lengths[ bucket( probe_length ) ]++;
+   }
+   /* keeps occupied_slots, which describes the containers and not the operations on them */
+   void clear( void ) noexcept {
+      for( size_t i = 0; i < PROBE_LENGTH_BUCKETS; ++i ) {
+         insert_probe_lengths[ i ] = 0;
+         lookup_probe_lengths[ i ] = 0;
+      }
+      batch_lane_retries = 0;
+   }
+};
+
+/* hash sink of the batch builds which drops the hashes */
+struct no_hash_sink {
+   template< typename H >
+   void operator()( H const * const, size_t const ) const noexcept { }
+};
+
+/**
+ * Fixed size linear probing histogramm. HashFunction maps a key onto the hash passed to SlotMapping, every policy of
+ * main/algorithms/hash (murmur3, multiply_shift, crc32c, tabulation) fits. build_avx2 / build_avx512 additionally
+ * need the SIMD overloads of murmur3. Allocation provides the zeroed containers, see container_allocation.h; at blob
+ * sizes container_allocation_mapped cuts TLB misses with huge pages and zeroes the containers in parallel.
+ */
+template< typename T, class SlotMapping = slot_mapping_modulo, class HashFunction = murmur3< T >,
+          class Allocation = container_allocation_new >
 class const_sized_basic_histogramm {
    private:
+      typedef typename HashFunction::hash_type hash_t;
+
       T           const ElementCount;
       T           const LoadFactor;
+      SlotMapping const slot_mapping;
       T           const container_size;
       T           const container_infinity_value;
       size_t            container_distinct_count;
+      size_t            tombstone_count;
+      size_t            compaction_threshold;
       T        *  const key_container;
       uint64_t *  const key_count_container;
-      murmur3< T > const     hash_fn;
+      bool        const owns_containers;
+      HashFunction const     hash_fn;
+
+      /* lanes of a streaming build between two chunks, they hold their key by value as chunks are not kept alive */
+      struct stream_lanes {
+         T      keys[ 256 ];
+         hash_t hashes[ 256 ];
+         size_t offsets[ 256 ];
+         bool   active[ 256 ];
+         size_t active_count;
+      };
+      stream_lanes *    stream;
+#ifdef HASH_SET_STATISTICS
+      /* mutable, as the lookups which record into it are const */
+      mutable histogramm_statistics statistics;
+#endif
+
+      static constexpr size_t CONCURRENT_DELTA_CACHE_SIZE = 64;
+      static constexpr size_t HASH_WINDOW = 512;
+      static constexpr size_t MERGE_BLOCK = 1024;
+
+      /**
+       * The batch builds hash every key once with hash_batch, HASH_WINDOW keys ahead of the lanes. Lanes take keys in
+       * increasing order, so the hashes of the next refills are always in the window: window[ j ] is the hash of
+       * keys[ window_start + j ]. Lanes keep the hash of their key, probing steps only add the offset.
+       * Every freshly hashed range is handed to hash_sink( hashes, count ), over all calls in key order.
+       */
+      template< class HashSink >
+      void init_hash_window( T const * const keys, size_t const key_count, hash_t * const window,
+                             HashSink const & hash_sink ) const noexcept {
+         size_t const count = ( key_count < HASH_WINDOW ) ? key_count : HASH_WINDOW;
+         hash_fn.hash_batch( keys, count, window );
+         hash_sink( window, count );
+         for( size_t i = count; i < HASH_WINDOW; ++i ) {
+            window[ i ] = 0;
+         }
+      }
+      /* moves the window to next_position when the next 256 refills could leave it */
+      template< class HashSink >
+      void advance_hash_window( T const * const keys, size_t const key_count, hash_t * const window, size_t & window_start,
+                                size_t const next_position, HashSink const & hash_sink ) const noexcept {
+         if( next_position + 256 <= window_start + HASH_WINDOW )
+            return;
+         size_t const kept = window_start + HASH_WINDOW - next_position;
+#pragma _NEC novector
+         for( size_t i = 0; i < kept; ++i ) {
+            window[ i ] = window[ next_position - window_start + i ];
+         }
+         size_t const end = std::min( next_position + HASH_WINDOW, key_count );
+         if( next_position + kept < end ) {
+            hash_fn.hash_batch( keys + next_position + kept, end - next_position - kept, window + kept );
+            hash_sink( window + kept, end - next_position - kept );
+         }
+         window_start = next_position;
+      }
+
+      /* Claims an empty slot with a CAS on key_container and adds delta atomically to the count of key. */
+      void insert_concurrent( T const key, T const hashed_position, uint64_t const delta ) noexcept {
+#pragma _NEC novector
+         for( T offset = 0; offset < container_size; ++offset ) {
+            size_t const idx = slot_mapping( hashed_position, offset );
+            T loaded_key = __atomic_load_n( &key_container[ idx ], __ATOMIC_ACQUIRE );
+            if( loaded_key == 0 ) {
+               if( __atomic_compare_exchange_n( &key_container[ idx ], &loaded_key, key, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE ) ) {
+                  __atomic_fetch_add( &container_distinct_count, 1, __ATOMIC_RELAXED );
+                  __atomic_fetch_add( &tombstone_count, 1, __ATOMIC_RELAXED );
+                  HISTOGRAMM_STATISTICS_( __atomic_fetch_add( &statistics.occupied_slots, 1, __ATOMIC_RELAXED ); )
+                  loaded_key = key;
+               }
+            }
+            if( loaded_key == key ) {
+               if( __atomic_fetch_add( &key_count_container[ idx ], delta, __ATOMIC_RELAXED ) == 0 )
+                  __atomic_fetch_sub( &tombstone_count, 1, __ATOMIC_RELAXED );
+               HISTOGRAMM_STATISTICS_(
+                  __atomic_fetch_add( &statistics.insert_probe_lengths[ histogramm_statistics::bucket( offset ) ], 1, __ATOMIC_RELAXED ); )
+               return;
+            }
+         }
+      }
+      /* Scalar linear probing for key starting at offset, used by the SIMD builds for lanes they can not resolve. */
+      void insert_from_offset( T const key, size_t const hashed_position, size_t offset ) noexcept {
+#pragma _NEC novector
+         for( ; offset < container_size; ++offset ) {
+            size_t const idx = slot_mapping( hashed_position, offset );
+            if( key_container[ idx ] == key ) {
+               tombstone_count -= ( key_count_container[ idx ]++ == 0 ) ? 1 : 0;
+               HISTOGRAMM_STATISTICS_( statistics.record_insert( offset ); )
+               return;
+            }
+            if( key_container[ idx ] == 0 ) {
+               key_container[ idx ] = key;
+               key_count_container[ idx ] = 1;
+               ++container_distinct_count;
+               HISTOGRAMM_STATISTICS_( statistics.record_insert( offset ); ++statistics.occupied_slots; )
+               return;
+            }
+         }
+      }
+      /* Adds delta to the count of key, claims the first empty slot if key is not contained. */
+      void add_count( T const key, size_t const hashed_position, uint64_t const delta ) noexcept {
+#pragma _NEC novector
+         for( size_t offset = 0; offset < container_size; ++offset ) {
+            size_t const idx = slot_mapping( hashed_position, offset );
+            if( key_container[ idx ] == key ) {
+               tombstone_count -= ( ( key_count_container[ idx ] == 0 ) && ( delta != 0 ) ) ? 1 : 0;
+               key_count_container[ idx ] += delta;
+               HISTOGRAMM_STATISTICS_( statistics.record_insert( offset ); )
+               return;
+            }
+            if( key_container[ idx ] == 0 ) {
+               key_container[ idx ] = key;
+               key_count_container[ idx ] = delta;
+               ++container_distinct_count;
+               HISTOGRAMM_STATISTICS_( statistics.record_insert( offset ); ++statistics.occupied_slots; )
+               return;
+            }
+         }
+      }
+      /* hashes the keys of the given slots of other with hash_batch and adds their counts */
+      void add_slots( const_sized_basic_histogramm const & other, size_t const * const positions, size_t const count ) noexcept {
+         T keys[ MERGE_BLOCK ];
+         hash_t hashes[ MERGE_BLOCK ];
+#pragma _NEC novector
+         for( size_t i = 0; i < count; ++i ) {
+            keys[ i ] = other.key_container[ positions[ i ] ];
+         }
+         hash_fn.hash_batch( keys, count, hashes );
+#pragma _NEC novector
+         for( size_t i = 0; i < count; ++i ) {
+            add_count( keys[ i ], hashes[ i ], other.key_count_container[ positions[ i ] ] );
+         }
+      }
+      /**
+       * Slots [ block_start, block_start + block_size ) of a table with the same size and hash: counts of keys which sit
+       * in the same slot in both tables are added in place, the slots of all other live keys of other are written
+       * to pending. Returns their number.
+       */
+      size_t merge_aligned_block_scalar( const_sized_basic_histogramm const & other, size_t const block_start,
+                                         size_t const block_size, size_t * const pending ) noexcept {
+         T const * const other_keys = other.key_container + block_start;
+         uint64_t const * const other_counts = other.key_count_container + block_start;
+         T * const keys = key_container + block_start;
+         uint64_t * const counts = key_count_container + block_start;
+         size_t revived = 0;
+         for( size_t i = 0; i < block_size; ++i ) {
+            if( keys[ i ] == other_keys[ i ] ) {
+               revived += ( ( counts[ i ] == 0 ) && ( other_counts[ i ] != 0 ) ) ? 1 : 0;
+               counts[ i ] += other_counts[ i ];
+            }
+         }
+         tombstone_count -= revived;
+         size_t pending_count = 0;
+#pragma _NEC novector
+         for( size_t i = 0; i < block_size; ++i ) {
+            pending[ pending_count ] = block_start + i;
+            pending_count += ( ( other_counts[ i ] != 0 ) && ( keys[ i ] != other_keys[ i ] ) ) ? 1 : 0;
+         }
+         return pending_count;
+      }
+#ifdef __AVX512F__
+      /* 16 slots per step: one compare of the keys, two masked 8 x 64-bit count adds and two compresses of the pending slots */
+      size_t merge_aligned_block_avx512( const_sized_basic_histogramm const & other, size_t const block_start,
+                                         size_t const block_size, size_t * const pending ) noexcept {
+         static_assert( sizeof( T ) == 4, "The AVX-512 merge works on 32-bit keys." );
+         __m512i const lane_v = _mm512_set_epi64( 7, 6, 5, 4, 3, 2, 1, 0 );
+         size_t const full = block_size & ~( size_t ) 15;
+         size_t pending_count = 0;
+#pragma _NEC novector
+         for( size_t i = 0; i < full; i += 16 ) {
+            size_t const position = block_start + i;
+            __m512i const keys_v = _mm512_loadu_si512( ( void const * ) ( key_container + position ) );
+            __m512i const other_keys_v = _mm512_loadu_si512( ( void const * ) ( other.key_container + position ) );
+            __mmask16 const same = _mm512_cmpeq_epi32_mask( keys_v, other_keys_v );
+            __m512i const other_counts_lo_v = _mm512_loadu_si512( ( void const * ) ( other.key_count_container + position ) );
+            __m512i const other_counts_hi_v = _mm512_loadu_si512( ( void const * ) ( other.key_count_container + position + 8 ) );
+            __mmask16 const live = ( __mmask16 ) ( _mm512_test_epi64_mask( other_counts_lo_v, other_counts_lo_v ) |
+                                                   ( _mm512_test_epi64_mask( other_counts_hi_v, other_counts_hi_v ) << 8 ) );
+            __mmask16 const added = same & live;
+            if( added != 0 ) {
+               uint64_t * const counts = key_count_container + position;
+               __m512i const counts_lo_v = _mm512_loadu_si512( ( void const * ) counts );
+               __m512i const counts_hi_v = _mm512_loadu_si512( ( void const * ) ( counts + 8 ) );
+               /* tombstones of the same key are revived */
+               tombstone_count -= ( size_t ) __builtin_popcount(
+                  ( unsigned ) _mm512_mask_testn_epi64_mask( ( __mmask8 ) added, counts_lo_v, counts_lo_v ) |
+                  ( ( unsigned ) _mm512_mask_testn_epi64_mask( ( __mmask8 ) ( added >> 8 ), counts_hi_v, counts_hi_v ) << 8 ) );
+               _mm512_mask_storeu_epi64( counts, ( __mmask8 ) added, _mm512_add_epi64( counts_lo_v, other_counts_lo_v ) );
+               _mm512_mask_storeu_epi64( counts + 8, ( __mmask8 ) ( added >> 8 ), _mm512_add_epi64( counts_hi_v, other_counts_hi_v ) );
+            }
+            __mmask16 const moved = live & ( __mmask16 ) ~same;
+            __m512i const position_v = _mm512_set1_epi64( ( long long ) position );
+            _mm512_mask_compressstoreu_epi64( pending + pending_count, ( __mmask8 ) moved, _mm512_add_epi64( lane_v, position_v ) );
+            pending_count += ( size_t ) __builtin_popcount( ( unsigned ) ( moved & 0xFF ) );
+            _mm512_mask_compressstoreu_epi64( pending + pending_count, ( __mmask8 ) ( moved >> 8 ),
+               _mm512_add_epi64( lane_v, _mm512_add_epi64( position_v, _mm512_set1_epi64( 8 ) ) ) );
+            pending_count += ( size_t ) __builtin_popcount( ( unsigned ) ( moved >> 8 ) );
+         }
+         return pending_count + merge_aligned_block_scalar( other, block_start + full, block_size - full, pending + pending_count );
+      }
+#endif
+      size_t merge_aligned_block( const_sized_basic_histogramm const & other, size_t const block_start,
+                                  size_t const block_size, size_t * const pending, std::false_type ) noexcept {
+         return merge_aligned_block_scalar( other, block_start, block_size, pending );
+      }
+      size_t merge_aligned_block( const_sized_basic_histogramm const & other, size_t const block_start,
+                                  size_t const block_size, size_t * const pending, std::true_type ) noexcept {
+#ifdef __AVX512F__
+         return merge_aligned_block_avx512( other, block_start, block_size, pending );
+#else
+         return merge_aligned_block_scalar( other, block_start, block_size, pending );
+#endif
+      }
+      /* group prefetched like probe_grouped, Delete sets the count to zero instead of decrementing it */
+      template< bool Delete, size_t GroupSize = 16 >
+      size_t remove_batch( T const * const keys, size_t const count ) noexcept {
+         hash_t hashes[ GroupSize ];
+         size_t base_positions[ GroupSize ];
+         size_t missing = 0;
+#pragma _NEC novector
+         for( size_t group_start = 0; group_start < count; group_start += GroupSize ) {
+            size_t const group_size = std::min( GroupSize, count - group_start );
+            T const * const group_keys = keys + group_start;
+            hash_fn.hash_batch( group_keys, group_size, hashes );
+            for( size_t i = 0; i < group_size; ++i ) {
+               base_positions[ i ] = slot_mapping( hashes[ i ], 0 );
+               PREFETCH_READ_( &key_container[ base_positions[ i ] ] );
+               PREFETCH_READ_( &key_count_container[ base_positions[ i ] ] );
+            }
+#pragma _NEC novector
+            for( size_t i = 0; i < group_size; ++i ) {
+               T const key = group_keys[ i ];
+               size_t hashed_position = base_positions[ i ];
+               bool found = false;
+#pragma _NEC novector
+               for( size_t offset = 1; offset <= container_size; ++offset ) {
+                  T const loaded_key = key_container[ hashed_position ];
+                  if( loaded_key == key ) {
+                     uint64_t & key_count = key_count_container[ hashed_position ];
+                     if( key_count != 0 ) {
+                        key_count = Delete ? 0 : key_count - 1;
+                        tombstone_count += ( key_count == 0 ) ? 1 : 0;
+                        found = true;
+                     }
+                     break;
+                  }
+                  if( loaded_key == 0 )
+                     break;
+                  hashed_position = slot_mapping( hashes[ i ], offset );
+               }
+               missing += found ? 0 : 1;
+            }
+         }
+         if( tombstone_count * 100 > ( size_t ) container_size * compaction_threshold )
+            compact( );
+         return missing;
+      }
    public:
       const_sized_basic_histogramm( uint32_t _ElemCount, uint32_t _LoadFactor):
          ElementCount{ _ElemCount },
          LoadFactor{ _LoadFactor },
-         container_size{ ElementCount * 100 / LoadFactor },
+         slot_mapping{ ( size_t ) ElementCount * 100 / LoadFactor },
+         container_size{ ( T ) slot_mapping.get_size( ) },
          container_infinity_value{ container_size + 1 },
          container_distinct_count{ 0 },
-         key_container{ new T[ container_size ]( ) },
-         key_count_container{ new uint64_t[ container_size ]( ) } {
+         tombstone_count{ 0 },
+         compaction_threshold{ 10 },
+         key_container{ Allocation::template allocate< T >( container_size ) },
+         key_count_container{ Allocation::template allocate< uint64_t >( container_size ) },
+         owns_containers{ true },
+         stream{ nullptr } {
+         HISTOGRAMM_STATISTICS_( statistics.clear( ); statistics.occupied_slots = 0; )
 //         std::cout << "HASHED_HISTO: LF = " << LoadFactor << "\nCONTAINERSIZE = " << container_size << "\nELEMCOUNT = " << ElementCount << "\n";
       }
+      /**
+       * Uses containers of get_size( ) slots which were filled by a histogramm with the same parameters, e.g. a
+       * mapped histogramm file. Nothing is copied or touched and the containers are not freed. _DistinctCount is the
+       * number of keys with a non zero count, _TombstoneCount the get_tombstone_count( ) of the filling histogramm.
+       */
+      const_sized_basic_histogramm( uint32_t _ElemCount, uint32_t _LoadFactor,
+                                    T * const _key_container, uint64_t * const _key_count_container, size_t const _DistinctCount,
+                                    size_t const _TombstoneCount ):
+         ElementCount{ _ElemCount },
+         LoadFactor{ _LoadFactor },
+         slot_mapping{ ( size_t ) ElementCount * 100 / LoadFactor },
+         container_size{ ( T ) slot_mapping.get_size( ) },
+         container_infinity_value{ container_size + 1 },
+         container_distinct_count{ _DistinctCount + _TombstoneCount },
+         tombstone_count{ _TombstoneCount },
+         compaction_threshold{ 10 },
+         key_container{ _key_container },
+         key_count_container{ _key_count_container },
+         owns_containers{ false },
+         stream{ nullptr } {
+         HISTOGRAMM_STATISTICS_( statistics.clear( ); statistics.occupied_slots = _DistinctCount + _TombstoneCount; )
+      }
       virtual ~const_sized_basic_histogramm( void ) noexcept {
-         delete[ ] key_count_container;
-         delete[ ] key_container;
+         delete stream;
+         if( owns_containers ) {
+            Allocation::deallocate( key_count_container, container_size );
+            Allocation::deallocate( key_container, container_size );
+         }
+      }
+      T get_element_count( void ) const noexcept {
+         return ElementCount;
+      }
+      T get_load_factor( void ) const noexcept {
+         return LoadFactor;
       }
       T * get_key_container( void ) const noexcept {
          return key_container;
       }
+      uint64_t * get_key_count_container( void ) const noexcept {
+         return key_count_container;
+      }
       T get_size( void ) const noexcept {
          return container_size;
       }
@@ -53,11 +444,53 @@ class const_sized_basic_histogramm {
       size_t key_count( void ) const noexcept {
          size_t result = 0;
          for( size_t position = 0; position < container_size; ++position ) {
-            if( key_container[ position ] != 0 )
+            if( key_count_container[ position ] != 0 )
                ++result;
          }
          return result;
       }
+      size_t get_tombstone_count( void ) const noexcept {
+         return tombstone_count;
+      }
+      void set_compaction_threshold( size_t const percent ) noexcept {
+         compaction_threshold = percent;
+      }
+      /**
+       * Length of the longest run of occupied slots ( tombstones included ), a run may wrap around the end of the
+       * containers. Linear probing for a missing key whose home slot is in a run walks to the end of it, so this
+       * bounds the probe length of every lookup. Scans the key container.
+       */
+      size_t longest_cluster( void ) const noexcept {
+         size_t first_empty = 0;
+         while( ( first_empty < container_size ) && ( key_container[ first_empty ] != 0 ) )
+            ++first_empty;
+         if( first_empty == container_size )
+            return container_size;
+         size_t result = 0;
+         size_t run = 0;
+         /* starts behind an empty slot, so the run across the end of the containers is counted in one piece */
+#pragma _NEC novector
+         for( size_t i = 1; i <= container_size; ++i ) {
+            size_t position = first_empty + i;
+            position = ( position < container_size ) ? position : position - container_size;
+            run = ( key_container[ position ] != 0 ) ? run + 1 : 0;
+            result = ( run > result ) ? run : result;
+         }
+         return result;
+      }
+#ifdef HASH_SET_STATISTICS
+      histogramm_statistics const & get_statistics( void ) const noexcept {
+         return statistics;
+      }
+      /* incrementally maintained counterpart of the scan in key_count( ), which does not count tombstones */
+      size_t get_occupied_count( void ) const noexcept {
+         return statistics.occupied_slots;
+      }
+      /* restarts the probe length distributions and the retry counter, e.g. between the build and the probe phase */
+      void reset_statistics( void ) noexcept {
+         statistics.clear( );
+      }
+#endif
       void build_scalar_elem( T const * const keys ) noexcept {
          T key, hashed_position, offset_zero, offset_equal, idx_zero, idx_equal;
          bool found;
@@ -69,7 +502,7 @@ class const_sized_basic_histogramm {
             found = false;
 #pragma _NEC novector
             for( offset_zero = 0; offset_zero < container_size; offset_zero++ ) {
-               idx_zero = ( hashed_position + offset_zero ) % container_size;
+               idx_zero = slot_mapping( hashed_position, offset_zero );
                if( key_container[ idx_zero ] == 0 ) {
                   break;
                }
@@ -77,7 +510,7 @@ class const_sized_basic_histogramm {
 
 #pragma _NEC novector
             for( offset_equal = 0; offset_equal < offset_zero; offset_equal++ ) {
-               idx_equal = ( hashed_position + offset_equal ) % container_size;
+               idx_equal = slot_mapping( hashed_position, offset_equal );
                if( key_container[ idx_equal ] == key ) {
                   found = true;
                   break;
@@ -89,8 +522,11 @@ class const_sized_basic_histogramm {
                key_container[ idx_zero ] = key;
                idx = idx_zero;
                ++container_distinct_count;
+               ++tombstone_count;
+               HISTOGRAMM_STATISTICS_( ++statistics.occupied_slots; )
             }
-            key_count_container[ idx ]++;
+            HISTOGRAMM_STATISTICS_( statistics.record_insert( found ? offset_equal : offset_zero ); )
+            tombstone_count -= ( key_count_container[ idx ]++ == 0 ) ? 1 : 0;
          }
       }
       void build_vectorized_elem( T const * const keys ) noexcept {
@@ -102,13 +538,13 @@ class const_sized_basic_histogramm {
             hashed_position = hash_fn( key );
             found = false;
             for( offset_zero = 0; offset_zero < container_size; offset_zero++ ) {
-               idx_zero = ( hashed_position + offset_zero ) % container_size;
+               idx_zero = slot_mapping( hashed_position, offset_zero );
                if( key_container[ idx_zero ] == 0 ) {
                   break;
                }
             }
             for( offset_equal = 0; offset_equal < offset_zero; offset_equal++ ) {
-               idx_equal = ( hashed_position + offset_equal ) % container_size;
+               idx_equal = slot_mapping( hashed_position, offset_equal );
                if( key_container[ idx_equal ] == key ) {
                   found = true;
                   break;
@@ -120,59 +556,105 @@ class const_sized_basic_histogramm {
                key_container[ idx_zero ] = key;
                idx = idx_zero;
                ++container_distinct_count;
+               ++tombstone_count;
+               HISTOGRAMM_STATISTICS_( ++statistics.occupied_slots; )
             }
-            key_count_container[ idx ]++;
+            HISTOGRAMM_STATISTICS_( statistics.record_insert( found ? offset_equal : offset_zero ); )
+            tombstone_count -= ( key_count_container[ idx ]++ == 0 ) ? 1 : 0;
+         }
+      }
+      /**
+       * Thread-safe counterpart of build_scalar_elem: several threads may count disjoint key ranges into this
+       * histogramm at the same time. Each key costs at least one atomic operation on its count.
+       */
+      void build_concurrent_atomic( T const * const keys, size_t const count ) noexcept {
+#pragma _NEC novector
+         for( size_t keys_position = 0; keys_position < count; ++keys_position ) {
+            T const key = keys[ keys_position ];
+            insert_concurrent( key, hash_fn( key ), 1 );
+         }
+      }
+      /**
+       * Thread-safe build like build_concurrent_atomic, but counts are first accumulated in a small direct mapped
+       * cache of the calling thread. A delta is flushed with a single atomic add when its entry gets evicted and at
+       * the end of the call, so hot keys do not serialize all threads on one counter.
+       */
+      void build_concurrent_delta( T const * const keys, size_t const count ) noexcept {
+         T cached_keys[ CONCURRENT_DELTA_CACHE_SIZE ];
+         T cached_hashes[ CONCURRENT_DELTA_CACHE_SIZE ];
+         uint64_t cached_deltas[ CONCURRENT_DELTA_CACHE_SIZE ];
+         for( size_t i = 0; i < CONCURRENT_DELTA_CACHE_SIZE; ++i ) {
+            cached_keys[ i ] = 0;
+            cached_hashes[ i ] = 0;
+            cached_deltas[ i ] = 0;
+         }
+#pragma _NEC novector
+         for( size_t keys_position = 0; keys_position < count; ++keys_position ) {
+            T const key = keys[ keys_position ];
+            T const hashed_position = hash_fn( key );
+            size_t const cache_idx = hashed_position & ( CONCURRENT_DELTA_CACHE_SIZE - 1 );
+            if( cached_keys[ cache_idx ] != key ) {
+               if( cached_deltas[ cache_idx ] != 0 )
+                  insert_concurrent( cached_keys[ cache_idx ], cached_hashes[ cache_idx ], cached_deltas[ cache_idx ] );
+               cached_keys[ cache_idx ] = key;
+               cached_hashes[ cache_idx ] = hashed_position;
+               cached_deltas[ cache_idx ] = 0;
+            }
+            cached_deltas[ cache_idx ]++;
+         }
+#pragma _NEC novector
+         for( size_t i = 0; i < CONCURRENT_DELTA_CACHE_SIZE; ++i ) {
+            if( cached_deltas[ i ] != 0 )
+               insert_concurrent( cached_keys[ i ], cached_hashes[ i ], cached_deltas[ i ] );
          }
       }
       void build_scalar_batch( T const * const keys ) noexcept {
+         /* claimed slots minus revived counts ( wraps while revivals lead ), kept local and folded in once at the end:
+          * a member would be reloaded on every lane, as the lanes write through key_count_container of the same type.
+          * The other batch builds do the same. */
+         size_t tombstone_delta = 0;
          size_t key_positions[ 256 ];
-         size_t hashes_offset[ 256 ];
          size_t hashed_positions[ 256 ];
+         hash_t lane_hashes[ 256 ];
+         hash_t window[ HASH_WINDOW ];
+         size_t window_start = 0;
          T gathered_elements[ 256 ];
          size_t offsets[ 256 ];
+         init_hash_window( keys, ElementCount, window, no_hash_sink{ } );
 #pragma _NEC novector
          for( size_t i = 0; i < 256; ++i ) {
             key_positions[ i ] = i;
+            lane_hashes[ i ] = window[ i ];
             hashed_positions[ i ] = 0;
             offsets[ i ] = 0;
          }
          size_t max_position = 255;
          while( max_position < ElementCount ) {
+            advance_hash_window( keys, ElementCount, window, window_start, max_position + 1, no_hash_sink{ } );
 #pragma _NEC novector
             for ( size_t i = 0; i < 256; ++i ) {
-               size_t position = key_positions[ i ];
-               T h1 = keys[ position ];
-               // BEGIN MurMur3 32 bit
-               h1 *= 0xcc9e2d51;
-               h1 = ( h1 << 15 ) | ( h1 >> 17 );
-               h1 *= 0x1b873593;
-               h1 = ( h1 << 13 ) | ( h1 >> 19 );
-               h1 = h1 * 5 + 0xe6546b64;
-               h1 ^= 4;
-               h1 ^= h1 >> 16;
-               h1 *= 0x85ebca6b;
-               h1 ^= h1 >> 13;
-               h1 *= 0xc2b2ae35;
-               h1 ^= h1 >> 16;
-               // END MurMur3 32 bit
-               hashes_offset[ i ] = h1 + offsets[ i ];
-               hashed_positions[ i ] = hashes_offset[ i ] % container_size;
+               hashed_positions[ i ] = slot_mapping( lane_hashes[ i ], offsets[ i ] );
                gathered_elements[ i ] = key_container[ hashed_positions[ i ]];
             }
 #pragma _NEC novector
             for ( size_t i = 0; i < 256; ++i ) {
                if ( gathered_elements[ i ] == 0 ) {
+                  HISTOGRAMM_STATISTICS_( statistics.occupied_slots += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0; )
+                  tombstone_delta += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0;
                   key_container[ hashed_positions[ i ]] = keys[ key_positions[ i ]];
                }
             }
 #pragma _NEC novector
             for( size_t i = 0; i < 256; ++i ) {
                if( key_container[ hashed_positions[ i ] ] == keys[ key_positions[ i ] ] ) {
-                  key_count_container[ hashed_positions[ i ]]++;
+                  HISTOGRAMM_STATISTICS_( statistics.record_insert( offsets[ i ] ); )
+                  tombstone_delta -= ( key_count_container[ hashed_positions[ i ] ]++ == 0 ) ? 1 : 0;
                   offsets[ i ] = 0;
                   key_positions[ i ] = ++max_position;
+                  lane_hashes[ i ] = window[ max_position - window_start ];
                } else {
                   offsets[ i ]++;
+                  HISTOGRAMM_STATISTICS_( ++statistics.batch_lane_retries; )
                }
             }
          }
@@ -185,24 +667,8 @@ class const_sized_basic_histogramm {
          while( processable_elements > 0 ) {
 #pragma _NEC novector
             for ( size_t i = 0; i < 256; ++i ) {
-               size_t position = key_positions[ i ];
-               if( position < ElementCount ) {
-                  T h1 = keys[ position ];
-                  // BEGIN MurMur3 32 bit
-                  h1 *= 0xcc9e2d51;
-                  h1 = ( h1 << 15 ) | ( h1 >> 17 );
-                  h1 *= 0x1b873593;
-                  h1 = ( h1 << 13 ) | ( h1 >> 19 );
-                  h1 = h1 * 5 + 0xe6546b64;
-                  h1 ^= 4;
-                  h1 ^= h1 >> 16;
-                  h1 *= 0x85ebca6b;
-                  h1 ^= h1 >> 13;
-                  h1 *= 0xc2b2ae35;
-                  h1 ^= h1 >> 16;
-                  // END MurMur3 32 bit
-                  hashes_offset[ i ] = h1 + offsets[ i ];
-                  hashed_positions[ i ] = hashes_offset[ i ] % container_size;
+               if( key_positions[ i ] < ElementCount ) {
+                  hashed_positions[ i ] = slot_mapping( lane_hashes[ i ], offsets[ i ] );
                   gathered_elements[ i ] = key_container[ hashed_positions[ i ]];
                }
             }
@@ -210,6 +676,8 @@ class const_sized_basic_histogramm {
             for ( size_t i = 0; i < 256; ++i ) {
                if( key_positions[ i ] < ElementCount ) {
                   if ( gathered_elements[ i ] == 0 ) {
+                     HISTOGRAMM_STATISTICS_( statistics.occupied_slots += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0; )
+                     tombstone_delta += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0;
                      key_container[ hashed_positions[ i ]] = keys[ key_positions[ i ]];
                   }
                }
@@ -218,11 +686,13 @@ class const_sized_basic_histogramm {
             for( size_t i = 0; i < 256; ++i ) {
                if( key_positions[ i ] < ElementCount ) {
                   if ( key_container[ hashed_positions[ i ]] == keys[ key_positions[ i ]] ) {
-                     key_count_container[ hashed_positions[ i ]]++;
+                     HISTOGRAMM_STATISTICS_( statistics.record_insert( offsets[ i ] ); )
+                     tombstone_delta -= ( key_count_container[ hashed_positions[ i ] ]++ == 0 ) ? 1 : 0;
                      offsets[ i ] = 0;
                      key_positions[ i ] = ++max_position;
                   } else {
                      offsets[ i ]++;
+                     HISTOGRAMM_STATISTICS_( ++statistics.batch_lane_retries; )
                   }
                }
             }
@@ -233,56 +703,63 @@ class const_sized_basic_histogramm {
                   ++processable_elements;
             }
          }
+         tombstone_count += tombstone_delta;
       }
       void build_vectorized_batch( T const * const keys ) noexcept {
+         build_vectorized_batch( keys, nullptr, no_hash_sink{ } );
+      }
+      /* like build_vectorized_batch, additionally stores the slot of every key in key_slots[ ElementCount ] */
+      void build_vectorized_batch( T const * const keys, size_t * const key_slots ) noexcept {
+         build_vectorized_batch( keys, key_slots, no_hash_sink{ } );
+      }
+      /* additionally hands the hash of every key once to hash_sink( hashes, count ), in key order */
+      template< class HashSink >
+      void build_vectorized_batch( T const * const keys, size_t * const key_slots, HashSink const & hash_sink ) noexcept {
+         size_t tombstone_delta = 0;
          size_t key_positions[ 256 ];
-         size_t hashes_offset[ 256 ];
          size_t hashed_positions[ 256 ];
+         hash_t lane_hashes[ 256 ];
+         hash_t window[ HASH_WINDOW ];
+         size_t window_start = 0;
          T gathered_elements[ 256 ];
          size_t offsets[ 256 ];
+         init_hash_window( keys, ElementCount, window, hash_sink );
 #pragma _NEC vreg(key_positions)
 #pragma _NEC vreg(gathered_elements)
          for( size_t i = 0; i < 256; ++i ) {
             key_positions[ i ] = i;
+            lane_hashes[ i ] = window[ i ];
             hashed_positions[ i ] = 0;
             offsets[ i ] = 0;
          }
          size_t max_position = 255;
          while( max_position < ElementCount ) {
+            advance_hash_window( keys, ElementCount, window, window_start, max_position + 1, hash_sink );
             for ( size_t i = 0; i < 256; ++i ) {
-               size_t position = key_positions[ i ];
-               T h1 = keys[ position ];
-               // BEGIN MurMur3 32 bit
-                  h1 *= 0xcc9e2d51;
-                  h1 = ( h1 << 15 ) | ( h1 >> 17 );
-                  h1 *= 0x1b873593;
-                  h1 = ( h1 << 13 ) | ( h1 >> 19 );
-                  h1 = h1 * 5 + 0xe6546b64;
-                  h1 ^= 4;
-                  h1 ^= h1 >> 16;
-                  h1 *= 0x85ebca6b;
-                  h1 ^= h1 >> 13;
-                  h1 *= 0xc2b2ae35;
-                  h1 ^= h1 >> 16;
-               // END MurMur3 32 bit
-               hashes_offset[ i ] = h1 + offsets[ i ];
-               hashed_positions[ i ] = hashes_offset[ i ] % container_size;
+               hashed_positions[ i ] = slot_mapping( lane_hashes[ i ], offsets[ i ] );
                gathered_elements[ i ] = key_container[ hashed_positions[ i ]];
             }
 #pragma _NEC ivdep
 #pragma _NEC move
             for ( size_t i = 0; i < 256; ++i ) {
                if ( gathered_elements[ i ] == 0 ) {
+                  HISTOGRAMM_STATISTICS_( statistics.occupied_slots += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0; )
+                  tombstone_delta += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0;
                   key_container[ hashed_positions[ i ]] = keys[ key_positions[ i ]];
                }
             }
             for( size_t i = 0; i < 256; ++i ) {
                if( key_container[ hashed_positions[ i ] ] == keys[ key_positions[ i ] ] ) {
-                  key_count_container[ hashed_positions[ i ]]++;
+                  if( key_slots != nullptr )
+                     key_slots[ key_positions[ i ] ] = hashed_positions[ i ];
+                  HISTOGRAMM_STATISTICS_( statistics.record_insert( offsets[ i ] ); )
+                  tombstone_delta -= ( key_count_container[ hashed_positions[ i ] ]++ == 0 ) ? 1 : 0;
                   offsets[ i ] = 0;
                   key_positions[ i ] = ++max_position;
+                  lane_hashes[ i ] = window[ max_position - window_start ];
                } else {
                   offsets[ i ]++;
+                  HISTOGRAMM_STATISTICS_( ++statistics.batch_lane_retries; )
                }
             }
          }
@@ -293,24 +770,8 @@ class const_sized_basic_histogramm {
          }
          while( processable_elements > 0 ) {
             for ( size_t i = 0; i < 256; ++i ) {
-               size_t position = key_positions[ i ];
-               if( position < ElementCount ) {
-                  T h1 = keys[ position ];
-                  // BEGIN MurMur3 32 bit
-                     h1 *= 0xcc9e2d51;
-                     h1 = ( h1 << 15 ) | ( h1 >> 17 );
-                     h1 *= 0x1b873593;
-                     h1 = ( h1 << 13 ) | ( h1 >> 19 );
-                     h1 = h1 * 5 + 0xe6546b64;
-                     h1 ^= 4;
-                     h1 ^= h1 >> 16;
-                     h1 *= 0x85ebca6b;
-                     h1 ^= h1 >> 13;
-                     h1 *= 0xc2b2ae35;
-                     h1 ^= h1 >> 16;
-                  // END MurMur3 32 bit
-                  hashes_offset[ i ] = h1 + offsets[ i ];
-                  hashed_positions[ i ] = hashes_offset[ i ] % container_size;
+               if( key_positions[ i ] < ElementCount ) {
+                  hashed_positions[ i ] = slot_mapping( lane_hashes[ i ], offsets[ i ] );
                   gathered_elements[ i ] = key_container[ hashed_positions[ i ]];
                }
             }
@@ -319,6 +780,8 @@ class const_sized_basic_histogramm {
             for ( size_t i = 0; i < 256; ++i ) {
                if( key_positions[ i ] < ElementCount ) {
                   if ( gathered_elements[ i ] == 0 ) {
+                     HISTOGRAMM_STATISTICS_( statistics.occupied_slots += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0; )
+                     tombstone_delta += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0;
                      key_container[ hashed_positions[ i ]] = keys[ key_positions[ i ]];
                   }
                }
@@ -327,11 +790,15 @@ class const_sized_basic_histogramm {
             for( size_t i = 0; i < 256; ++i ) {
                if( key_positions[ i ] < ElementCount ) {
                   if ( key_container[ hashed_positions[ i ]] == keys[ key_positions[ i ]] ) {
-                     key_count_container[ hashed_positions[ i ]]++;
+                     if( key_slots != nullptr )
+                        key_slots[ key_positions[ i ] ] = hashed_positions[ i ];
+                     HISTOGRAMM_STATISTICS_( statistics.record_insert( offsets[ i ] ); )
+                     tombstone_delta -= ( key_count_container[ hashed_positions[ i ] ]++ == 0 ) ? 1 : 0;
                      offsets[ i ] = 0;
                      key_positions[ i ] = ++max_position;
                   } else {
                      offsets[ i ]++;
+                     HISTOGRAMM_STATISTICS_( ++statistics.batch_lane_retries; )
                   }
                }
             }
@@ -341,7 +808,274 @@ class const_sized_basic_histogramm {
                   ++processable_elements;
             }
          }
+         tombstone_count += tombstone_delta;
+      }
+      /**
+       * Streaming variant of build_vectorized_batch for keys which arrive in chunks: begin_build( ), any number of
+       * consume( keys, count ), finish_build( ). The 256 lanes stay in flight across chunks, consume only returns when
+       * a lane needs a key and the chunk is exhausted, and is not drained before finish_build( ). The chunk may be
+       * reused by the caller after consume returns. All chunks together should not hold more distinct keys than
+       * ElementCount.
+       */
+      void begin_build( void ) noexcept {
+         if( stream == nullptr )
+            stream = new stream_lanes;
+         for( size_t i = 0; i < 256; ++i ) {
+            stream->active[ i ] = false;
+            stream->offsets[ i ] = 0;
+         }
+         stream->active_count = 0;
       }
+      void consume( T const * const keys, size_t const count ) noexcept {
+         size_t tombstone_delta = 0;
+         T lane_keys[ 256 ];
+         hash_t lane_hashes[ 256 ];
+         size_t offsets[ 256 ];
+         size_t hashed_positions[ 256 ];
+         T gathered_elements[ 256 ];
+         hash_t window[ HASH_WINDOW ];
+         size_t window_start = 0;
+         size_t next_position = 0;
+         init_hash_window( keys, count, window, no_hash_sink{ } );
+#pragma _NEC novector
+         for( size_t i = 0; i < 256; ++i ) {
+            if( !stream->active[ i ] && ( next_position < count ) ) {
+               stream->keys[ i ] = keys[ next_position ];
+               stream->hashes[ i ] = window[ next_position++ ];
+               stream->offsets[ i ] = 0;
+               stream->active[ i ] = true;
+               ++stream->active_count;
+            }
+            lane_keys[ i ] = stream->keys[ i ];
+            lane_hashes[ i ] = stream->hashes[ i ];
+            offsets[ i ] = stream->offsets[ i ];
+         }
+         size_t active_count = stream->active_count;
+         while( active_count == 256 ) {
+            advance_hash_window( keys, count, window, window_start, next_position, no_hash_sink{ } );
+            for ( size_t i = 0; i < 256; ++i ) {
+               hashed_positions[ i ] = slot_mapping( lane_hashes[ i ], offsets[ i ] );
+               gathered_elements[ i ] = key_container[ hashed_positions[ i ]];
+            }
+#pragma _NEC ivdep
+            for ( size_t i = 0; i < 256; ++i ) {
+               if ( gathered_elements[ i ] == 0 ) {
+                  HISTOGRAMM_STATISTICS_( statistics.occupied_slots += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0; )
+                  tombstone_delta += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0;
+                  key_container[ hashed_positions[ i ]] = lane_keys[ i ];
+               }
+            }
+            for( size_t i = 0; i < 256; ++i ) {
+               if( key_container[ hashed_positions[ i ] ] == lane_keys[ i ] ) {
+                  HISTOGRAMM_STATISTICS_( statistics.record_insert( offsets[ i ] ); )
+                  tombstone_delta -= ( key_count_container[ hashed_positions[ i ] ]++ == 0 ) ? 1 : 0;
+                  offsets[ i ] = 0;
+                  if( next_position < count ) {
+                     lane_keys[ i ] = keys[ next_position ];
+                     lane_hashes[ i ] = window[ next_position++ - window_start ];
+                  } else {
+                     stream->active[ i ] = false;
+                     --active_count;
+                  }
+               } else {
+                  offsets[ i ]++;
+                  HISTOGRAMM_STATISTICS_( ++statistics.batch_lane_retries; )
+               }
+            }
+         }
+#pragma _NEC novector
+         for( size_t i = 0; i < 256; ++i ) {
+            stream->keys[ i ] = lane_keys[ i ];
+            stream->hashes[ i ] = lane_hashes[ i ];
+            stream->offsets[ i ] = offsets[ i ];
+         }
+         stream->active_count = active_count;
+         tombstone_count += tombstone_delta;
+      }
+      /* drains the lanes left by the last consume */
+      void finish_build( void ) noexcept {
+         size_t tombstone_delta = 0;
+         size_t hashed_positions[ 256 ];
+         T gathered_elements[ 256 ];
+         while( stream->active_count > 0 ) {
+            for ( size_t i = 0; i < 256; ++i ) {
+               if( stream->active[ i ] ) {
+                  hashed_positions[ i ] = slot_mapping( stream->hashes[ i ], stream->offsets[ i ] );
+                  gathered_elements[ i ] = key_container[ hashed_positions[ i ]];
+               }
+            }
+            for ( size_t i = 0; i < 256; ++i ) {
+               if( stream->active[ i ] && ( gathered_elements[ i ] == 0 ) ) {
+                  HISTOGRAMM_STATISTICS_( statistics.occupied_slots += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0; )
+                  tombstone_delta += ( key_container[ hashed_positions[ i ] ] == 0 ) ? 1 : 0;
+                  key_container[ hashed_positions[ i ]] = stream->keys[ i ];
+               }
+            }
+            for( size_t i = 0; i < 256; ++i ) {
+               if( stream->active[ i ] ) {
+                  if( key_container[ hashed_positions[ i ]] == stream->keys[ i ] ) {
+                     HISTOGRAMM_STATISTICS_( statistics.record_insert( stream->offsets[ i ] ); )
+                     tombstone_delta -= ( key_count_container[ hashed_positions[ i ] ]++ == 0 ) ? 1 : 0;
+                     stream->active[ i ] = false;
+                     --stream->active_count;
+                  } else {
+                     stream->offsets[ i ]++;
+                     HISTOGRAMM_STATISTICS_( ++statistics.batch_lane_retries; )
+                  }
+               }
+            }
+         }
+         tombstone_count += tombstone_delta;
+         delete stream;
+         stream = nullptr;
+      }
+#ifdef __AVX2__
+      /**
+       * Hashes and checks the first slot of 8 keys at once with an AVX2 gather. AVX2 has neither scatters nor
+       * conflict detection, so inserts, increments and longer probe sequences are resolved per lane in order,
+       * which keeps lanes with the same key or slot correct.
+       */
+      void build_avx2( T const * const keys ) noexcept {
+         static_assert( sizeof( T ) == 4, "The AVX2 build works on 32-bit keys." );
+         alignas( 32 ) uint32_t hashes[ 8 ];
+         alignas( 32 ) int32_t slots[ 8 ];
+         __m256i const zero_v = _mm256_setzero_si256( );
+         size_t keys_position = 0;
+#pragma _NEC novector
+         for( ; keys_position + 8 <= ElementCount; keys_position += 8 ) {
+            __m256i const keys_v = _mm256_loadu_si256( ( __m256i const * ) ( keys + keys_position ) );
+            _mm256_store_si256( ( __m256i * ) hashes, hash_fn( keys_v ) );
+            for( size_t i = 0; i < 8; ++i ) {
+               slots[ i ] = ( int32_t ) slot_mapping( hashes[ i ], 0 );
+            }
+            __m256i const gathered_v =
+               _mm256_i32gather_epi32( ( int const * ) key_container, _mm256_load_si256( ( __m256i const * ) slots ), 4 );
+            uint32_t const hit = ( uint32_t ) _mm256_movemask_ps( _mm256_castsi256_ps( _mm256_cmpeq_epi32( gathered_v, keys_v ) ) );
+            uint32_t const empty = ( uint32_t ) _mm256_movemask_ps( _mm256_castsi256_ps( _mm256_cmpeq_epi32( gathered_v, zero_v ) ) );
+#pragma _NEC novector
+            for( size_t i = 0; i < 8; ++i ) {
+               T const key = keys[ keys_position + i ];
+               if( ( hit >> i ) & 1 ) {
+                  tombstone_count -= ( key_count_container[ slots[ i ] ]++ == 0 ) ? 1 : 0;
+                  HISTOGRAMM_STATISTICS_( statistics.record_insert( 0 ); )
+               } else if( ( ( empty >> i ) & 1 ) && key_container[ slots[ i ] ] == 0 ) {
+                  key_container[ slots[ i ] ] = key;
+                  key_count_container[ slots[ i ] ] = 1;
+                  ++container_distinct_count;
+                  HISTOGRAMM_STATISTICS_( statistics.record_insert( 0 ); ++statistics.occupied_slots; )
+               } else {
+                  /* the slot was taken by an earlier lane, which may have inserted the same key */
+                  insert_from_offset( key, hashes[ i ], ( ( empty >> i ) & 1 ) ? 0 : 1 );
+               }
+            }
+         }
+#pragma _NEC novector
+         for( ; keys_position < ElementCount; ++keys_position ) {
+            insert_from_offset( keys[ keys_position ], hash_fn( keys[ keys_position ] ), 0 );
+         }
+      }
+#endif
+#if defined( __AVX512F__ ) && defined( __AVX512CD__ )
+      /**
+       * Builds with 16 lanes which probe independently. Lanes which placed their key are refilled with the next keys
+       * by an expanding load, all others advance by one slot (or recheck it, see below). Per round:
+       *    - the key slots of all lanes are gathered and compared against the key and the empty marker,
+       *    - lanes which found the same empty slot are detected with vpconflictd, only the first one scatters its key,
+       *      the others recheck the slot in the next round,
+       *    - lanes which hit the same slot hold the same key. Every lane adds 1 + the number of preceding lanes with
+       *      its slot to the gathered count and scatters it; as scatters write from the lowest to the highest lane,
+       *      the last lane stores the sum of all increments.
+       * Slots are used as signed 32-bit gather indices, so the container has to hold less than 2^31 slots.
+       */
+      void build_avx512( T const * const keys ) noexcept {
+         static_assert( sizeof( T ) == 4, "The AVX-512 build works on 32-bit keys." );
+         __m512i const zero_v = _mm512_setzero_si512( );
+         __m512i const one_v = _mm512_set1_epi32( 1 );
+         __m512i const size_v = _mm512_set1_epi32( ( int ) container_size );
+         /* distinct negative values per lane, never equal to a slot, so idle lanes do not take part in conflicts */
+         __m512i const idle_v = _mm512_setr_epi32( -1, -2, -3, -4, -5, -6, -7, -8, -9, -10, -11, -12, -13, -14, -15, -16 );
+         __m512i keys_v = zero_v;
+         __m512i base_v = zero_v;
+         __m512i offsets_v = zero_v;
+         __mmask16 active = 0;
+         size_t keys_position = 0;
+#pragma _NEC novector
+         while( true ) {
+            uint32_t refill = ( uint32_t ) ( __mmask16 ) ~active;
+            size_t const remaining = ElementCount - keys_position;
+            if( refill != 0 && remaining > 0 ) {
+               /* at the end of the input only the lowest remaining lanes are refilled */
+               while( ( size_t ) __builtin_popcount( refill ) > remaining ) {
+                  refill ^= 1u << ( 31 - __builtin_clz( refill ) );
+               }
+               keys_v = _mm512_mask_expandloadu_epi32( keys_v, ( __mmask16 ) refill, keys + keys_position );
+               keys_position += ( size_t ) __builtin_popcount( refill );
+               base_v = _mm512_mask_mov_epi32( base_v, ( __mmask16 ) refill, slot_mapping.base_avx512( hash_fn( keys_v ) ) );
+               offsets_v = _mm512_mask_mov_epi32( offsets_v, ( __mmask16 ) refill, zero_v );
+               active |= ( __mmask16 ) refill;
+            }
+            if( active == 0 )
+               break;
+            /* ( base + offset ) mod size, offset < size */
+            __m512i slots_v = _mm512_add_epi32( base_v, offsets_v );
+            slots_v = _mm512_mask_sub_epi32( slots_v, _mm512_cmpge_epu32_mask( slots_v, size_v ), slots_v, size_v );
+            __m512i const gathered_v = _mm512_mask_i32gather_epi32( zero_v, active, slots_v, key_container, 4 );
+            __mmask16 const hit = _mm512_mask_cmpeq_epi32_mask( active, gathered_v, keys_v );
+            __mmask16 const empty = _mm512_mask_cmpeq_epi32_mask( active, gathered_v, zero_v );
+
+            __m512i const claim_conflicts_v = _mm512_conflict_epi32( _mm512_mask_mov_epi32( idle_v, empty, slots_v ) );
+            __mmask16 const inserted = _mm512_mask_testn_epi32_mask( empty, claim_conflicts_v, claim_conflicts_v );
+            _mm512_mask_i32scatter_epi32( key_container, inserted, slots_v, keys_v, 4 );
+            container_distinct_count += ( size_t ) __builtin_popcount( ( uint32_t ) inserted );
+
+            __mmask16 const done = hit | inserted;
+#ifdef HASH_SET_STATISTICS
+            alignas( 64 ) uint32_t lane_offsets[ 16 ];
+            _mm512_store_si512( ( void * ) lane_offsets, offsets_v );
+            for( size_t i = 0; i < 16; ++i ) {
+               if( ( done >> i ) & 1 )
+                  statistics.record_insert( lane_offsets[ i ] );
+            }
+            statistics.occupied_slots += ( size_t ) __builtin_popcount( ( uint32_t ) inserted );
+            statistics.batch_lane_retries += ( size_t ) __builtin_popcount( ( uint32_t ) ( active & ( __mmask16 ) ~done ) );
+#endif
+            __m512i const done_conflicts_v = _mm512_conflict_epi32( _mm512_mask_mov_epi32( idle_v, done, slots_v ) );
+            __m512i increments_v = one_v;
+            if( _mm512_mask_test_epi32_mask( done, done_conflicts_v, done_conflicts_v ) != 0 ) {
+#ifdef __AVX512VPOPCNTDQ__
+               increments_v = _mm512_add_epi32( one_v, _mm512_popcnt_epi32( done_conflicts_v ) );
+#else
+               alignas( 64 ) uint32_t conflicts[ 16 ];
+               alignas( 64 ) uint32_t increments[ 16 ];
+               _mm512_store_si512( ( void * ) conflicts, done_conflicts_v );
+               for( size_t i = 0; i < 16; ++i ) {
+                  increments[ i ] = 1 + ( uint32_t ) __builtin_popcount( conflicts[ i ] );
+               }
+               increments_v = _mm512_load_si512( ( void const * ) increments );
+#endif
+            }
+            __m256i const slots_lo_v = _mm512_castsi512_si256( slots_v );
+            __m256i const slots_hi_v = _mm512_extracti64x4_epi64( slots_v, 1 );
+            __mmask8 const done_lo = ( __mmask8 ) done;
+            __mmask8 const done_hi = ( __mmask8 ) ( done >> 8 );
+            __m512i counts_lo_v = _mm512_mask_i32gather_epi64( zero_v, done_lo, slots_lo_v, key_count_container, 8 );
+            __m512i counts_hi_v = _mm512_mask_i32gather_epi64( zero_v, done_hi, slots_hi_v, key_count_container, 8 );
+            /* hit slots with a zero count are tombstones of the lane's key, lanes sharing a slot count it once */
+            __mmask16 const first = _mm512_mask_testn_epi32_mask( hit, done_conflicts_v, done_conflicts_v );
+            tombstone_count -= ( size_t ) __builtin_popcount( ( uint32_t ) first &
+               ( ( uint32_t ) _mm512_mask_testn_epi64_mask( done_lo, counts_lo_v, counts_lo_v ) |
+                 ( ( uint32_t ) _mm512_mask_testn_epi64_mask( done_hi, counts_hi_v, counts_hi_v ) << 8 ) ) );
+            counts_lo_v = _mm512_add_epi64( counts_lo_v, _mm512_cvtepu32_epi64( _mm512_castsi512_si256( increments_v ) ) );
+            counts_hi_v = _mm512_add_epi64( counts_hi_v, _mm512_cvtepu32_epi64( _mm512_extracti64x4_epi64( increments_v, 1 ) ) );
+            _mm512_mask_i32scatter_epi64( key_count_container, done_lo, slots_lo_v, counts_lo_v, 8 );
+            _mm512_mask_i32scatter_epi64( key_count_container, done_hi, slots_hi_v, counts_hi_v, 8 );
+
+            active &= ( __mmask16 ) ~done;
+            /* lanes which lost an empty slot to a preceding lane recheck it, it may hold their key now */
+            offsets_v = _mm512_mask_add_epi32( offsets_v, active & ( __mmask16 ) ~empty, offsets_v, one_v );
+         }
+      }
+#endif
 
 
 
@@ -351,10 +1085,17 @@ class const_sized_basic_histogramm {
          T loaded_key;
          size_t const base_hash = hash_fn( key );
          while( offset < container_size ) {
-            hashed_position = ( base_hash + offset ) % container_size;
+            hashed_position = slot_mapping( base_hash, offset );
             loaded_key = key_container[ hashed_position ];
-            if( loaded_key == key )
+            if( loaded_key == key ) {
+               HISTOGRAMM_STATISTICS_( statistics.record_lookup( offset ); )
                return hashed_position;
+            }
+            /* removed keys stay as tombstones, so an empty slot ends the probing sequence */
+            if( loaded_key == 0 ) {
+               HISTOGRAMM_STATISTICS_( statistics.record_lookup( offset ); )
+               break;
+            }
             ++offset;
          }
          return container_infinity_value;
@@ -363,24 +1104,18 @@ class const_sized_basic_histogramm {
          size_t offset = 0;
          size_t hashed_position;
          T loaded_key;
-         T base_hash = 0xcc9e2d51 * key;
-         base_hash = ( base_hash << 15 ) | ( base_hash >> 17 );
-         base_hash *= 0x1b873593;
-         base_hash = ( base_hash << 13 ) | ( base_hash >> 19 );
-         base_hash = base_hash * 5 + 0xe6546b64;
-         base_hash ^= 4;
-         base_hash ^= base_hash >> 16;
-         base_hash *= 0x85ebca6b;
-         base_hash ^= base_hash >> 13;
-         base_hash *= 0xc2b2ae35;
-         base_hash ^= base_hash >> 16;
+         size_t const base_hash = hash_fn( key );
          for( offset = 0; offset < container_size; offset++ ) {
-            hashed_position = ( base_hash + offset ) % container_size;
+            hashed_position = slot_mapping( base_hash, offset );
             loaded_key = key_container[ hashed_position ];
-            if( loaded_key == key )
+            if( loaded_key == key ) {
+               HISTOGRAMM_STATISTICS_( statistics.record_lookup( offset ); )
                return key_count_container[ hashed_position ];
-            if( loaded_key == 0 )
+            }
+            if( loaded_key == 0 ) {
+               HISTOGRAMM_STATISTICS_( statistics.record_lookup( offset ); )
                return 0;
+            }
          }
             return 0;
       }
@@ -403,12 +1138,16 @@ class const_sized_basic_histogramm {
             key = probe_keys[ probe_key_position ];
             size_t const base_hash = hash_fn( key );
             while( offset < container_size ) {
-               hashed_position = ( base_hash + offset ) % container_size;
+               hashed_position = slot_mapping( base_hash, offset );
                loaded_key = key_container[ hashed_position ];
                if( loaded_key == key ) {
                   probe_result[ result_position ] = key;
-                  probe_result_count[ result_position++ ] = key_count_container[ hashed_position ];
-                  ++result_position;
+                  probe_result_count[ result_position ] = key_count_container[ hashed_position ];
+                  result_position += ( key_count_container[ hashed_position ] != 0 ) ? 1 : 0;
+                  HISTOGRAMM_STATISTICS_( statistics.record_lookup( offset ); )
+                  break;
+               } else if( loaded_key == 0 ) {
+                  HISTOGRAMM_STATISTICS_( statistics.record_lookup( offset ); )
                   break;
                } else {
                   ++offset;
@@ -417,8 +1156,435 @@ class const_sized_basic_histogramm {
          }
          return result_position;
       }
+      /**
+       * Array probe with group prefetching: the slots of GroupSize keys are hashed and prefetched first and
+       * resolved afterwards, so the cache misses of a group overlap instead of stalling one key at a time.
+       * Writes one compact ( key, count ) pair per found key and returns the number of pairs.
+       */
+      template< size_t GroupSize = 16 >
+      size_t probe_grouped(   T const * const probe_keys, size_t const probe_keys_count,
+                              T * const probe_result, T * const probe_result_count ) const noexcept {
+         hash_t hashed_positions[ GroupSize ];
+         size_t base_positions[ GroupSize ];
+         size_t result_position = 0;
+#pragma _NEC novector
+         for( size_t group_start = 0; group_start < probe_keys_count; group_start += GroupSize ) {
+            size_t const group_size = std::min( GroupSize, probe_keys_count - group_start );
+            T const * const group_keys = probe_keys + group_start;
+            hash_fn.hash_batch( group_keys, group_size, hashed_positions );
+            for( size_t i = 0; i < group_size; ++i ) {
+               base_positions[ i ] = slot_mapping( hashed_positions[ i ], 0 );
+               PREFETCH_READ_( &key_container[ base_positions[ i ] ] );
+               PREFETCH_READ_( &key_count_container[ base_positions[ i ] ] );
+            }
+#pragma _NEC novector
+            for( size_t i = 0; i < group_size; ++i ) {
+               T const key = group_keys[ i ];
+               size_t hashed_position = base_positions[ i ];
+#pragma _NEC novector
+               for( size_t offset = 1; offset <= container_size; ++offset ) {
+                  T const loaded_key = key_container[ hashed_position ];
+                  if( loaded_key == key ) {
+                     probe_result[ result_position ] = key;
+                     probe_result_count[ result_position ] = key_count_container[ hashed_position ];
+                     result_position += ( key_count_container[ hashed_position ] != 0 ) ? 1 : 0;
+                     HISTOGRAMM_STATISTICS_( statistics.record_lookup( offset - 1 ); )
+                     break;
+                  }
+                  if( loaded_key == 0 ) {
+                     HISTOGRAMM_STATISTICS_( statistics.record_lookup( offset - 1 ); )
+                     break;
+                  }
+                  hashed_position = slot_mapping( hashed_positions[ i ], offset );
+               }
+            }
+         }
+         return result_position;
+      }
+      /**
+       * Slot of each of count keys, hashed with hash_batch and group prefetched like probe_grouped. Absent keys and
+       * tombstones get get_size( ) + 1.
+       */
+      template< size_t GroupSize = 16 >
+      void probe_slots( T const * const keys, size_t const count, size_t * const slots ) const noexcept {
+         hash_t hashes[ GroupSize ];
+#pragma _NEC novector
+         for( size_t group_start = 0; group_start < count; group_start += GroupSize ) {
+            size_t const group_size = std::min( GroupSize, count - group_start );
+            T const * const group_keys = keys + group_start;
+            size_t * const group_slots = slots + group_start;
+            hash_fn.hash_batch( group_keys, group_size, hashes );
+            for( size_t i = 0; i < group_size; ++i ) {
+               group_slots[ i ] = slot_mapping( hashes[ i ], 0 );
+               PREFETCH_READ_( &key_container[ group_slots[ i ] ] );
+               PREFETCH_READ_( &key_count_container[ group_slots[ i ] ] );
+            }
+#pragma _NEC novector
+            for( size_t i = 0; i < group_size; ++i ) {
+               T const key = group_keys[ i ];
+               size_t hashed_position = group_slots[ i ];
+               group_slots[ i ] = container_infinity_value;
+#pragma _NEC novector
+               for( size_t offset = 1; offset <= container_size; ++offset ) {
+                  T const loaded_key = key_container[ hashed_position ];
+                  if( loaded_key == key ) {
+                     group_slots[ i ] = ( key_count_container[ hashed_position ] != 0 ) ? hashed_position : container_infinity_value;
+                     HISTOGRAMM_STATISTICS_( statistics.record_lookup( offset - 1 ); )
+                     break;
+                  }
+                  if( loaded_key == 0 ) {
+                     HISTOGRAMM_STATISTICS_( statistics.record_lookup( offset - 1 ); )
+                     break;
+                  }
+                  hashed_position = slot_mapping( hashes[ i ], offset );
+               }
+            }
+         }
+      }
+      /**
+       * Batched removal for sliding window counts. decrement_batch lowers the count of every key occurrence by one,
+       * delete_batch drops the keys completely. A key whose count reaches zero stays in its slot as a tombstone
+       * ( key != 0, count == 0 ): probing sequences run over it, probes report it as absent and inserting the same key
+       * again revives it. Every build and merge path lowers tombstone_count when a count goes from zero to non zero, a
+       * slot it claims counts as a tombstone until its first increment. The builds do not reuse tombstones of other
+       * keys, so once they exceed compaction_threshold percent of the slots ( default 10 ) the call ends with
+       * compact( ). LoadFactor plus the threshold has to stay below 100, otherwise inserts can run out of empty slots
+       * before the next compaction.
+       * Both return the number of keys which were not found or already at zero.
+       */
+      size_t decrement_batch( T const * const keys, size_t const count ) noexcept {
+         return remove_batch< false >( keys, count );
+      }
+      size_t delete_batch( T const * const keys, size_t const count ) noexcept {
+         return remove_batch< true >( keys, count );
+      }
+      /**
+       * Folds other into this histogramm, the counts of keys contained in both are summed up. this needs room for the
+       * distinct keys of both. Tables of the same size use the same slots for a key unless it was displaced, so they
+       * are merged slot by slot: keys in the same slot in both tables are added with SIMD, only the rest is hashed
+       * and inserted. Otherwise all live keys of other are inserted. other is not changed.
+       */
+      void merge( const_sized_basic_histogramm const & other ) noexcept {
+         if( &other == this )
+            return;
+         size_t pending[ MERGE_BLOCK ];
+         bool const aligned = ( other.container_size == container_size );
+#pragma _NEC novector
+         for( size_t block_start = 0; block_start < ( size_t ) other.container_size; block_start += MERGE_BLOCK ) {
+            size_t const block_size = ( ( size_t ) other.container_size - block_start < MERGE_BLOCK ) ?
+               ( size_t ) other.container_size - block_start : MERGE_BLOCK;
+            size_t pending_count = 0;
+            if( aligned ) {
+               pending_count = merge_aligned_block(
+                  other, block_start, block_size, pending, std::integral_constant< bool, sizeof( T ) == sizeof( uint32_t ) >{ } );
+            } else {
+#pragma _NEC novector
+               for( size_t i = block_start; i < block_start + block_size; ++i ) {
+                  pending[ pending_count ] = i;
+                  pending_count += ( other.key_count_container[ i ] != 0 ) ? 1 : 0;
+               }
+            }
+            add_slots( other, pending, pending_count );
+         }
+      }
+      /* Reinserts all live keys into the emptied containers. Drops the tombstones and shortens the probing sequences. */
+      void compact( void ) noexcept {
+         size_t live_count = 0;
+         for( size_t position = 0; position < container_size; ++position ) {
+            live_count += ( key_count_container[ position ] != 0 ) ? 1 : 0;
+         }
+         T * const live_keys = new T[ live_count ];
+         uint64_t * const live_counts = new uint64_t[ live_count ];
+         size_t live_position = 0;
+#pragma _NEC novector
+         for( size_t position = 0; position < container_size; ++position ) {
+            if( key_count_container[ position ] != 0 ) {
+               live_keys[ live_position ] = key_container[ position ];
+               live_counts[ live_position++ ] = key_count_container[ position ];
+            }
+            key_container[ position ] = 0;
+            key_count_container[ position ] = 0;
+         }
+         hash_t hashes[ HASH_WINDOW ];
+#pragma _NEC novector
+         for( size_t chunk_start = 0; chunk_start < live_count; chunk_start += HASH_WINDOW ) {
+            size_t const chunk_size = ( live_count - chunk_start < HASH_WINDOW ) ? live_count - chunk_start : HASH_WINDOW;
+            hash_fn.hash_batch( live_keys + chunk_start, chunk_size, hashes );
+#pragma _NEC novector
+            for( size_t i = 0; i < chunk_size; ++i ) {
+               /* keys are distinct, the first empty slot is theirs */
+               size_t offset = 0;
+               size_t idx = slot_mapping( hashes[ i ], 0 );
+               while( key_container[ idx ] != 0 ) {
+                  idx = slot_mapping( hashes[ i ], ++offset );
+               }
+               key_container[ idx ] = live_keys[ chunk_start + i ];
+               key_count_container[ idx ] = live_counts[ chunk_start + i ];
+            }
+         }
+         delete[ ] live_counts;
+         delete[ ] live_keys;
+         container_distinct_count = live_count;
+         tombstone_count = 0;
+         HISTOGRAMM_STATISTICS_( statistics.occupied_slots = live_count; )
+      }
 
 };
 
+/**
+ * Histogram which starts with a small container and doubles it whenever the number of distinct keys exceeds the
+ * load factor. The rehash is done incrementally: after a resize the old container is kept and every insert migrates
+ * GROW_MIGRATION_STEP slots of it into the new one, so no single insert pays for a full rehash.
+ * Keys not yet migrated are counted in the old container. As there are no deletions, a key lives in exactly one
+ * of both containers at any time.
+ * The batch builds work on the current container only. While a migration is in progress keys are inserted
+ * elementwise, afterwards the 256-lane batch is used on chunks which fit into the current container.
+ * LoadFactor has to stay below 100: the container only grows after an insert exceeded the limit, and probing for a
+ * new key needs an empty slot in the current and in the old container.
+ */
+template< typename T, class SlotMapping = slot_mapping_modulo >
+class growable_basic_histogramm {
+   private:
+      static constexpr size_t GROW_MIGRATION_STEP = 16;
+      static constexpr size_t GROW_BATCH_LANES = 256;
+      static constexpr size_t GROW_MIN_CONTAINER_SIZE = 1024;
+
+      size_t      const LoadFactor;
+      SlotMapping       slot_mapping;
+      size_t            container_size;
+      size_t            container_max_distinct_count;
+      size_t            container_distinct_count;
+      T              *  key_container;
+      uint64_t       *  key_count_container;
+      SlotMapping       old_slot_mapping;
+      size_t            old_container_size;
+      size_t            old_migration_position;
+      T              *  old_key_container;
+      uint64_t       *  old_key_count_container;
+      murmur3< T > const     hash_fn;
+
+      /* Returns the slot holding key or the first empty slot of its probe sequence. */
+      size_t find_slot( T const * const container, SlotMapping const & mapping, T const key ) const noexcept {
+         size_t const size = mapping.get_size( );
+         size_t hashed_position = mapping( hash_fn( key ), 0 );
+#pragma _NEC novector
+         while( ( container[ hashed_position ] != key ) && ( container[ hashed_position ] != 0 ) ) {
+            if( ++hashed_position == size )
+               hashed_position = 0;
+         }
+         return hashed_position;
+      }
+      void migrate_step( size_t step ) noexcept {
+         size_t const end = std::min( old_migration_position + step, old_container_size );
+#pragma _NEC novector
+         for( ; old_migration_position < end; ++old_migration_position ) {
+            T const key = old_key_container[ old_migration_position ];
+            if( key != 0 ) {
+               size_t const idx = find_slot( key_container, slot_mapping, key );
+               key_container[ idx ] = key;
+               key_count_container[ idx ] = old_key_count_container[ old_migration_position ];
+            }
+         }
+         if( old_migration_position == old_container_size ) {
+            delete[ ] old_key_count_container;
+            delete[ ] old_key_container;
+            old_key_count_container = nullptr;
+            old_key_container = nullptr;
+            old_container_size = 0;
+            old_migration_position = 0;
+         }
+      }
+      void grow( void ) noexcept {
+         if( old_key_container != nullptr )
+            migrate_step( old_container_size );
+         old_slot_mapping = slot_mapping;
+         old_container_size = container_size;
+         old_migration_position = 0;
+         old_key_container = key_container;
+         old_key_count_container = key_count_container;
+         slot_mapping = SlotMapping{ container_size * 2 };
+         container_size = slot_mapping.get_size( );
+         container_max_distinct_count = container_size * LoadFactor / 100;
+         key_container = new T[ container_size ]( );
+         key_count_container = new uint64_t[ container_size ]( );
+      }
+      void insert_elem( T const key ) noexcept {
+         size_t idx = find_slot( key_container, slot_mapping, key );
+         if( key_container[ idx ] == key ) {
+            key_count_container[ idx ]++;
+         } else {
+            size_t old_idx = 0;
+            if( old_key_container != nullptr ) {
+               old_idx = find_slot( old_key_container, old_slot_mapping, key );
+            }
+            if( ( old_key_container != nullptr ) && ( old_key_container[ old_idx ] == key ) ) {
+               old_key_count_container[ old_idx ]++;
+            } else {
+               key_container[ idx ] = key;
+               key_count_container[ idx ] = 1;
+               ++container_distinct_count;
+            }
+         }
+         if( old_key_container != nullptr )
+            migrate_step( GROW_MIGRATION_STEP );
+         if( container_distinct_count > container_max_distinct_count )
+            grow( );
+      }
+      /* Number of keys the next batch chunk may contain without exceeding the load factor. A small headroom
+       * triggers a resize, so the batch is not starved by a container which is just below its limit. */
+      size_t batch_headroom( void ) noexcept {
+         if( container_max_distinct_count < container_distinct_count + GROW_BATCH_LANES )
+            grow( );
+         return container_max_distinct_count - container_distinct_count;
+      }
+      template< bool Vectorized >
+      void insert_batch( T const * const keys, size_t const count ) noexcept {
+         size_t key_positions[ GROW_BATCH_LANES ];
+         size_t hashed_positions[ GROW_BATCH_LANES ];
+         T gathered_elements[ GROW_BATCH_LANES ];
+         size_t offsets[ GROW_BATCH_LANES ];
+         size_t processable_elements = 0;
+         size_t max_position = GROW_BATCH_LANES - 1;
+#pragma _NEC vreg(key_positions)
+#pragma _NEC vreg(gathered_elements)
+         for( size_t i = 0; i < GROW_BATCH_LANES; ++i ) {
+            key_positions[ i ] = i;
+            hashed_positions[ i ] = 0;
+            offsets[ i ] = 0;
+            if( i < count )
+               ++processable_elements;
+         }
+         while( processable_elements > 0 ) {
+            for( size_t i = 0; i < GROW_BATCH_LANES; ++i ) {
+               if( key_positions[ i ] < count ) {
+                  hashed_positions[ i ] = slot_mapping( hash_fn( keys[ key_positions[ i ] ] ), offsets[ i ] );
+                  gathered_elements[ i ] = key_container[ hashed_positions[ i ] ];
+               }
+            }
+            if( Vectorized ) {
+#pragma _NEC ivdep
+#pragma _NEC move
+               for( size_t i = 0; i < GROW_BATCH_LANES; ++i ) {
+                  if( ( key_positions[ i ] < count ) && ( gathered_elements[ i ] == 0 ) ) {
+                     key_container[ hashed_positions[ i ] ] = keys[ key_positions[ i ] ];
+                  }
+               }
+            } else {
+#pragma _NEC novector
+               for( size_t i = 0; i < GROW_BATCH_LANES; ++i ) {
+                  if( ( key_positions[ i ] < count ) && ( gathered_elements[ i ] == 0 ) ) {
+                     key_container[ hashed_positions[ i ] ] = keys[ key_positions[ i ] ];
+                  }
+               }
+            }
+            processable_elements = 0;
+#pragma _NEC novector
+            for( size_t i = 0; i < GROW_BATCH_LANES; ++i ) {
+               if( key_positions[ i ] < count ) {
+                  if( key_container[ hashed_positions[ i ] ] == keys[ key_positions[ i ] ] ) {
+                     /* a slot is counted as distinct key exactly once, when its count leaves zero */
+                     if( key_count_container[ hashed_positions[ i ] ]++ == 0 )
+                        ++container_distinct_count;
+                     offsets[ i ] = 0;
+                     key_positions[ i ] = ++max_position;
+                  } else {
+                     offsets[ i ]++;
+                  }
+                  if( key_positions[ i ] < count )
+                     ++processable_elements;
+               }
+            }
+         }
+      }
+      template< bool Vectorized >
+      void build_batch( T const * const keys, size_t const count ) noexcept {
+         size_t position = 0;
+#pragma _NEC novector
+         while( position < count ) {
+            if( old_key_container != nullptr ) {
+               insert_elem( keys[ position++ ] );
+            } else {
+               size_t const chunk = std::min( count - position, batch_headroom( ) );
+               if( old_key_container == nullptr ) {
+                  insert_batch< Vectorized >( keys + position, chunk );
+                  position += chunk;
+               }
+            }
+         }
+      }
+   public:
+      growable_basic_histogramm( uint32_t _LoadFactor, size_t _InitialSize = GROW_MIN_CONTAINER_SIZE ):
+         LoadFactor{ _LoadFactor },
+         slot_mapping{ ( _InitialSize > GROW_MIN_CONTAINER_SIZE ) ? _InitialSize : GROW_MIN_CONTAINER_SIZE },
+         container_size{ slot_mapping.get_size( ) },
+         container_max_distinct_count{ container_size * LoadFactor / 100 },
+         container_distinct_count{ 0 },
+         key_container{ new T[ container_size ]( ) },
+         key_count_container{ new uint64_t[ container_size ]( ) },
+         old_slot_mapping{ slot_mapping },
+         old_container_size{ 0 },
+         old_migration_position{ 0 },
+         old_key_container{ nullptr },
+         old_key_count_container{ nullptr } {
+         assert( _LoadFactor > 0 && _LoadFactor < 100 );
+      }
+      virtual ~growable_basic_histogramm( void ) noexcept {
+         delete[ ] old_key_count_container;
+         delete[ ] old_key_container;
+         delete[ ] key_count_container;
+         delete[ ] key_container;
+      }
+      size_t get_size( void ) const noexcept {
+         return container_size + old_container_size;
+      }
+      size_t get_count( void ) const noexcept {
+         size_t result = 0;
+         for( size_t position = 0; position < container_size; ++position ) {
+            result += ( size_t ) key_count_container[ position ];
+         }
+         for( size_t position = old_migration_position; position < old_container_size; ++position ) {
+            result += ( size_t ) old_key_count_container[ position ];
+         }
+         return result;
+      }
+      size_t key_count( void ) const noexcept {
+         return container_distinct_count;
+      }
+      bool is_migrating( void ) const noexcept {
+         return old_key_container != nullptr;
+      }
+      void build_scalar_elem( T const * const keys, size_t const count ) noexcept {
+#pragma _NEC novector
+         for( size_t keys_position = 0; keys_position < count; ++keys_position ) {
+            insert_elem( keys[ keys_position ] );
+         }
+      }
+      void build_vectorized_elem( T const * const keys, size_t const count ) noexcept {
+         for( size_t keys_position = 0; keys_position < count; ++keys_position ) {
+            insert_elem( keys[ keys_position ] );
+         }
+      }
+      void build_scalar_batch( T const * const keys, size_t const count ) noexcept {
+         build_batch< false >( keys, count );
+      }
+      void build_vectorized_batch( T const * const keys, size_t const count ) noexcept {
+         build_batch< true >( keys, count );
+      }
+      uint64_t probe_count_vectorized( T key ) const noexcept {
+         size_t idx = find_slot( key_container, slot_mapping, key );
+         if( key_container[ idx ] == key )
+            return key_count_container[ idx ];
+         if( old_key_container != nullptr ) {
+            idx = find_slot( old_key_container, old_slot_mapping, key );
+            if( old_key_container[ idx ] == key )
+               return old_key_count_container[ idx ];
+         }
+         return 0;
+      }
+      size_t get_count( T key ) const noexcept {
+         return probe_count_vectorized( key );
+      }
+};
+
 
 #endif //GENERAL_HASH_SET_H
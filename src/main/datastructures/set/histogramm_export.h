@@ -0,0 +1,307 @@
+/**
+ * @file histogramm_export.h
+ * @brief Export of a histogramm into dense ( key, count ) arrays, in slot order or sorted by key.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_HISTOGRAMM_EXPORT_H
+#define GENERAL_HISTOGRAMM_EXPORT_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <pthread.h>
+#include "hash_set.h"
+#include "../../../utils/vector.h"
+#include "../../../utils/threading.h"
+
+/**
+ * The export runs in two steps, both split over up to thread_count threads:
+ *    1. compaction: every thread counts the live slots ( count != 0, so empty slots and tombstones are dropped ) of
+ *       its share of the slots, the prefix sum over the threads gives its write offset, then it writes the live
+ *       ( key, count ) pairs of its share densely. With AVX-512 a mask of 8 ( 16 ) live slots is taken from the
+ *       counts and the pairs are written with compress stores, otherwise a scalar loop copies the live pairs.
+ *    2. optional sort: LSD radix sort on the key, 8 bits per pass. Every thread counts the digits of its share of
+ *       the pairs, the offsets are taken over ( digit, thread ), so the scatter keeps the order of equal digits and
+ *       the sort is stable. A pass in which all keys share the digit ( e.g. the high bytes of small keys ) is
+ *       skipped. The sort needs a scratch copy of the pairs.
+ * The histogramm is only read, so mapped histogramms can be exported as well.
+ */
+template< typename T >
+struct histogramm_compaction_context {
+   T        const * key_container;
+   uint64_t const * count_container;
+   size_t           begin;
+   size_t           end;
+   T              * keys;
+   uint64_t       * counts;
+   size_t           offset;
+   size_t           live;
+};
+
+template< typename T >
+struct histogramm_radix_context {
+   T        const * source_keys;
+   uint64_t const * source_counts;
+   T              * target_keys;
+   uint64_t       * target_counts;
+   size_t           begin;
+   size_t           end;
+   size_t           shift;
+   size_t           buckets[ 256 ];
+};
+
+static size_t const HISTOGRAMM_EXPORT_MIN_SHARE = 4096;
+
+inline size_t histogramm_count_live_slots( uint64_t const * const count_container, size_t const begin, size_t const end ) noexcept {
+   size_t live = 0;
+   size_t position = begin;
+#ifdef __AVX512F__
+#pragma _NEC novector
+   for( ; position + 8 <= end; position += 8 ) {
+      __m512i const counts_v = _mm512_loadu_si512( ( void const * ) ( count_container + position ) );
+      live += ( size_t ) __builtin_popcount( ( unsigned ) _mm512_test_epi64_mask( counts_v, counts_v ) );
+   }
+#endif
+   for( ; position < end; ++position ) {
+      live += ( count_container[ position ] != 0 ) ? 1 : 0;
+   }
+   return live;
+}
+
+template< typename T >
+size_t histogramm_compact_scalar( T const * const key_container, uint64_t const * const count_container, size_t const begin,
+                                  size_t const end, T * const keys, uint64_t * const counts ) noexcept {
+   size_t written = 0;
+#pragma _NEC novector
+   for( size_t position = begin; position < end; ++position ) {
+      /* no write behind the live pairs, the next share of the output belongs to another thread */
+      if( count_container[ position ] != 0 ) {
+         keys[ written ] = key_container[ position ];
+         counts[ written ] = count_container[ position ];
+         ++written;
+      }
+   }
+   return written;
+}
+
+#ifdef __AVX512F__
+inline size_t histogramm_compact_avx512( uint32_t const * const key_container, uint64_t const * const count_container,
+                                         size_t const begin, size_t const end, uint32_t * const keys,
+                                         uint64_t * const counts ) noexcept {
+   size_t written = 0;
+   size_t position = begin;
+#pragma _NEC novector
+   for( ; position + 16 <= end; position += 16 ) {
+      __m512i const counts_lo_v = _mm512_loadu_si512( ( void const * ) ( count_container + position ) );
+      __m512i const counts_hi_v = _mm512_loadu_si512( ( void const * ) ( count_container + position + 8 ) );
+      __mmask8 const live_lo = _mm512_test_epi64_mask( counts_lo_v, counts_lo_v );
+      __mmask8 const live_hi = _mm512_test_epi64_mask( counts_hi_v, counts_hi_v );
+      __mmask16 const live = ( __mmask16 ) ( ( unsigned ) live_lo | ( ( unsigned ) live_hi << 8 ) );
+      if( live == 0 )
+         continue;
+      _mm512_mask_compressstoreu_epi32( keys + written, live,
+                                        _mm512_loadu_si512( ( void const * ) ( key_container + position ) ) );
+      _mm512_mask_compressstoreu_epi64( counts + written, live_lo, counts_lo_v );
+      size_t const written_lo = ( size_t ) __builtin_popcount( ( unsigned ) live_lo );
+      _mm512_mask_compressstoreu_epi64( counts + written + written_lo, live_hi, counts_hi_v );
+      written += written_lo + ( size_t ) __builtin_popcount( ( unsigned ) live_hi );
+   }
+   return written + histogramm_compact_scalar( key_container, count_container, position, end, keys + written, counts + written );
+}
+inline size_t histogramm_compact_avx512( uint64_t const * const key_container, uint64_t const * const count_container,
+                                         size_t const begin, size_t const end, uint64_t * const keys,
+                                         uint64_t * const counts ) noexcept {
+   size_t written = 0;
+   size_t position = begin;
+#pragma _NEC novector
+   for( ; position + 8 <= end; position += 8 ) {
+      __m512i const counts_v = _mm512_loadu_si512( ( void const * ) ( count_container + position ) );
+      __mmask8 const live = _mm512_test_epi64_mask( counts_v, counts_v );
+      if( live == 0 )
+         continue;
+      _mm512_mask_compressstoreu_epi64( keys + written, live, _mm512_loadu_si512( ( void const * ) ( key_container + position ) ) );
+      _mm512_mask_compressstoreu_epi64( counts + written, live, counts_v );
+      written += ( size_t ) __builtin_popcount( ( unsigned ) live );
+   }
+   return written + histogramm_compact_scalar( key_container, count_container, position, end, keys + written, counts + written );
+}
+#endif
+
+/* writes the live ( key, count ) pairs of the slots [ begin, end ) densely to keys / counts, returns their number */
+template< typename T >
+size_t histogramm_compact( T const * const key_container, uint64_t const * const count_container, size_t const begin,
+                           size_t const end, T * const keys, uint64_t * const counts ) noexcept {
+#ifdef __AVX512F__
+   return histogramm_compact_avx512( key_container, count_container, begin, end, keys, counts );
+#else
+   return histogramm_compact_scalar( key_container, count_container, begin, end, keys, counts );
+#endif
+}
+
+template< typename T >
+void * histogramm_count_live_share( void * ctx_ ) {
+   histogramm_compaction_context< T > * ctx = ( histogramm_compaction_context< T > * ) ctx_;
+   ctx->live = histogramm_count_live_slots( ctx->count_container, ctx->begin, ctx->end );
+   return ( void * ) nullptr;
+}
+
+template< typename T >
+void * histogramm_compact_share( void * ctx_ ) {
+   histogramm_compaction_context< T > * ctx = ( histogramm_compaction_context< T > * ) ctx_;
+   histogramm_compact( ctx->key_container, ctx->count_container, ctx->begin, ctx->end, ctx->keys + ctx->offset,
+                       ctx->counts + ctx->offset );
+   return ( void * ) nullptr;
+}
+
+template< typename T >
+void * histogramm_radix_count_share( void * ctx_ ) {
+   histogramm_radix_context< T > * ctx = ( histogramm_radix_context< T > * ) ctx_;
+   /* local copies, the compiler can not prove that ctx is not written through the key pointers */
+   T const * const source_keys = ctx->source_keys;
+   size_t const shift = ctx->shift;
+   size_t buckets[ 256 ] = { };
+#pragma _NEC novector
+   for( size_t i = ctx->begin; i < ctx->end; ++i ) {
+      ++buckets[ ( size_t ) ( source_keys[ i ] >> shift ) & 0xFF ];
+   }
+   std::memcpy( ( void * ) ctx->buckets, ( void const * ) buckets, sizeof( buckets ) );
+   return ( void * ) nullptr;
+}
+
+/* buckets hold the write positions of the share per digit */
+template< typename T >
+void * histogramm_radix_scatter_share( void * ctx_ ) {
+   histogramm_radix_context< T > * ctx = ( histogramm_radix_context< T > * ) ctx_;
+   T const * const source_keys = ctx->source_keys;
+   uint64_t const * const source_counts = ctx->source_counts;
+   T * const target_keys = ctx->target_keys;
+   uint64_t * const target_counts = ctx->target_counts;
+   size_t const shift = ctx->shift;
+   size_t buckets[ 256 ];
+   std::memcpy( ( void * ) buckets, ( void const * ) ctx->buckets, sizeof( buckets ) );
+#pragma _NEC novector
+   for( size_t i = ctx->begin; i < ctx->end; ++i ) {
+      T const key = source_keys[ i ];
+      size_t const target = buckets[ ( size_t ) ( key >> shift ) & 0xFF ]++;
+      target_keys[ target ] = key;
+      target_counts[ target ] = source_counts[ i ];
+   }
+   return ( void * ) nullptr;
+}
+
+/* runs function on contexts[ 0, thread_count ), on the calling thread if there is only one */
+template< class Context >
+void histogramm_export_run( void * ( * const function )( void * ), Context * const contexts, size_t const thread_count ) {
+   if( thread_count == 1 ) {
+      function( ( void * ) &contexts[ 0 ] );
+      return;
+   }
+   posix_thread threads[ MAX_THREAD_COUNT ];
+   for( size_t t = 0; t < thread_count; ++t ) {
+      pthread_create(   threads[ t ].get_thread_ptr( ),
+                        threads[ t ].get_attribute( ),
+                        function,
+                        ( void * ) &contexts[ t ]
+      );
+   }
+   for( size_t t = 0; t < thread_count; ++t ) {
+      pthread_join( threads[ t ].get_thread( ), NULL );
+   }
+}
+
+/* threads for count elements, every thread gets at least HISTOGRAMM_EXPORT_MIN_SHARE of them */
+inline size_t histogramm_export_threads( size_t const count, size_t const thread_count ) noexcept {
+   size_t const useful = ( count + HISTOGRAMM_EXPORT_MIN_SHARE - 1 ) / HISTOGRAMM_EXPORT_MIN_SHARE;
+   return ( useful < 1 ) ? 1 : ( ( useful < thread_count ) ? useful : thread_count );
+}
+
+/* stable LSD radix sort of the pairs by key, scratch_keys / scratch_counts have to hold count pairs */
+template< typename T >
+void histogramm_radix_sort( T * const keys, uint64_t * const counts, size_t const count, T * const scratch_keys,
+                            uint64_t * const scratch_counts, size_t const thread_count ) {
+   assert( thread_count > 0 && thread_count <= MAX_THREAD_COUNT );
+   size_t const used_threads = histogramm_export_threads( count, thread_count );
+   histogramm_radix_context< T > contexts[ MAX_THREAD_COUNT ];
+   T * source_keys = keys;
+   uint64_t * source_counts = counts;
+   T * target_keys = scratch_keys;
+   uint64_t * target_counts = scratch_counts;
+   size_t const share = ( count + used_threads - 1 ) / used_threads;
+   for( size_t shift = 0; shift < sizeof( T ) * 8; shift += 8 ) {
+      for( size_t t = 0; t < used_threads; ++t ) {
+         size_t const begin = ( t * share < count ) ? t * share : count;
+         contexts[ t ].source_keys = source_keys;
+         contexts[ t ].source_counts = source_counts;
+         contexts[ t ].target_keys = target_keys;
+         contexts[ t ].target_counts = target_counts;
+         contexts[ t ].begin = begin;
+         contexts[ t ].end = ( begin + share < count ) ? begin + share : count;
+         contexts[ t ].shift = shift;
+      }
+      histogramm_export_run( &histogramm_radix_count_share< T >, contexts, used_threads );
+      size_t position = 0;
+      bool single_digit = false;
+      for( size_t digit = 0; digit < 256; ++digit ) {
+         size_t digit_count = 0;
+         for( size_t t = 0; t < used_threads; ++t ) {
+            size_t const bucket = contexts[ t ].buckets[ digit ];
+            contexts[ t ].buckets[ digit ] = position;
+            position += bucket;
+            digit_count += bucket;
+         }
+         single_digit |= ( digit_count == count );
+      }
+      if( single_digit )
+         continue;
+      histogramm_export_run( &histogramm_radix_scatter_share< T >, contexts, used_threads );
+      T * const swap_keys = source_keys;
+      uint64_t * const swap_counts = source_counts;
+      source_keys = target_keys;
+      source_counts = target_counts;
+      target_keys = swap_keys;
+      target_counts = swap_counts;
+   }
+   if( source_keys != keys ) {
+      std::memcpy( ( void * ) keys, ( void const * ) source_keys, count * sizeof( T ) );
+      std::memcpy( ( void * ) counts, ( void const * ) source_counts, count * sizeof( uint64_t ) );
+   }
+}
+
+/**
+ * Writes the ( key, count ) pairs of all keys in histogramm to keys / counts, which have to hold key_count( ) pairs,
+ * and returns their number. Without sorted they come in slot order, with sorted ordered by key.
+ */
+template< typename T, class SlotMapping, class HashFunction, class Allocation >
+size_t export_histogramm( const_sized_basic_histogramm< T, SlotMapping, HashFunction, Allocation > const & histogramm,
+                          T * const keys, uint64_t * const counts, bool const sorted = false, size_t const thread_count = 1 ) {
+   assert( thread_count > 0 && thread_count <= MAX_THREAD_COUNT );
+   size_t const size = ( size_t ) histogramm.get_size( );
+   size_t const used_threads = histogramm_export_threads( size, thread_count );
+   histogramm_compaction_context< T > contexts[ MAX_THREAD_COUNT ];
+   size_t const share = ( size + used_threads - 1 ) / used_threads;
+   for( size_t t = 0; t < used_threads; ++t ) {
+      size_t const begin = ( t * share < size ) ? t * share : size;
+      contexts[ t ] = { histogramm.get_key_container( ), histogramm.get_key_count_container( ), begin,
+                        ( begin + share < size ) ? begin + share : size, keys, counts, 0, 0 };
+   }
+   histogramm_export_run( &histogramm_count_live_share< T >, contexts, used_threads );
+   size_t exported = 0;
+   for( size_t t = 0; t < used_threads; ++t ) {
+      contexts[ t ].offset = exported;
+      exported += contexts[ t ].live;
+   }
+   histogramm_export_run( &histogramm_compact_share< T >, contexts, used_threads );
+   if( sorted && ( exported > 1 ) ) {
+      T * const scratch_keys = new T[ exported ];
+      uint64_t * const scratch_counts = new uint64_t[ exported ];
+      histogramm_radix_sort( keys, counts, exported, scratch_keys, scratch_counts, thread_count );
+      delete[ ] scratch_counts;
+      delete[ ] scratch_keys;
+   }
+   return exported;
+}
+
+#endif //GENERAL_HISTOGRAMM_EXPORT_H
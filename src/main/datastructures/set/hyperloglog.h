@@ -0,0 +1,227 @@
+/**
+ * @file hyperloglog.h
+ * @brief HyperLogLog distinct count sketch over the murmur3 hash of the histogramms.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_HYPERLOGLOG_H
+#define GENERAL_HYPERLOGLOG_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include "../../algorithms/hash/murmur3.h"
+#include "../../../utils/vector.h"
+
+/**
+ * HyperLogLog with 2^Precision registers of one byte. The top Precision bits of the hash select the register, the
+ * rank (position of the first set bit) of the remaining bits is max-ed into it. estimate() is the harmonic mean
+ * estimator with linear counting for small cardinalities and, for 32-bit hashes, the large range correction
+ * (HLL++ bias tables are not used, the error is about 1.04 / sqrt( 2^Precision ) over the whole range).
+ * The keys are hashed with hash_batch of HashFunction, the same hashes address the slots of
+ * const_sized_basic_histogramm, so the sketch of a column is available for sizing the table before it is built.
+ * build() computes register index and rank of 16 (8) hashes at once with AVX-512 CD lzcnt, the byte wide max into
+ * the registers stays scalar (there is no byte scatter, and colliding registers need no conflict handling that way).
+ * Sketches with the same Precision merge by register-wise maximum, e.g. per-thread sketches over disjoint chunks
+ * merge into the sketch of the whole input.
+ */
+template< typename T, class HashFunction = murmur3< T > >
+class hyperloglog {
+   public:
+      typedef typename HashFunction::hash_type hash_t;
+      static constexpr size_t MIN_PRECISION = 4;
+      static constexpr size_t MAX_PRECISION = 18;
+      static constexpr size_t HASH_BITS = sizeof( hash_t ) * 8;
+   private:
+      static constexpr size_t BUILD_HASH_CHUNK = 256;
+      size_t         const precision;
+      size_t         const register_count;
+      uint8_t     *  const registers;
+      HashFunction   const hash_fn;
+
+      static size_t clamp_precision( size_t const _Precision ) noexcept {
+         return ( _Precision < MIN_PRECISION ) ? MIN_PRECISION : ( ( _Precision > MAX_PRECISION ) ? MAX_PRECISION : _Precision );
+      }
+      static inline size_t leading_zeros( uint32_t const word ) noexcept {
+         return ( size_t ) __builtin_clz( word );
+      }
+      static inline size_t leading_zeros( uint64_t const word ) noexcept {
+         return ( size_t ) __builtin_clzll( word );
+      }
+      inline uint8_t rank_of( hash_t const hash ) const noexcept {
+         hash_t const remaining = ( hash_t ) ( hash << precision );
+         /* all remaining bits zero: rank of the first bit behind the hash */
+         return ( uint8_t ) ( ( remaining == 0 ) ? HASH_BITS - precision + 1 : leading_zeros( remaining ) + 1 );
+      }
+      inline size_t index_of( hash_t const hash ) const noexcept {
+         return ( size_t ) ( hash >> ( HASH_BITS - precision ) );
+      }
+      inline void update( size_t const index, uint8_t const rank ) noexcept {
+         registers[ index ] = ( registers[ index ] < rank ) ? rank : registers[ index ];
+      }
+      void update_scalar( hash_t const * const hashes, size_t const count ) noexcept {
+#pragma _NEC novector
+         for( size_t i = 0; i < count; ++i ) {
+            update( index_of( hashes[ i ] ), rank_of( hashes[ i ] ) );
+         }
+      }
+#if defined( __AVX512F__ ) && defined( __AVX512CD__ )
+      void update_avx512( uint32_t const * const hashes, size_t const count ) noexcept {
+         uint32_t indexes[ 16 ];
+         uint8_t ranks[ 16 ];
+         __m128i const shift_v = _mm_cvtsi32_si128( ( int ) precision );
+         __m128i const index_shift_v = _mm_cvtsi32_si128( ( int ) ( HASH_BITS - precision ) );
+         __m512i const one_v = _mm512_set1_epi32( 1 );
+         __m512i const max_rank_v = _mm512_set1_epi32( ( int ) ( HASH_BITS - precision + 1 ) );
+         for( size_t i = 0; i < count; i += 16 ) {
+            size_t const lanes = ( count - i < 16 ) ? count - i : 16;
+            __mmask16 const load_mask = ( __mmask16 ) ( ( 1U << lanes ) - 1 );
+            __m512i const hash_v = _mm512_maskz_loadu_epi32( load_mask, hashes + i );
+            /* lzcnt( 0 ) is 32, the minimum caps it to the rank of the first bit behind the hash */
+            __m512i const rank_v = _mm512_min_epu32(
+               _mm512_add_epi32( _mm512_lzcnt_epi32( _mm512_sll_epi32( hash_v, shift_v ) ), one_v ), max_rank_v );
+            _mm512_storeu_si512( ( void * ) indexes, _mm512_srl_epi32( hash_v, index_shift_v ) );
+            _mm_storeu_si128( ( __m128i * ) ranks, _mm512_cvtepi32_epi8( rank_v ) );
+#pragma _NEC novector
+            for( size_t lane = 0; lane < lanes; ++lane ) {
+               update( indexes[ lane ], ranks[ lane ] );
+            }
+         }
+      }
+      void update_avx512( uint64_t const * const hashes, size_t const count ) noexcept {
+         uint32_t indexes[ 8 ];
+         uint8_t ranks[ 16 ];
+         __m128i const shift_v = _mm_cvtsi32_si128( ( int ) precision );
+         __m128i const index_shift_v = _mm_cvtsi32_si128( ( int ) ( HASH_BITS - precision ) );
+         __m512i const one_v = _mm512_set1_epi64( 1 );
+         __m512i const max_rank_v = _mm512_set1_epi64( ( long long ) ( HASH_BITS - precision + 1 ) );
+         for( size_t i = 0; i < count; i += 8 ) {
+            size_t const lanes = ( count - i < 8 ) ? count - i : 8;
+            __mmask8 const load_mask = ( __mmask8 ) ( ( 1U << lanes ) - 1 );
+            __m512i const hash_v = _mm512_maskz_loadu_epi64( load_mask, hashes + i );
+            __m512i const rank_v = _mm512_min_epu64(
+               _mm512_add_epi64( _mm512_lzcnt_epi64( _mm512_sll_epi64( hash_v, shift_v ) ), one_v ), max_rank_v );
+            _mm256_storeu_si256( ( __m256i * ) indexes, _mm512_cvtepi64_epi32( _mm512_srl_epi64( hash_v, index_shift_v ) ) );
+            _mm_storeu_si128( ( __m128i * ) ranks, _mm512_cvtepi64_epi8( rank_v ) );
+#pragma _NEC novector
+            for( size_t lane = 0; lane < lanes; ++lane ) {
+               update( indexes[ lane ], ranks[ lane ] );
+            }
+         }
+      }
+#endif
+      void update_dispatch( hash_t const * const hashes, size_t const count ) noexcept {
+#if defined( __AVX512F__ ) && defined( __AVX512CD__ )
+         update_avx512( hashes, count );
+#else
+         update_scalar( hashes, count );
+#endif
+      }
+   public:
+      hyperloglog( size_t _Precision = 14 ):
+         precision{ clamp_precision( _Precision ) },
+         register_count{ ( size_t ) 1 << precision },
+         registers{ new uint8_t[ register_count ]( ) } {
+      }
+      hyperloglog( hyperloglog const & ) = delete;
+      hyperloglog & operator=( hyperloglog const & ) = delete;
+      virtual ~hyperloglog( void ) noexcept {
+         delete[ ] registers;
+      }
+      size_t get_precision( void ) const noexcept {
+         return precision;
+      }
+      size_t get_register_count( void ) const noexcept {
+         return register_count;
+      }
+      uint8_t const * get_registers( void ) const noexcept {
+         return registers;
+      }
+      size_t get_memory_footprint( void ) const noexcept {
+         return register_count;
+      }
+      /* relative standard error of estimate( ) */
+      double get_standard_error( void ) const noexcept {
+         return 1.04 / std::sqrt( ( double ) register_count );
+      }
+      void clear( void ) noexcept {
+         for( size_t i = 0; i < register_count; ++i ) {
+            registers[ i ] = 0;
+         }
+      }
+      inline void insert_hash( hash_t const hash ) noexcept {
+         update( index_of( hash ), rank_of( hash ) );
+      }
+      void insert( T const key ) noexcept {
+         insert_hash( hash_fn( key ) );
+      }
+      void build_scalar( T const * const keys, size_t const count ) noexcept {
+#pragma _NEC novector
+         for( size_t i = 0; i < count; ++i ) {
+            insert_hash( hash_fn( keys[ i ] ) );
+         }
+      }
+      /* adds keys to the sketch, may be called for any number of chunks */
+      void build( T const * const keys, size_t const count ) noexcept {
+         hash_t hashes[ BUILD_HASH_CHUNK ];
+#pragma _NEC novector
+         for( size_t chunk_start = 0; chunk_start < count; chunk_start += BUILD_HASH_CHUNK ) {
+            size_t const chunk_size = ( count - chunk_start < BUILD_HASH_CHUNK ) ? count - chunk_start : BUILD_HASH_CHUNK;
+            hash_fn.hash_batch( keys + chunk_start, chunk_size, hashes );
+            update_dispatch( hashes, chunk_size );
+         }
+      }
+      /* register-wise maximum, returns false ( and leaves this sketch untouched ) if the precisions differ */
+      bool merge( hyperloglog const & other ) noexcept {
+         if( other.precision != precision )
+            return false;
+         size_t position = 0;
+#if defined( __AVX512BW__ )
+#pragma _NEC novector
+         for( ; position + 64 <= register_count; position += 64 ) {
+            _mm512_storeu_si512( ( void * ) ( registers + position ), _mm512_max_epu8(
+               _mm512_loadu_si512( ( void const * ) ( registers + position ) ),
+               _mm512_loadu_si512( ( void const * ) ( other.registers + position ) ) ) );
+         }
+#elif defined( __AVX2__ )
+#pragma _NEC novector
+         for( ; position + 32 <= register_count; position += 32 ) {
+            _mm256_storeu_si256( ( __m256i * ) ( registers + position ), _mm256_max_epu8(
+               _mm256_loadu_si256( ( __m256i const * ) ( registers + position ) ),
+               _mm256_loadu_si256( ( __m256i const * ) ( other.registers + position ) ) ) );
+         }
+#endif
+         for( ; position < register_count; ++position ) {
+            update( position, other.registers[ position ] );
+         }
+         return true;
+      }
+      double estimate( void ) const noexcept {
+         double const m = ( double ) register_count;
+         double const alpha = ( register_count == 16 ) ? 0.673 : ( ( register_count == 32 ) ? 0.697 :
+                              ( ( register_count == 64 ) ? 0.709 : 0.7213 / ( 1.0 + 1.079 / m ) ) );
+         double sum = 0.0;
+         size_t zero_registers = 0;
+         for( size_t i = 0; i < register_count; ++i ) {
+            sum += std::ldexp( 1.0, -( int ) registers[ i ] );
+            zero_registers += ( registers[ i ] == 0 ) ? 1 : 0;
+         }
+         double const raw = alpha * m * m / sum;
+         if( ( raw <= 2.5 * m ) && ( zero_registers != 0 ) )
+            return m * std::log( m / ( double ) zero_registers );
+         if( HASH_BITS == 32 ) {
+            /* 32-bit hashes collide noticeably beyond 2^32 / 30 distinct keys */
+            double const hash_range = 4294967296.0;
+            if( raw > hash_range / 30.0 )
+               return -hash_range * std::log( 1.0 - raw / hash_range );
+         }
+         return raw;
+      }
+      /* estimate plus Sigmas standard errors, a safe ElementCount for a histogramm which is built from the keys */
+      size_t estimate_upper_bound( double const _Sigmas = 4.0 ) const noexcept {
+         return ( size_t ) std::ceil( estimate( ) * ( 1.0 + _Sigmas * get_standard_error( ) ) );
+      }
+};
+
+#endif //GENERAL_HYPERLOGLOG_H
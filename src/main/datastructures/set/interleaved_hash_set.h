@@ -0,0 +1,281 @@
+/**
+ * @file interleaved_hash_set.h
+ * @brief Histogram with keys and narrow counters interleaved in cache line sized buckets.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_INTERLEAVED_HASH_SET_H
+#define GENERAL_INTERLEAVED_HASH_SET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include "../../algorithms/hash/murmur3.h"
+#include "slot_mapping.h"
+#include "../../../utils/vector.h"
+
+/**
+ * Layout variant of const_sized_basic_histogramm. The slots are grouped into buckets of one cache line, every bucket
+ * holds BUCKET_SLOTS keys followed by their counters, so a hit touches a single cache line. Slot s lives in bucket
+ * s / BUCKET_SLOTS, the probing sequence is the same as in const_sized_basic_histogramm.
+ * Counters are CountT wide. A counter which reached the maximum of CountT stays there and further increments of
+ * that slot are accumulated in an overflow side table, which is only touched by very frequent keys.
+ */
+template< typename T, typename CountT = uint32_t, class SlotMapping = slot_mapping_modulo >
+class interleaved_basic_histogramm {
+   public:
+      static constexpr size_t CACHE_LINE_SIZE = 64;
+      static constexpr size_t BUCKET_SLOTS = CACHE_LINE_SIZE / ( sizeof( T ) + sizeof( CountT ) );
+   private:
+      static constexpr size_t BATCH_LANES = 256;
+      static constexpr CountT COUNT_MAX = std::numeric_limits< CountT >::max( );
+
+      struct alignas( CACHE_LINE_SIZE ) bucket {
+         T        keys[ BUCKET_SLOTS ];
+         CountT   counts[ BUCKET_SLOTS ];
+      };
+      static_assert( sizeof( bucket ) == CACHE_LINE_SIZE, "A bucket has to fill exactly one cache line." );
+
+      T           const ElementCount;
+      T           const LoadFactor;
+      SlotMapping const slot_mapping;
+      size_t      const container_size;
+      size_t      const container_infinity_value;
+      size_t      const bucket_count;
+      size_t            container_distinct_count;
+      uint8_t  *  const bucket_storage;
+      bucket   *  const buckets;
+      std::unordered_map< size_t, uint64_t > overflow_counts;
+      murmur3< T > const     hash_fn;
+
+      static bucket * align_buckets( uint8_t * const storage ) noexcept {
+         return ( bucket * ) ( ( ( uintptr_t ) storage + CACHE_LINE_SIZE - 1 ) & ~( ( uintptr_t ) CACHE_LINE_SIZE - 1 ) );
+      }
+      inline T & key_at( size_t const slot ) const noexcept {
+         return buckets[ slot / BUCKET_SLOTS ].keys[ slot % BUCKET_SLOTS ];
+      }
+      inline CountT & count_at( size_t const slot ) const noexcept {
+         return buckets[ slot / BUCKET_SLOTS ].counts[ slot % BUCKET_SLOTS ];
+      }
+      inline uint64_t count_of( size_t const slot ) const noexcept {
+         uint64_t const count = count_at( slot );
+         if( count != COUNT_MAX )
+            return count;
+         auto const overflow = overflow_counts.find( slot );
+         return ( overflow == overflow_counts.end( ) ) ? count : count + overflow->second;
+      }
+      /* returns true if the slot was counted for the first time */
+      inline bool increment( size_t const slot ) {
+         CountT & count = count_at( slot );
+         if( count == COUNT_MAX ) {
+            overflow_counts[ slot ]++;
+            return false;
+         }
+         return ( count++ == 0 );
+      }
+      template< bool Vectorized >
+      void build_batch( T const * const keys ) {
+         size_t key_positions[ BATCH_LANES ];
+         size_t hashed_positions[ BATCH_LANES ];
+         T gathered_elements[ BATCH_LANES ];
+         size_t offsets[ BATCH_LANES ];
+         size_t processable_elements = 0;
+         size_t max_position = BATCH_LANES - 1;
+#pragma _NEC vreg(key_positions)
+#pragma _NEC vreg(gathered_elements)
+         for( size_t i = 0; i < BATCH_LANES; ++i ) {
+            key_positions[ i ] = i;
+            hashed_positions[ i ] = 0;
+            offsets[ i ] = 0;
+            if( i < ElementCount )
+               ++processable_elements;
+         }
+         while( processable_elements > 0 ) {
+            for( size_t i = 0; i < BATCH_LANES; ++i ) {
+               if( key_positions[ i ] < ElementCount ) {
+                  hashed_positions[ i ] = slot_mapping( hash_fn( keys[ key_positions[ i ] ] ), offsets[ i ] );
+                  gathered_elements[ i ] = key_at( hashed_positions[ i ] );
+               }
+            }
+            if( Vectorized ) {
+#pragma _NEC ivdep
+#pragma _NEC move
+               for( size_t i = 0; i < BATCH_LANES; ++i ) {
+                  if( ( key_positions[ i ] < ElementCount ) && ( gathered_elements[ i ] == 0 ) ) {
+                     key_at( hashed_positions[ i ] ) = keys[ key_positions[ i ] ];
+                  }
+               }
+            } else {
+#pragma _NEC novector
+               for( size_t i = 0; i < BATCH_LANES; ++i ) {
+                  if( ( key_positions[ i ] < ElementCount ) && ( gathered_elements[ i ] == 0 ) ) {
+                     key_at( hashed_positions[ i ] ) = keys[ key_positions[ i ] ];
+                  }
+               }
+            }
+            processable_elements = 0;
+#pragma _NEC novector
+            for( size_t i = 0; i < BATCH_LANES; ++i ) {
+               if( key_positions[ i ] < ElementCount ) {
+                  if( key_at( hashed_positions[ i ] ) == keys[ key_positions[ i ] ] ) {
+                     if( increment( hashed_positions[ i ] ) )
+                        ++container_distinct_count;
+                     offsets[ i ] = 0;
+                     key_positions[ i ] = ++max_position;
+                  } else {
+                     offsets[ i ]++;
+                  }
+                  if( key_positions[ i ] < ElementCount )
+                     ++processable_elements;
+               }
+            }
+         }
+      }
+   public:
+      interleaved_basic_histogramm( uint32_t _ElemCount, uint32_t _LoadFactor ):
+         ElementCount{ _ElemCount },
+         LoadFactor{ _LoadFactor },
+         slot_mapping{ ( size_t ) ElementCount * 100 / LoadFactor },
+         container_size{ slot_mapping.get_size( ) },
+         container_infinity_value{ container_size + 1 },
+         bucket_count{ ( container_size + BUCKET_SLOTS - 1 ) / BUCKET_SLOTS },
+         container_distinct_count{ 0 },
+         bucket_storage{ new uint8_t[ bucket_count * CACHE_LINE_SIZE + CACHE_LINE_SIZE - 1 ]( ) },
+         buckets{ align_buckets( bucket_storage ) } {
+      }
+      virtual ~interleaved_basic_histogramm( void ) noexcept {
+         delete[ ] bucket_storage;
+      }
+      size_t get_size( void ) const noexcept {
+         return container_size;
+      }
+      /* bytes of the bucket array, without the overflow side table */
+      size_t get_memory_footprint( void ) const noexcept {
+         return bucket_count * CACHE_LINE_SIZE;
+      }
+      size_t get_overflow_count( void ) const noexcept {
+         return overflow_counts.size( );
+      }
+      size_t get_count( void ) const noexcept {
+         size_t result = 0;
+         for( size_t position = 0; position < container_size; ++position ) {
+            result += ( size_t ) count_at( position );
+         }
+         for( auto const & overflow : overflow_counts ) {
+            result += ( size_t ) overflow.second;
+         }
+         return result;
+      }
+      size_t key_count( void ) const noexcept {
+         size_t result = 0;
+         for( size_t position = 0; position < container_size; ++position ) {
+            if( key_at( position ) != 0 )
+               ++result;
+         }
+         return result;
+      }
+      void build_scalar_elem( T const * const keys ) {
+#pragma _NEC novector
+         for( size_t keys_position = 0; keys_position < ElementCount; ++keys_position ) {
+            T const key = keys[ keys_position ];
+            size_t const hashed_position = hash_fn( key );
+#pragma _NEC novector
+            for( size_t offset = 0; offset < container_size; ++offset ) {
+               size_t const idx = slot_mapping( hashed_position, offset );
+               T const loaded_key = key_at( idx );
+               if( loaded_key == 0 ) {
+                  key_at( idx ) = key;
+                  ++container_distinct_count;
+               }
+               if( loaded_key == 0 || loaded_key == key ) {
+                  increment( idx );
+                  break;
+               }
+            }
+         }
+      }
+      void build_vectorized_elem( T const * const keys ) {
+         size_t offset_zero, offset_equal, idx_zero, idx_equal;
+         bool found;
+         for( size_t keys_position = 0; keys_position < ElementCount; ++keys_position ) {
+            T const key = keys[ keys_position ];
+            size_t const hashed_position = hash_fn( key );
+            found = false;
+            idx_zero = 0;
+            idx_equal = 0;
+            for( offset_zero = 0; offset_zero < container_size; offset_zero++ ) {
+               idx_zero = slot_mapping( hashed_position, offset_zero );
+               if( key_at( idx_zero ) == 0 ) {
+                  break;
+               }
+            }
+            for( offset_equal = 0; offset_equal < offset_zero; offset_equal++ ) {
+               idx_equal = slot_mapping( hashed_position, offset_equal );
+               if( key_at( idx_equal ) == key ) {
+                  found = true;
+                  break;
+               }
+            }
+            size_t idx = idx_equal;
+            if( !found ) {
+               key_at( idx_zero ) = key;
+               idx = idx_zero;
+               ++container_distinct_count;
+            }
+            increment( idx );
+         }
+      }
+      void build_scalar_batch( T const * const keys ) {
+         build_batch< false >( keys );
+      }
+      void build_vectorized_batch( T const * const keys ) {
+         build_batch< true >( keys );
+      }
+      size_t probe( T key ) const noexcept {
+         size_t const base_hash = hash_fn( key );
+         for( size_t offset = 0; offset < container_size; ++offset ) {
+            size_t const hashed_position = slot_mapping( base_hash, offset );
+            T const loaded_key = key_at( hashed_position );
+            if( loaded_key == key )
+               return hashed_position;
+            if( loaded_key == 0 )
+               break;
+         }
+         return container_infinity_value;
+      }
+      uint64_t probe_count_vectorized( T key ) const noexcept {
+         size_t const base_hash = hash_fn( key );
+         for( size_t offset = 0; offset < container_size; offset++ ) {
+            size_t const hashed_position = slot_mapping( base_hash, offset );
+            T const loaded_key = key_at( hashed_position );
+            if( loaded_key == key )
+               return count_of( hashed_position );
+            if( loaded_key == 0 )
+               return 0;
+         }
+         return 0;
+      }
+      size_t get_count( T key ) const noexcept {
+         size_t position_in_container = probe( key );
+         if( position_in_container < container_infinity_value )
+            return count_of( position_in_container );
+         return 0;
+      }
+      size_t probe(  T const * const probe_keys, size_t const probe_keys_count,
+                     T * const probe_result, T * const probe_result_count ) const noexcept {
+         size_t result_position = 0;
+         for( size_t probe_key_position = 0; probe_key_position < probe_keys_count; ++probe_key_position ) {
+            T const key = probe_keys[ probe_key_position ];
+            size_t const position_in_container = probe( key );
+            if( position_in_container < container_infinity_value ) {
+               probe_result[ result_position ] = key;
+               probe_result_count[ result_position++ ] = count_of( position_in_container );
+            }
+         }
+         return result_position;
+      }
+};
+
+#endif //GENERAL_INTERLEAVED_HASH_SET_H
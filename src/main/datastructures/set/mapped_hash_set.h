@@ -0,0 +1,203 @@
+/**
+ * @file mapped_hash_set.h
+ * @brief On-disk format of const_sized_basic_histogramm which is probed directly from a read-only mapping.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_MAPPED_HASH_SET_H
+#define GENERAL_MAPPED_HASH_SET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "hash_set.h"
+
+/**
+ * File layout (native byte order, the header is checked on load):
+ *
+ *    [ 0, HEADER_SIZE )                      histogramm_file_header, zero padded
+ *    [ key_offset, key_offset + n * sizeof( T ) ) key_container
+ *    [ count_offset, count_offset + n * 8 )  key_count_container
+ *
+ * with n = container_size. Both containers start on a page boundary, so they are usable in place once mapped.
+ * policy_fingerprint is derived from HashFunction and SlotMapping, a file written with other policies (or another
+ * seed) would place keys at other slots and is rejected. Bump HISTOGRAMM_FILE_VERSION on every layout change.
+ */
+struct histogramm_file_header {
+   char     magic[ 8 ];
+   uint32_t version;
+   uint32_t byte_order;
+   uint32_t key_size;
+   uint32_t count_size;
+   uint64_t element_count;
+   uint64_t load_factor;
+   uint64_t container_size;
+   uint64_t distinct_count;
+   uint64_t tombstone_count;
+   uint64_t policy_fingerprint;
+   uint64_t key_offset;
+   uint64_t count_offset;
+   uint64_t file_size;
+};
+
+static char     const HISTOGRAMM_FILE_MAGIC[ 8 ] = { 'T', 'S', 'B', 'H', 'I', 'S', 'T', 'O' };
+static uint32_t const HISTOGRAMM_FILE_VERSION = 2;
+static uint32_t const HISTOGRAMM_FILE_BYTE_ORDER = 0x01020304;
+static size_t   const HISTOGRAMM_FILE_ALIGNMENT = 4096;
+
+inline size_t histogramm_file_align( size_t const offset ) noexcept {
+   return ( offset + HISTOGRAMM_FILE_ALIGNMENT - 1 ) & ~( HISTOGRAMM_FILE_ALIGNMENT - 1 );
+}
+
+/* slots of a few fixed keys under the given policies */
+template< typename T, class SlotMapping, class HashFunction >
+uint64_t histogramm_policy_fingerprint( uint64_t const element_count, uint64_t const load_factor ) noexcept {
+   static T const keys[ 4 ] = { ( T ) 1, ( T ) 2, ( T ) 0x9e3779b9U, ( T ) ~( T ) 0 };
+   HashFunction const hash_fn{ };
+   SlotMapping const slot_mapping{ ( size_t ) ( element_count * 100 / load_factor ) };
+   uint64_t result = sizeof( T );
+   for( size_t i = 0; i < 4; ++i ) {
+      result = result * 0x100000001b3ULL ^ ( uint64_t ) hash_fn( keys[ i ] );
+      result = result * 0x100000001b3ULL ^ ( uint64_t ) slot_mapping( hash_fn( keys[ i ] ), 1 );
+   }
+   return result;
+}
+
+inline bool histogramm_file_write( int const fd, void const * const data, size_t const size ) noexcept {
+   char const * position = ( char const * ) data;
+   size_t remaining = size;
+   while( remaining > 0 ) {
+      ssize_t const written = ::write( fd, position, remaining );
+      if( written <= 0 )
+         return false;
+      position += written;
+      remaining -= ( size_t ) written;
+   }
+   return true;
+}
+
+/* Writes histogramm to path in the format above. Returns false if the file could not be written completely. The
+ * allocation policy is not part of the format, a file is always mapped back with the default one. */
+template< typename T, class SlotMapping, class HashFunction, class Allocation >
+bool save_histogramm( const_sized_basic_histogramm< T, SlotMapping, HashFunction, Allocation > const & histogramm,
+                      char const * const path ) noexcept {
+   histogramm_file_header header;
+   std::memset( &header, 0, sizeof( header ) );
+   std::memcpy( header.magic, HISTOGRAMM_FILE_MAGIC, sizeof( header.magic ) );
+   header.version = HISTOGRAMM_FILE_VERSION;
+   header.byte_order = HISTOGRAMM_FILE_BYTE_ORDER;
+   header.key_size = sizeof( T );
+   header.count_size = sizeof( uint64_t );
+   header.element_count = histogramm.get_element_count( );
+   header.load_factor = histogramm.get_load_factor( );
+   header.container_size = histogramm.get_size( );
+   header.distinct_count = histogramm.key_count( );
+   header.tombstone_count = histogramm.get_tombstone_count( );
+   header.policy_fingerprint =
+      histogramm_policy_fingerprint< T, SlotMapping, HashFunction >( header.element_count, header.load_factor );
+   header.key_offset = histogramm_file_align( sizeof( header ) );
+   header.count_offset = histogramm_file_align( header.key_offset + header.container_size * sizeof( T ) );
+   header.file_size = header.count_offset + header.container_size * sizeof( uint64_t );
+
+   int const fd = ::open( path, O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+   if( fd < 0 )
+      return false;
+   static char const padding[ HISTOGRAMM_FILE_ALIGNMENT ] = { };
+   bool written = histogramm_file_write( fd, &header, sizeof( header ) );
+   written = written && histogramm_file_write( fd, padding, header.key_offset - sizeof( header ) );
+   written = written && histogramm_file_write( fd, histogramm.get_key_container( ), header.container_size * sizeof( T ) );
+   written = written && histogramm_file_write(
+      fd, padding, header.count_offset - header.key_offset - header.container_size * sizeof( T ) );
+   written = written && histogramm_file_write(
+      fd, histogramm.get_key_count_container( ), header.container_size * sizeof( uint64_t ) );
+   return ( ::close( fd ) == 0 ) && written;
+}
+
+/**
+ * Read-only histogramm on top of a file written by save_histogramm. The file is mapped and the containers are used in
+ * place, opening costs a few system calls regardless of the table size and pages are faulted in by the probes.
+ * A missing, truncated or mismatching file leaves the object invalid, is_valid( ) has to be checked before
+ * get_histogramm( ) is used.
+ */
+template< typename T, class SlotMapping = slot_mapping_modulo, class HashFunction = murmur3< T > >
+class mapped_histogramm {
+   private:
+      typedef const_sized_basic_histogramm< T, SlotMapping, HashFunction > histogramm_t;
+
+      void         *  mapping;
+      size_t          mapping_size;
+      histogramm_t *  histogramm;
+
+      bool header_matches( histogramm_file_header const & header, size_t const file_size ) const noexcept {
+         if( ( std::memcmp( header.magic, HISTOGRAMM_FILE_MAGIC, sizeof( header.magic ) ) != 0 ) ||
+             ( header.version != HISTOGRAMM_FILE_VERSION ) || ( header.byte_order != HISTOGRAMM_FILE_BYTE_ORDER ) ||
+             ( header.key_size != sizeof( T ) ) || ( header.count_size != sizeof( uint64_t ) ) ||
+             ( header.load_factor == 0 ) || ( header.file_size != file_size ) )
+            return false;
+         if( ( header.key_offset % HISTOGRAMM_FILE_ALIGNMENT != 0 ) || ( header.count_offset % HISTOGRAMM_FILE_ALIGNMENT != 0 ) ||
+             ( header.key_offset < sizeof( header ) ) ||
+             ( header.key_offset + header.container_size * sizeof( T ) > header.count_offset ) ||
+             ( header.count_offset + header.container_size * sizeof( uint64_t ) > file_size ) )
+            return false;
+         if( SlotMapping{ ( size_t ) ( header.element_count * 100 / header.load_factor ) }.get_size( ) != header.container_size )
+            return false;
+         if( header.distinct_count + header.tombstone_count > header.container_size )
+            return false;
+         return header.policy_fingerprint ==
+                histogramm_policy_fingerprint< T, SlotMapping, HashFunction >( header.element_count, header.load_factor );
+      }
+   public:
+      mapped_histogramm( char const * const path ):
+         mapping{ nullptr },
+         mapping_size{ 0 },
+         histogramm{ nullptr } {
+         int const fd = ::open( path, O_RDONLY );
+         if( fd < 0 )
+            return;
+         struct stat file_stat;
+         if( ( ::fstat( fd, &file_stat ) != 0 ) || ( ( size_t ) file_stat.st_size < sizeof( histogramm_file_header ) ) ) {
+            ::close( fd );
+            return;
+         }
+         void * const file = ::mmap( nullptr, ( size_t ) file_stat.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+         ::close( fd );
+         if( file == MAP_FAILED )
+            return;
+         mapping = file;
+         mapping_size = ( size_t ) file_stat.st_size;
+         histogramm_file_header const & header = *( histogramm_file_header const * ) mapping;
+         if( !header_matches( header, mapping_size ) )
+            return;
+         /* probes jump randomly through the containers, read ahead only wastes I/O */
+         ::madvise( mapping, mapping_size, MADV_RANDOM );
+         /* the containers are never written through, const_sized_basic_histogramm only lacks a const variant */
+         histogramm = new histogramm_t(
+            ( uint32_t ) header.element_count, ( uint32_t ) header.load_factor,
+            ( T * ) ( ( char * ) mapping + header.key_offset ),
+            ( uint64_t * ) ( ( char * ) mapping + header.count_offset ),
+            ( size_t ) header.distinct_count, ( size_t ) header.tombstone_count );
+      }
+      mapped_histogramm( mapped_histogramm const & ) = delete;
+      mapped_histogramm & operator=( mapped_histogramm const & ) = delete;
+      virtual ~mapped_histogramm( void ) noexcept {
+         delete histogramm;
+         if( mapping != nullptr )
+            ::munmap( mapping, mapping_size );
+      }
+      bool is_valid( void ) const noexcept {
+         return histogramm != nullptr;
+      }
+      histogramm_t const & get_histogramm( void ) const noexcept {
+         return *histogramm;
+      }
+      size_t get_file_size( void ) const noexcept {
+         return mapping_size;
+      }
+};
+
+#endif //GENERAL_MAPPED_HASH_SET_H
@@ -0,0 +1,78 @@
+/**
+ * @file parallel_merge.h
+ * @brief Parallel tree merge of thread local histogramms.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_PARALLEL_MERGE_H
+#define GENERAL_PARALLEL_MERGE_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <pthread.h>
+#include <vector>
+#include "hash_set.h"
+#include "../../../utils/threading.h"
+
+template< class Histogramm >
+struct tree_merge_context {
+   Histogramm ** parts;
+   size_t count;
+   size_t stride;
+   size_t thread_id;
+   size_t thread_count;
+};
+
+/* merges parts[ i + stride ] into parts[ i ] for every pair of this round which belongs to the thread */
+template< class Histogramm >
+void * tree_merge_pairs( void * ctx_ ) {
+   tree_merge_context< Histogramm > * ctx = ( tree_merge_context< Histogramm > * ) ctx_;
+   size_t pair = 0;
+   for( size_t i = 0; i + ctx->stride < ctx->count; i += 2 * ctx->stride, ++pair ) {
+      if( pair % ctx->thread_count == ctx->thread_id )
+         ctx->parts[ i ]->merge( *ctx->parts[ i + ctx->stride ] );
+   }
+   return ( void * ) nullptr;
+}
+
+/**
+ * Merges count histogramms in log2( count ) rounds. In every round pairs ( i, i + stride ) are merged into i by up to
+ * thread_count threads, so the merge work per round is spread over the threads instead of folding everything into
+ * one table sequentially. The result is parts[ 0 ], which is returned; the other parts hold partial results and can
+ * be freed. parts[ i ] has to hold the distinct keys of parts[ i .. i + 2^k ) it absorbs, the simplest is to give
+ * all parts the size of the merged result, which also lets merge( ) use its slot by slot path.
+ */
+template< class Histogramm >
+Histogramm * tree_merge_histogramms( Histogramm ** const parts, size_t const count, size_t const thread_count ) {
+   assert( thread_count > 0 && thread_count <= MAX_THREAD_COUNT );
+   if( count == 0 )
+      return nullptr;
+   posix_thread threads[ MAX_THREAD_COUNT ];
+   std::vector< tree_merge_context< Histogramm > > contexts( thread_count );
+   for( size_t stride = 1; stride < count; stride *= 2 ) {
+      size_t const pair_count = ( count - stride + 2 * stride - 1 ) / ( 2 * stride );
+      size_t const round_threads = ( pair_count < thread_count ) ? pair_count : thread_count;
+      for( size_t t = 0; t < round_threads; ++t ) {
+         contexts[ t ] = { parts, count, stride, t, round_threads };
+      }
+      if( round_threads == 1 ) {
+         tree_merge_pairs< Histogramm >( ( void * ) &contexts[ 0 ] );
+         continue;
+      }
+      for( size_t t = 0; t < round_threads; ++t ) {
+         pthread_create(   threads[ t ].get_thread_ptr( ),
+                           threads[ t ].get_attribute( ),
+                           &tree_merge_pairs< Histogramm >,
+                           ( void * ) &contexts[ t ]
+         );
+      }
+      for( size_t t = 0; t < round_threads; ++t ) {
+         pthread_join( threads[ t ].get_thread( ), NULL );
+      }
+   }
+   return parts[ 0 ];
+}
+
+#endif //GENERAL_PARALLEL_MERGE_H
@@ -0,0 +1,255 @@
+/**
+ * @file partitioned_hash_set.h
+ * @brief Multi-threaded histogram build on radix partitioned keys.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_PARTITIONED_HASH_SET_H
+#define GENERAL_PARTITIONED_HASH_SET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <pthread.h>
+#include <algorithm>
+#include <vector>
+#include "hash_set.h"
+#include "../../../utils/vector.h"
+#include "../../../utils/threading.h"
+
+/**
+ * Histogram which is built by up to MAX_THREAD_COUNT threads without any synchronization on the hash containers.
+ * The build runs in three phases, each thread works on an even chunk of the input:
+ *    1. every thread counts how many of its keys fall into each of the 2^PartitionBits partitions,
+ *    2. every thread scatters its keys into its private range of every partition,
+ *    3. the partitions are distributed round robin over the threads, each builds a private
+ *       const_sized_basic_histogramm per partition.
+ * The partition is taken from the upper bits of a murmur3 hash with a dedicated seed. The sub histograms hash with
+ * the default seed, so the partitioning does not correlate with the slot mapping inside a partition.
+ */
+template< typename T, class SlotMapping = slot_mapping_modulo >
+class partitioned_basic_histogramm {
+   private:
+      typedef const_sized_basic_histogramm< T, SlotMapping > histogramm_t;
+      typedef void ( histogramm_t::*build_fn_t )( T const * const );
+      typedef void * ( *thread_fn_t )( void * );
+
+      static constexpr uint32_t PARTITION_SEED = 0x9747b28c;
+      static constexpr size_t PARTITION_HASH_CHUNK = 256;
+
+      struct context {
+         partitioned_basic_histogramm * self;
+         size_t thread_id;
+         size_t thread_count;
+         T const * base_addr;
+         size_t count;
+         build_fn_t build_fn;
+      };
+
+      size_t      const ElementCount;
+      uint32_t    const LoadFactor;
+      uint32_t    const PartitionBits;
+      size_t      const partition_count;
+      size_t         *  partition_histogram;
+      size_t         *  partition_offsets;
+      size_t         *  partition_start;
+      T              *  partitioned_keys;
+      histogramm_t  **  partitions;
+      murmur3< T > const     partition_hash_fn;
+
+      inline size_t partition_of_hash( typename murmur3< T >::hash_type const hash ) const noexcept {
+         return ( size_t ) ( ( uint32_t ) hash >> ( 32 - PartitionBits ) );
+      }
+      inline size_t get_partition( T const key ) const noexcept {
+         return partition_of_hash( partition_hash_fn( key ) );
+      }
+
+      static void * count_partitions( void * ctx_ ) {
+         context * ctx = ( context * ) ctx_;
+         partitioned_basic_histogramm * self = ctx->self;
+         /* counted thread locally, the histograms of neighbouring threads share cache lines */
+         std::vector< size_t > histogram( self->partition_count, 0 );
+         T const * keys = ctx->base_addr;
+         typename murmur3< T >::hash_type hashes[ PARTITION_HASH_CHUNK ];
+         for( size_t chunk_start = 0; chunk_start < ctx->count; chunk_start += PARTITION_HASH_CHUNK ) {
+            size_t const chunk_size = ( ctx->count - chunk_start < PARTITION_HASH_CHUNK ) ? ctx->count - chunk_start : PARTITION_HASH_CHUNK;
+            self->partition_hash_fn.hash_batch( keys + chunk_start, chunk_size, hashes );
+            for( size_t i = 0; i < chunk_size; ++i ) {
+               histogram[ self->partition_of_hash( hashes[ i ] ) ]++;
+            }
+         }
+         std::copy( histogram.begin( ), histogram.end( ), self->partition_histogram + ( ctx->thread_id * self->partition_count ) );
+         return ( void * ) nullptr;
+      }
+      static void * scatter_partitions( void * ctx_ ) {
+         context * ctx = ( context * ) ctx_;
+         partitioned_basic_histogramm * self = ctx->self;
+         size_t const * const shared_offsets = self->partition_offsets + ( ctx->thread_id * self->partition_count );
+         std::vector< size_t > offsets( shared_offsets, shared_offsets + self->partition_count );
+         T const * keys = ctx->base_addr;
+         T * const target = self->partitioned_keys;
+         typename murmur3< T >::hash_type hashes[ PARTITION_HASH_CHUNK ];
+         for( size_t chunk_start = 0; chunk_start < ctx->count; chunk_start += PARTITION_HASH_CHUNK ) {
+            size_t const chunk_size = ( ctx->count - chunk_start < PARTITION_HASH_CHUNK ) ? ctx->count - chunk_start : PARTITION_HASH_CHUNK;
+            self->partition_hash_fn.hash_batch( keys + chunk_start, chunk_size, hashes );
+            for( size_t i = 0; i < chunk_size; ++i ) {
+               target[ offsets[ self->partition_of_hash( hashes[ i ] ) ]++ ] = keys[ chunk_start + i ];
+            }
+         }
+         return ( void * ) nullptr;
+      }
+      static void * build_partitions( void * ctx_ ) {
+         context * ctx = ( context * ) ctx_;
+         partitioned_basic_histogramm * self = ctx->self;
+         size_t const partition_count = self->partition_count;
+         size_t const thread_count = ctx->thread_count;
+         for( size_t partition = ctx->thread_id; partition < partition_count; partition += thread_count ) {
+            size_t const begin = self->partition_start[ partition ];
+            size_t const count = self->partition_start[ partition + 1 ] - begin;
+            /* an empty partition still gets a container, so probing it needs no special case */
+            histogramm_t * histogramm = new histogramm_t( ( count > 0 ) ? count : 1, self->LoadFactor );
+            if( count > 0 )
+               ( histogramm->*( ctx->build_fn ) )( self->partitioned_keys + begin );
+            self->partitions[ partition ] = histogramm;
+         }
+         return ( void * ) nullptr;
+      }
+      /* thread i is pinned to the i-th allowed cpu like in run_on_even_chunks, a context whose thread could not be
+       * created is run by the caller */
+      void run_threads( std::vector< context > & contexts, thread_fn_t method ) {
+         posix_thread threads[ MAX_THREAD_COUNT ];
+         bool started[ MAX_THREAD_COUNT ];
+         std::vector< int32_t > const cpus = allowed_cpus( );
+         for( size_t i = 0; i < contexts.size( ); ++i ) {
+            if( !cpus.empty( ) )
+               threads[ i ].pin_to_cpu( cpus[ i % cpus.size( ) ] );
+            started[ i ] = ( pthread_create(   threads[ i ].get_thread_ptr( ),
+                                               threads[ i ].get_attribute( ),
+                                               method,
+                                               ( void * ) &contexts[ i ]
+                             ) == 0 );
+            if( !started[ i ] )
+               method( ( void * ) &contexts[ i ] );
+         }
+         for( size_t i = 0; i < contexts.size( ); ++i ) {
+            if( started[ i ] )
+               pthread_join( threads[ i ].get_thread( ), NULL );
+         }
+      }
+      void clear( void ) noexcept {
+         for( size_t i = 0; i < partition_count; ++i ) {
+            delete partitions[ i ];
+            partitions[ i ] = nullptr;
+         }
+      }
+      void build( T const * const keys, size_t thread_count, build_fn_t build_fn ) {
+         assert( thread_count > 0 && thread_count <= MAX_THREAD_COUNT );
+         clear( );
+         partition_manager_even_chunks< T const > part_manager{ keys, ElementCount };
+         part_manager.set_thread_count( thread_count );
+         std::vector< context > contexts( thread_count );
+         for( size_t i = 0; i < thread_count; ++i ) {
+            std::pair< T const *, size_t > chunk = part_manager.get_chunk_with_size( i );
+            contexts[ i ] = { this, i, thread_count, chunk.first, chunk.second, build_fn };
+         }
+         for( size_t i = 0; i < thread_count * partition_count; ++i ) {
+            partition_histogram[ i ] = 0;
+         }
+         run_threads( contexts, &partitioned_basic_histogramm::count_partitions );
+
+         /* exclusive prefix sum, partition major: partition p holds the ranges of thread 0, 1, ... */
+         size_t offset = 0;
+         for( size_t p = 0; p < partition_count; ++p ) {
+            partition_start[ p ] = offset;
+            for( size_t t = 0; t < thread_count; ++t ) {
+               partition_offsets[ t * partition_count + p ] = offset;
+               offset += partition_histogram[ t * partition_count + p ];
+            }
+         }
+         partition_start[ partition_count ] = offset;
+         run_threads( contexts, &partitioned_basic_histogramm::scatter_partitions );
+         run_threads( contexts, &partitioned_basic_histogramm::build_partitions );
+      }
+   public:
+      partitioned_basic_histogramm( size_t _ElemCount, uint32_t _LoadFactor, uint32_t _PartitionBits = 6 ):
+         ElementCount{ _ElemCount },
+         LoadFactor{ _LoadFactor },
+         PartitionBits{ _PartitionBits },
+         partition_count{ ( size_t ) 1 << _PartitionBits },
+         partition_histogram{ new size_t[ MAX_THREAD_COUNT * partition_count ]( ) },
+         partition_offsets{ new size_t[ MAX_THREAD_COUNT * partition_count ]( ) },
+         partition_start{ new size_t[ partition_count + 1 ]( ) },
+         partitioned_keys{ new T[ _ElemCount ] },
+         partitions{ new histogramm_t*[ partition_count ]( ) },
+         partition_hash_fn{ PARTITION_SEED } {
+         assert( _PartitionBits > 0 && _PartitionBits < 32 );
+      }
+      virtual ~partitioned_basic_histogramm( void ) noexcept {
+         clear( );
+         delete[ ] partitions;
+         delete[ ] partitioned_keys;
+         delete[ ] partition_start;
+         delete[ ] partition_offsets;
+         delete[ ] partition_histogram;
+      }
+      size_t get_partition_count( void ) const noexcept {
+         return partition_count;
+      }
+      size_t get_size( void ) const noexcept {
+         size_t result = 0;
+         for( size_t i = 0; i < partition_count; ++i ) {
+            if( partitions[ i ] != nullptr )
+               result += partitions[ i ]->get_size( );
+         }
+         return result;
+      }
+      size_t get_count( void ) const noexcept {
+         size_t result = 0;
+         for( size_t i = 0; i < partition_count; ++i ) {
+            if( partitions[ i ] != nullptr )
+               result += partitions[ i ]->get_count( );
+         }
+         return result;
+      }
+      size_t key_count( void ) const noexcept {
+         size_t result = 0;
+         for( size_t i = 0; i < partition_count; ++i ) {
+            if( partitions[ i ] != nullptr )
+               result += partitions[ i ]->key_count( );
+         }
+         return result;
+      }
+      void build_scalar_elem( T const * const keys, size_t thread_count ) {
+         build( keys, thread_count, &histogramm_t::build_scalar_elem );
+      }
+      void build_vectorized_elem( T const * const keys, size_t thread_count ) {
+         build( keys, thread_count, &histogramm_t::build_vectorized_elem );
+      }
+      void build_scalar_batch( T const * const keys, size_t thread_count ) {
+         build( keys, thread_count, &histogramm_t::build_scalar_batch );
+      }
+      void build_vectorized_batch( T const * const keys, size_t thread_count ) {
+         build( keys, thread_count, &histogramm_t::build_vectorized_batch );
+      }
+      uint64_t probe_count_vectorized( T key ) const noexcept {
+         return partitions[ get_partition( key ) ]->probe_count_vectorized( key );
+      }
+      size_t get_count( T key ) const noexcept {
+         return partitions[ get_partition( key ) ]->get_count( key );
+      }
+      size_t probe(  T const * const probe_keys, size_t const probe_keys_count,
+                     T * const probe_result, T * const probe_result_count ) const noexcept {
+         size_t result_position = 0;
+         for( size_t probe_key_position = 0; probe_key_position < probe_keys_count; ++probe_key_position ) {
+            T const key = probe_keys[ probe_key_position ];
+            uint64_t const count = probe_count_vectorized( key );
+            if( count != 0 ) {
+               probe_result[ result_position ] = key;
+               probe_result_count[ result_position++ ] = count;
+            }
+         }
+         return result_position;
+      }
+};
+
+#endif //GENERAL_PARTITIONED_HASH_SET_H
@@ -0,0 +1,241 @@
+/**
+ * @file radix_partitioned_hash_set.h
+ * @brief Two phase histogram for inputs far beyond the last level cache: radix partitioning, then cache sized builds.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_RADIX_PARTITIONED_HASH_SET_H
+#define GENERAL_RADIX_PARTITIONED_HASH_SET_H
+
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include "hash_set.h"
+#include "../../../utils/vector.h"
+
+/**
+ * Histogram built in two phases, so that no phase does random accesses into memory much larger than the caches:
+ *    1. the keys are radix partitioned on the upper FanoutBits * Passes bits of a murmur3 hash with a dedicated
+ *       seed. Every pass splits each partition of the previous pass into 2^FanoutBits partitions. A pass counts
+ *       the keys per partition and scatters them through write-combining buffers: one cache line per partition,
+ *       which is written to the target in one piece once it is full. So the target is written sequentially per
+ *       partition and the active lines (2^FanoutBits * 64 bytes) stay in L1 / L2, not one page per partition in
+ *       the TLB.
+ *    2. every partition gets its own const_sized_basic_histogramm built with build_vectorized_batch. With
+ *       partition_bits_for_cache the partitions are small enough that these sub tables fit into the given cache.
+ * Few passes with a high fan-out cost TLB and cache misses in the scatter, many passes cost bandwidth; both are
+ * parameters so they can be tuned per machine. The keys are partitioned in a private copy, the input is not changed.
+ */
+template< typename T, class SlotMapping = slot_mapping_modulo >
+class radix_partitioned_histogramm {
+   private:
+      typedef const_sized_basic_histogramm< T, SlotMapping > histogramm_t;
+
+      static constexpr uint32_t PARTITION_SEED = 0x9747b28c;
+      static constexpr size_t PARTITION_HASH_CHUNK = 256;
+      static constexpr size_t CACHE_LINE_SIZE = 64;
+      static constexpr size_t LINE_KEYS = CACHE_LINE_SIZE / sizeof( T );
+
+      size_t      const ElementCount;
+      uint32_t    const LoadFactor;
+      uint32_t    const FanoutBits;
+      uint32_t    const Passes;
+      uint32_t    const PartitionBits;
+      size_t      const partition_count;
+      size_t         *  partition_start;
+      histogramm_t  **  partitions;
+      murmur3< T > const     partition_hash_fn;
+
+      inline size_t partition_of_hash( typename murmur3< T >::hash_type const hash ) const noexcept {
+         return ( size_t ) ( ( uint32_t ) hash >> ( 32 - PartitionBits ) );
+      }
+      inline size_t get_partition( T const key ) const noexcept {
+         return partition_of_hash( partition_hash_fn( key ) );
+      }
+      /**
+       * One pass over source[ 0, count ): writes the keys grouped by the FanoutBits bits below shift to target and
+       * their 2^FanoutBits + 1 boundaries, relative to target, to bounds.
+       */
+      void partition_pass( T const * const source, size_t const count, T * const target, uint32_t const shift,
+                           size_t * const bounds, T * const lines, uint8_t * const fill ) const noexcept {
+         size_t const fanout = ( size_t ) 1 << FanoutBits;
+         size_t const mask = fanout - 1;
+         typename murmur3< T >::hash_type hashes[ PARTITION_HASH_CHUNK ];
+         for( size_t p = 0; p <= fanout; ++p ) {
+            bounds[ p ] = 0;
+         }
+#pragma _NEC novector
+         for( size_t chunk_start = 0; chunk_start < count; chunk_start += PARTITION_HASH_CHUNK ) {
+            size_t const chunk_size = ( count - chunk_start < PARTITION_HASH_CHUNK ) ? count - chunk_start : PARTITION_HASH_CHUNK;
+            partition_hash_fn.hash_batch( source + chunk_start, chunk_size, hashes );
+            for( size_t i = 0; i < chunk_size; ++i ) {
+               bounds[ ( ( ( uint32_t ) hashes[ i ] >> shift ) & mask ) + 1 ]++;
+            }
+         }
+         for( size_t p = 0; p < fanout; ++p ) {
+            bounds[ p + 1 ] += bounds[ p ];
+            fill[ p ] = 0;
+         }
+         /* bounds[ p ] is advanced while scattering and ends as the begin of partition p + 1 */
+         size_t * const offsets = bounds;
+#pragma _NEC novector
+         for( size_t chunk_start = 0; chunk_start < count; chunk_start += PARTITION_HASH_CHUNK ) {
+            size_t const chunk_size = ( count - chunk_start < PARTITION_HASH_CHUNK ) ? count - chunk_start : PARTITION_HASH_CHUNK;
+            partition_hash_fn.hash_batch( source + chunk_start, chunk_size, hashes );
+#pragma _NEC novector
+            for( size_t i = 0; i < chunk_size; ++i ) {
+               size_t const p = ( ( uint32_t ) hashes[ i ] >> shift ) & mask;
+               T * const line = lines + p * LINE_KEYS;
+               line[ fill[ p ]++ ] = source[ chunk_start + i ];
+               if( fill[ p ] == LINE_KEYS ) {
+                  std::memcpy( target + offsets[ p ], line, CACHE_LINE_SIZE );
+                  offsets[ p ] += LINE_KEYS;
+                  fill[ p ] = 0;
+               }
+            }
+         }
+         for( size_t p = 0; p < fanout; ++p ) {
+            std::memcpy( target + offsets[ p ], lines + p * LINE_KEYS, fill[ p ] * sizeof( T ) );
+            offsets[ p ] += fill[ p ];
+         }
+         for( size_t p = fanout; p > 0; --p ) {
+            bounds[ p ] = bounds[ p - 1 ];
+         }
+         bounds[ 0 ] = 0;
+      }
+      void clear( void ) noexcept {
+         for( size_t i = 0; i < partition_count; ++i ) {
+            delete partitions[ i ];
+            partitions[ i ] = nullptr;
+         }
+      }
+   public:
+      radix_partitioned_histogramm( size_t _ElemCount, uint32_t _LoadFactor, uint32_t _FanoutBits = 8, uint32_t _Passes = 2 ):
+         ElementCount{ _ElemCount },
+         LoadFactor{ _LoadFactor },
+         FanoutBits{ _FanoutBits },
+         Passes{ _Passes },
+         PartitionBits{ _FanoutBits * _Passes },
+         partition_count{ ( size_t ) 1 << ( _FanoutBits * _Passes ) },
+         partition_start{ new size_t[ partition_count + 1 ]( ) },
+         partitions{ new histogramm_t*[ partition_count ]( ) },
+         partition_hash_fn{ PARTITION_SEED } {
+         assert( _FanoutBits > 0 && _FanoutBits <= 16 && _Passes > 0 && _FanoutBits * _Passes < 32 );
+      }
+      virtual ~radix_partitioned_histogramm( void ) noexcept {
+         clear( );
+         delete[ ] partitions;
+         delete[ ] partition_start;
+      }
+      /**
+       * Smallest number of partition bits for which the sub table of an average partition ( keys and counts at the
+       * load factor ) fits into CacheBytes. Split it into FanoutBits * Passes for the constructor.
+       */
+      static uint32_t partition_bits_for_cache( size_t const _ElemCount, uint32_t const _LoadFactor,
+                                                size_t const CacheBytes ) noexcept {
+         size_t const table_bytes = _ElemCount * 100 / _LoadFactor * ( sizeof( T ) + sizeof( uint64_t ) );
+         uint32_t bits = 0;
+         while( ( bits < 31 ) && ( ( table_bytes >> bits ) > CacheBytes ) )
+            ++bits;
+         return bits;
+      }
+      size_t get_partition_count( void ) const noexcept {
+         return partition_count;
+      }
+      size_t get_size( void ) const noexcept {
+         size_t result = 0;
+         for( size_t i = 0; i < partition_count; ++i ) {
+            if( partitions[ i ] != nullptr )
+               result += partitions[ i ]->get_size( );
+         }
+         return result;
+      }
+      size_t get_count( void ) const noexcept {
+         size_t result = 0;
+         for( size_t i = 0; i < partition_count; ++i ) {
+            if( partitions[ i ] != nullptr )
+               result += partitions[ i ]->get_count( );
+         }
+         return result;
+      }
+      size_t key_count( void ) const noexcept {
+         size_t result = 0;
+         for( size_t i = 0; i < partition_count; ++i ) {
+            if( partitions[ i ] != nullptr )
+               result += partitions[ i ]->key_count( );
+         }
+         return result;
+      }
+      /* first phase only, leaves the keys partitioned in partitioned_keys[ ElementCount ] and their bounds in
+       * partition_start */
+      void partition( T const * const keys, T * const partitioned_keys ) noexcept {
+         size_t const fanout = ( size_t ) 1 << FanoutBits;
+         T * const scratch = ( Passes > 1 ) ? new T[ ElementCount ] : nullptr;
+         T * const lines = ( T * ) aligned_alloc( CACHE_LINE_SIZE, fanout * CACHE_LINE_SIZE );
+         uint8_t * const fill = new uint8_t[ fanout ];
+         size_t * const bounds = new size_t[ fanout + 1 ];
+         size_t parent_count = 1;
+         partition_start[ 0 ] = 0;
+         partition_start[ 1 ] = ElementCount;
+         T const * source = keys;
+         for( uint32_t pass = 0; pass < Passes; ++pass ) {
+            /* ping-pong between scratch and partitioned_keys, such that the last pass writes to partitioned_keys */
+            T * const target = ( ( Passes - 1 - pass ) % 2 == 0 ) ? partitioned_keys : scratch;
+            uint32_t const shift = 32 - ( pass + 1 ) * FanoutBits;
+            /* refined in place from the back, parent p becomes the partitions p * fanout ... ( p + 1 ) * fanout - 1 */
+            for( size_t parent = parent_count; parent > 0; --parent ) {
+               size_t const begin = partition_start[ parent - 1 ];
+               size_t const end = partition_start[ parent ];
+               partition_pass( source + begin, end - begin, target + begin, shift, bounds, lines, fill );
+               for( size_t child = fanout; child > 0; --child ) {
+                  partition_start[ ( parent - 1 ) * fanout + child ] = begin + bounds[ child ];
+               }
+               partition_start[ ( parent - 1 ) * fanout ] = begin;
+            }
+            parent_count *= fanout;
+            source = target;
+         }
+         delete[ ] bounds;
+         delete[ ] fill;
+         free( ( void * ) lines );
+         delete[ ] scratch;
+      }
+      void build_vectorized_batch( T const * const keys ) {
+         clear( );
+         T * const partitioned_keys = new T[ ElementCount ];
+         partition( keys, partitioned_keys );
+         for( size_t p = 0; p < partition_count; ++p ) {
+            size_t const begin = partition_start[ p ];
+            size_t const count = partition_start[ p + 1 ] - begin;
+            /* an empty partition still gets a container, so probing it needs no special case */
+            partitions[ p ] = new histogramm_t( ( count > 0 ) ? count : 1, LoadFactor );
+            if( count > 0 )
+               partitions[ p ]->build_vectorized_batch( partitioned_keys + begin );
+         }
+         delete[ ] partitioned_keys;
+      }
+      uint64_t probe_count_vectorized( T key ) const noexcept {
+         return partitions[ get_partition( key ) ]->probe_count_vectorized( key );
+      }
+      size_t get_count( T key ) const noexcept {
+         return partitions[ get_partition( key ) ]->get_count( key );
+      }
+      size_t probe(  T const * const probe_keys, size_t const probe_keys_count,
+                     T * const probe_result, T * const probe_result_count ) const noexcept {
+         size_t result_position = 0;
+         for( size_t probe_key_position = 0; probe_key_position < probe_keys_count; ++probe_key_position ) {
+            T const key = probe_keys[ probe_key_position ];
+            uint64_t const count = probe_count_vectorized( key );
+            if( count != 0 ) {
+               probe_result[ result_position ] = key;
+               probe_result_count[ result_position++ ] = count;
+            }
+         }
+         return result_position;
+      }
+};
+
+#endif //GENERAL_RADIX_PARTITIONED_HASH_SET_H
@@ -0,0 +1,228 @@
+/**
+ * @file robin_hood_hash_set.h
+ * @brief Histogram with Robin Hood linear probing and backward shift deletion.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_ROBIN_HOOD_HASH_SET_H
+#define GENERAL_ROBIN_HOOD_HASH_SET_H
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include "../../algorithms/hash/murmur3.h"
+#include "slot_mapping.h"
+#include "../../../utils/vector.h"
+
+/**
+ * Linear probing histogram which keeps the displacement ( distance from the home slot ) of every key. An insert takes
+ * the slot of a key which is closer to its home than the inserted one and carries that key on ("robbing the rich"),
+ * so the keys of a cluster are ordered by their home slot. A lookup can stop as soon as it sees a slot with a smaller
+ * displacement than its own probe distance, which bounds misses by the maximum displacement instead of the cluster
+ * length.
+ * erase() removes a key with a backward shift: the following keys of the cluster move one slot back until an empty
+ * slot or a key in its home slot is reached, no tombstones are needed.
+ * All slot mapping policies map ( hash, offset ) onto ( home + offset ) mod size, so probing steps to the next slot.
+ */
+template< typename T, class SlotMapping = slot_mapping_modulo >
+class robin_hood_basic_histogramm {
+   private:
+      static constexpr size_t BATCH_SIZE = 256;
+
+      T           const ElementCount;
+      T           const LoadFactor;
+      SlotMapping const slot_mapping;
+      size_t      const container_size;
+      size_t      const container_infinity_value;
+      size_t            container_distinct_count;
+      uint32_t          max_displacement;
+      T        *  const key_container;
+      uint64_t *  const key_count_container;
+      uint32_t *  const displacement_container;
+      murmur3< T > const     hash_fn;
+
+      inline size_t next_slot( size_t const slot ) const noexcept {
+         return ( slot + 1 == container_size ) ? 0 : slot + 1;
+      }
+      void insert( T const key, size_t const home ) noexcept {
+         size_t position = home;
+         T carried_key = key;
+         uint64_t carried_count = 1;
+         uint32_t displacement = 0;
+#pragma _NEC novector
+         for( size_t step = 0; step < container_size; ++step ) {
+            T const loaded_key = key_container[ position ];
+            if( loaded_key == 0 ) {
+               key_container[ position ] = carried_key;
+               key_count_container[ position ] = carried_count;
+               displacement_container[ position ] = displacement;
+               if( displacement > max_displacement )
+                  max_displacement = displacement;
+               if( carried_key == key )
+                  ++container_distinct_count;
+               return;
+            }
+            if( loaded_key == carried_key ) {
+               /* only possible before the first swap, a carried victim is unique */
+               key_count_container[ position ]++;
+               return;
+            }
+            if( displacement_container[ position ] < displacement ) {
+               /* key is absent, otherwise it would have been found before this slot */
+               if( carried_key == key )
+                  ++container_distinct_count;
+               if( displacement > max_displacement )
+                  max_displacement = displacement;
+               std::swap( carried_key, key_container[ position ] );
+               std::swap( carried_count, key_count_container[ position ] );
+               std::swap( displacement, displacement_container[ position ] );
+            }
+            position = next_slot( position );
+            ++displacement;
+         }
+      }
+      template< bool Vectorized >
+      void build_batch( T const * const keys ) noexcept {
+         size_t homes[ BATCH_SIZE ];
+         typename murmur3< T >::hash_type hashes[ BATCH_SIZE ];
+#pragma _NEC novector
+         for( size_t batch_start = 0; batch_start < ElementCount; batch_start += BATCH_SIZE ) {
+            size_t const batch_size = ( ElementCount - batch_start < BATCH_SIZE ) ? ElementCount - batch_start : BATCH_SIZE;
+            T const * const batch_keys = keys + batch_start;
+            if( Vectorized ) {
+               hash_fn.hash_batch( batch_keys, batch_size, hashes );
+               for( size_t i = 0; i < batch_size; ++i ) {
+                  homes[ i ] = slot_mapping( hashes[ i ], 0 );
+               }
+            } else {
+#pragma _NEC novector
+               for( size_t i = 0; i < batch_size; ++i ) {
+                  homes[ i ] = slot_mapping( hash_fn( batch_keys[ i ] ), 0 );
+               }
+            }
+#pragma _NEC novector
+            for( size_t i = 0; i < batch_size; ++i ) {
+               PREFETCH_READ_( &key_container[ homes[ i ] ] );
+               PREFETCH_READ_( &displacement_container[ homes[ i ] ] );
+            }
+#pragma _NEC novector
+            for( size_t i = 0; i < batch_size; ++i ) {
+               insert( batch_keys[ i ], homes[ i ] );
+            }
+         }
+      }
+   public:
+      robin_hood_basic_histogramm( uint32_t _ElemCount, uint32_t _LoadFactor ):
+         ElementCount{ _ElemCount },
+         LoadFactor{ _LoadFactor },
+         slot_mapping{ ( size_t ) ElementCount * 100 / LoadFactor },
+         container_size{ slot_mapping.get_size( ) },
+         container_infinity_value{ container_size + 1 },
+         container_distinct_count{ 0 },
+         max_displacement{ 0 },
+         key_container{ new T[ container_size ]( ) },
+         key_count_container{ new uint64_t[ container_size ]( ) },
+         displacement_container{ new uint32_t[ container_size ]( ) } {
+      }
+      virtual ~robin_hood_basic_histogramm( void ) noexcept {
+         delete[ ] displacement_container;
+         delete[ ] key_count_container;
+         delete[ ] key_container;
+      }
+      size_t get_size( void ) const noexcept {
+         return container_size;
+      }
+      /* upper bound of the displacements since construction, erase does not lower it */
+      uint32_t get_max_displacement( void ) const noexcept {
+         return max_displacement;
+      }
+      size_t get_count( void ) const noexcept {
+         size_t result = 0;
+         for( size_t position = 0; position < container_size; ++position ) {
+            result += ( size_t ) key_count_container[ position ];
+         }
+         return result;
+      }
+      size_t key_count( void ) const noexcept {
+         size_t result = 0;
+         for( size_t position = 0; position < container_size; ++position ) {
+            if( key_container[ position ] != 0 )
+               ++result;
+         }
+         return result;
+      }
+      void build_scalar_elem( T const * const keys ) noexcept {
+#pragma _NEC novector
+         for( size_t keys_position = 0; keys_position < ElementCount; ++keys_position ) {
+            insert( keys[ keys_position ], slot_mapping( hash_fn( keys[ keys_position ] ), 0 ) );
+         }
+      }
+      void build_vectorized_elem( T const * const keys ) noexcept {
+         for( size_t keys_position = 0; keys_position < ElementCount; ++keys_position ) {
+            insert( keys[ keys_position ], slot_mapping( hash_fn( keys[ keys_position ] ), 0 ) );
+         }
+      }
+      void build_scalar_batch( T const * const keys ) noexcept {
+         build_batch< false >( keys );
+      }
+      void build_vectorized_batch( T const * const keys ) noexcept {
+         build_batch< true >( keys );
+      }
+      size_t probe( T key ) const noexcept {
+         size_t position = slot_mapping( hash_fn( key ), 0 );
+#pragma _NEC novector
+         for( uint32_t displacement = 0; displacement <= max_displacement; ++displacement ) {
+            T const loaded_key = key_container[ position ];
+            if( loaded_key == key )
+               return position;
+            if( loaded_key == 0 || displacement_container[ position ] < displacement )
+               break;
+            position = next_slot( position );
+         }
+         return container_infinity_value;
+      }
+      uint64_t probe_count_vectorized( T key ) const noexcept {
+         size_t const position = probe( key );
+         return ( position < container_infinity_value ) ? key_count_container[ position ] : 0;
+      }
+      size_t get_count( T key ) const noexcept {
+         return ( size_t ) probe_count_vectorized( key );
+      }
+      size_t probe(  T const * const probe_keys, size_t const probe_keys_count,
+                     T * const probe_result, T * const probe_result_count ) const noexcept {
+         size_t result_position = 0;
+         for( size_t probe_key_position = 0; probe_key_position < probe_keys_count; ++probe_key_position ) {
+            T const key = probe_keys[ probe_key_position ];
+            size_t const position = probe( key );
+            if( position < container_infinity_value ) {
+               probe_result[ result_position ] = key;
+               probe_result_count[ result_position++ ] = key_count_container[ position ];
+            }
+         }
+         return result_position;
+      }
+      /* removes key with all its occurrences and returns its count */
+      uint64_t erase( T key ) noexcept {
+         size_t position = probe( key );
+         if( position == container_infinity_value )
+            return 0;
+         uint64_t const count = key_count_container[ position ];
+         size_t next = next_slot( position );
+#pragma _NEC novector
+         while( key_container[ next ] != 0 && displacement_container[ next ] > 0 ) {
+            key_container[ position ] = key_container[ next ];
+            key_count_container[ position ] = key_count_container[ next ];
+            displacement_container[ position ] = displacement_container[ next ] - 1;
+            position = next;
+            next = next_slot( next );
+         }
+         key_container[ position ] = 0;
+         key_count_container[ position ] = 0;
+         displacement_container[ position ] = 0;
+         --container_distinct_count;
+         return count;
+      }
+};
+
+#endif //GENERAL_ROBIN_HOOD_HASH_SET_H
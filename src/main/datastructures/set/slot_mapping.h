@@ -0,0 +1,105 @@
+/**
+ * @file slot_mapping.h
+ * @brief Policies which map a hash value and a linear probing offset onto a slot of a hash container.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#ifndef GENERAL_SLOT_MAPPING_H
+#define GENERAL_SLOT_MAPPING_H
+
+#include <cstddef>
+#include <cstdint>
+#ifdef __AVX512F__
+#   include <immintrin.h>
+#endif
+
+/**
+ * Maps ( hash + offset ) with an integer division. Works for every container size.
+ */
+class slot_mapping_modulo {
+   private:
+      size_t container_size;
+   public:
+      slot_mapping_modulo( size_t _RequestedSize ) :
+         container_size{ _RequestedSize } { }
+      size_t get_size( void ) const noexcept {
+         return container_size;
+      }
+      inline size_t operator()( size_t const hash, size_t const offset ) const noexcept {
+         return ( hash + offset ) % container_size;
+      }
+#ifdef __AVX512F__
+      /* slot of 16 32-bit hashes at offset 0. The quotient is computed in double precision, which is exact for
+       * 32-bit hashes and container sizes. */
+      inline __m512i base_avx512( __m512i const hash ) const noexcept {
+         __m512d const size_pd = _mm512_set1_pd( ( double ) container_size );
+         __m512d quotient_lo = _mm512_div_pd( _mm512_cvtepu32_pd( _mm512_castsi512_si256( hash ) ), size_pd );
+         __m512d quotient_hi = _mm512_div_pd( _mm512_cvtepu32_pd( _mm512_extracti64x4_epi64( hash, 1 ) ), size_pd );
+         __m512i quotient = _mm512_inserti64x4(
+            _mm512_castsi256_si512( _mm512_cvttpd_epu32( quotient_lo ) ), _mm512_cvttpd_epu32( quotient_hi ), 1 );
+         return _mm512_sub_epi32( hash, _mm512_mullo_epi32( quotient, _mm512_set1_epi32( ( int ) container_size ) ) );
+      }
+#endif
+};
+
+/**
+ * Rounds the container size up to the next power of two and maps ( hash + offset ) with a mask.
+ */
+class slot_mapping_power_of_two {
+   private:
+      size_t container_size;
+      size_t container_mask;
+      static size_t next_power_of_two( size_t value ) noexcept {
+         size_t result = 1;
+         while( result < value )
+            result <<= 1;
+         return result;
+      }
+   public:
+      slot_mapping_power_of_two( size_t _RequestedSize ) :
+         container_size{ next_power_of_two( _RequestedSize ) },
+         container_mask{ container_size - 1 } { }
+      size_t get_size( void ) const noexcept {
+         return container_size;
+      }
+      inline size_t operator()( size_t const hash, size_t const offset ) const noexcept {
+         return ( hash + offset ) & container_mask;
+      }
+#ifdef __AVX512F__
+      inline __m512i base_avx512( __m512i const hash ) const noexcept {
+         return _mm512_and_si512( hash, _mm512_set1_epi32( ( int ) container_mask ) );
+      }
+#endif
+};
+
+/**
+ * Keeps the requested container size and reduces the 32-bit hash with a multiply-shift (Lemire's fastrange).
+ * fastrange maps consecutive hashes onto the same slot, so the probing offset is added afterwards and wrapped
+ * with a conditional subtraction. As offset < container_size this needs no division.
+ */
+class slot_mapping_fastrange {
+   private:
+      size_t container_size;
+   public:
+      slot_mapping_fastrange( size_t _RequestedSize ) :
+         container_size{ _RequestedSize } { }
+      size_t get_size( void ) const noexcept {
+         return container_size;
+      }
+      inline size_t operator()( size_t const hash, size_t const offset ) const noexcept {
+         size_t const position =
+            ( size_t ) ( ( ( uint64_t ) ( uint32_t ) hash * ( uint64_t ) container_size ) >> 32 ) + offset;
+         return ( position >= container_size ) ? position - container_size : position;
+      }
+#ifdef __AVX512F__
+      inline __m512i base_avx512( __m512i const hash ) const noexcept {
+         __m512i const size = _mm512_set1_epi32( ( int ) container_size );
+         __m512i const product_even = _mm512_srli_epi64( _mm512_mul_epu32( hash, size ), 32 );
+         __m512i const product_odd = _mm512_mul_epu32( _mm512_srli_epi64( hash, 32 ), size );
+         return _mm512_mask_blend_epi32( ( __mmask16 ) 0xAAAA, product_even, product_odd );
+      }
+#endif
+};
+
+#endif //GENERAL_SLOT_MAPPING_H
@@ -8,10 +8,16 @@
 #ifndef GENERAL_THREADING_H
 #define GENERAL_THREADING_H
 
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
 #include <unistd.h>
 #include <sys/types.h>
 #include <iostream>
 #include <pthread.h>
+#include <sched.h>
+#include "vector.h"
 
 bool check_root( void ) {
    return ( getuid() == 0 );
@@ -29,10 +35,23 @@ class posix_thread {
          CPU_ZERO( &cpu_set );
          pthread_attr_init( &attribute );
       }
+      posix_thread( posix_thread const & ) = delete;
+      posix_thread & operator=( posix_thread const & ) = delete;
+      /* the attribute holds a cpuset allocated by glibc once an affinity was set */
+      ~posix_thread( void ) {
+         pthread_attr_destroy( &attribute );
+      }
       void set_cpu( int32_t cpu ) {
          CPU_SET( cpu, &cpu_set );
 //         pthread_attr_setaffinity_np( &attribute, sizeof( cpu_set_t ), &cpu_set );
       }
+      /* pins the thread created with get_attribute( ) to cpu, unlike set_cpu */
+      void pin_to_cpu( int32_t cpu ) {
+         cpu_set_t pinned;
+         CPU_ZERO( &pinned );
+         CPU_SET( cpu, &pinned );
+         pthread_attr_setaffinity_np( &attribute, sizeof( cpu_set_t ), &pinned );
+      }
 
       pthread_t * get_thread_ptr( void ) {
          return &t;
@@ -112,4 +131,65 @@ struct partition_manager_even_chunks {
 
 };
 
+/* cpus of the process affinity mask, a thread pinned outside of them would not start */
+std::vector< int32_t > allowed_cpus( void ) {
+   cpu_set_t allowed;
+   CPU_ZERO( &allowed );
+   std::vector< int32_t > cpus;
+   if( sched_getaffinity( 0, sizeof( cpu_set_t ), &allowed ) == 0 ) {
+      for( int32_t cpu = 0; cpu < CPU_SETSIZE; ++cpu ) {
+         if( CPU_ISSET( cpu, &allowed ) )
+            cpus.push_back( cpu );
+      }
+   }
+   return cpus;
+}
+
+template< typename T, typename Fn >
+struct even_chunk_task {
+   Fn * fn;
+   std::size_t thread_id;
+   std::pair< T*, std::size_t > chunk;
+   static void * run( void * ctx_ ) {
+      even_chunk_task * ctx = ( even_chunk_task * ) ctx_;
+      ( *ctx->fn )( ctx->thread_id, ctx->chunk.first, ctx->chunk.second );
+      return ( void * ) nullptr;
+   }
+};
+
+/**
+ * Splits [ data, data + size ) into thread_count even chunks and calls fn( thread_id, chunk_begin, chunk_size ) on
+ * one posix thread per chunk. Thread i is pinned to the i-th cpu of allowed_cpus( ), round robin if there are fewer
+ * cpus than threads ( posix_thread::set_cpu only records the cpu ). Returns when all threads are joined.
+ */
+template< typename T, typename Fn >
+void run_on_even_chunks( T * const data, std::size_t const size, std::size_t const thread_count, Fn fn ) {
+   assert( thread_count > 0 && thread_count <= MAX_THREAD_COUNT );
+   posix_thread threads[ MAX_THREAD_COUNT ];
+   partition_manager_even_chunks< T > part_manager{ data, size };
+   part_manager.set_thread_count( thread_count );
+   std::vector< even_chunk_task< T, Fn > > tasks( thread_count );
+   std::vector< int32_t > const cpus = allowed_cpus( );
+   for( std::size_t i = 0; i < thread_count; ++i ) {
+      tasks[ i ] = { &fn, i, part_manager.get_chunk_with_size( i ) };
+      if( !cpus.empty( ) )
+         threads[ i ].pin_to_cpu( cpus[ i % cpus.size( ) ] );
+   }
+   bool started[ MAX_THREAD_COUNT ];
+   for( std::size_t i = 0; i < thread_count; ++i ) {
+      started[ i ] = ( pthread_create(   threads[ i ].get_thread_ptr( ),
+                                         threads[ i ].get_attribute( ),
+                                         &even_chunk_task< T, Fn >::run,
+                                         ( void * ) &tasks[ i ]
+                       ) == 0 );
+      /* a chunk whose thread could not be created is processed by the caller */
+      if( !started[ i ] )
+         even_chunk_task< T, Fn >::run( ( void * ) &tasks[ i ] );
+   }
+   for( std::size_t i = 0; i < thread_count; ++i ) {
+      if( started[ i ] )
+         pthread_join( threads[ i ].get_thread( ), NULL );
+   }
+}
+
 #endif //GENERAL_THREADING_H
@@ -46,5 +46,16 @@
 
 #endif
 
+/* VE hides memory latency with vector gathers and has no software prefetch. */
+#ifdef __NCC__
+#   define PREFETCH_READ_( addr )
+#else
+#   define PREFETCH_READ_( addr ) __builtin_prefetch( ( addr ), 0, 3 )
+#endif
+
+#ifndef MAX_THREAD_COUNT
+#   define MAX_THREAD_COUNT                     8
+#endif
+
 
 #endif //GENERAL_VECTOR_H
@@ -0,0 +1,102 @@
+/**
+ * @file grouped_aggregation_test.cpp
+ * @brief Compares grouped_aggregation against std::unordered_map based aggregates.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#include <iostream>
+#include <random>
+#include <cstdint>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include "../../test_utils.h"
+
+#include "../../../main/algorithms/aggregation/grouped_aggregation.h"
+
+#define DATACOUNT_AGGREGATION_TEST_L1 8000
+#define DATACOUNT_AGGREGATION_TEST_L2 64000
+#define DATACOUNT_AGGREGATION_TEST_L3 4096000
+#define PAYLOAD_COUNT_AGGREGATION_TEST 3
+
+struct stl_state {
+   uint64_t count = 0;
+   int64_t sum[ PAYLOAD_COUNT_AGGREGATION_TEST ] = { 0, 0, 0 };
+   int64_t min[ PAYLOAD_COUNT_AGGREGATION_TEST ] = { INT64_MAX, INT64_MAX, INT64_MAX };
+   int64_t max[ PAYLOAD_COUNT_AGGREGATION_TEST ] = { INT64_MIN, INT64_MIN, INT64_MIN };
+};
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_AGGREGATION_TEST, uint32_t Aggregates >
+bool test_grouped_aggregation( void ) {
+   std::mt19937 generator( 65536 );
+   std::uniform_int_distribution< uint32_t > key_dist( 1, DATACOUNT_AGGREGATION_TEST / 8 );
+   std::uniform_int_distribution< int64_t > value_dist( -1000000, 1000000 );
+   std::vector< uint32_t > keys( DATACOUNT_AGGREGATION_TEST );
+   std::vector< std::vector< int64_t > > payload( PAYLOAD_COUNT_AGGREGATION_TEST, std::vector< int64_t >( DATACOUNT_AGGREGATION_TEST ) );
+   std::unordered_map< uint32_t, stl_state > stl_groups;
+   for( size_t row = 0; row < DATACOUNT_AGGREGATION_TEST; ++row ) {
+      keys[ row ] = key_dist( generator );
+      stl_state & state = stl_groups[ keys[ row ] ];
+      ++state.count;
+      for( size_t column = 0; column < PAYLOAD_COUNT_AGGREGATION_TEST; ++column ) {
+         int64_t const value = value_dist( generator );
+         payload[ column ][ row ] = value;
+         state.sum[ column ] += value;
+         state.min[ column ] = std::min( state.min[ column ], value );
+         state.max[ column ] = std::max( state.max[ column ], value );
+      }
+   }
+   int64_t const * columns[ PAYLOAD_COUNT_AGGREGATION_TEST ];
+   for( size_t column = 0; column < PAYLOAD_COUNT_AGGREGATION_TEST; ++column )
+      columns[ column ] = payload[ column ].data( );
+
+   grouped_aggregation< uint32_t > aggregation{ DATACOUNT_AGGREGATION_TEST, loadFactor, PAYLOAD_COUNT_AGGREGATION_TEST, Aggregates };
+   aggregation.build( keys.data( ), columns );
+   ASSERT_EQUAL( aggregation.get_group_count( ), stl_groups.size( ) );
+   for( auto const & group : stl_groups ) {
+      uint32_t const key = group.first;
+      stl_state const & state = group.second;
+      ASSERT_EQUAL( aggregation.get_count( key ), state.count );
+      for( size_t column = 0; column < PAYLOAD_COUNT_AGGREGATION_TEST; ++column ) {
+         if( Aggregates & AGGREGATE_SUM )
+            ASSERT_EQUAL( aggregation.get_sum( key, column ), state.sum[ column ] );
+         /* aggregates which were not requested read as 0 */
+         ASSERT_EQUAL( aggregation.get_min( key, column ), ( Aggregates & AGGREGATE_MIN ) ? state.min[ column ] : 0 );
+         ASSERT_EQUAL( aggregation.get_max( key, column ), ( Aggregates & AGGREGATE_MAX ) ? state.max[ column ] : 0 );
+         if( Aggregates & AGGREGATE_AVG )
+            ASSERT_THROW( std::fabs( aggregation.get_avg( key, column ) - ( double ) state.sum[ column ] / ( double ) state.count ) < 1e-6 );
+      }
+   }
+   ASSERT_THROW( ( aggregation.get_states( AGGREGATE_MIN, 0 ) != nullptr ) == ( ( Aggregates & AGGREGATE_MIN ) != 0 ) );
+   return true;
+}
+
+template< uint32_t DATACOUNT_AGGREGATION_TEST >
+int test( void ) {
+   bool passed = true;
+   try {
+      passed &= test_grouped_aggregation< 50, DATACOUNT_AGGREGATION_TEST, AGGREGATE_SUM | AGGREGATE_MIN | AGGREGATE_MAX | AGGREGATE_AVG >( );
+      passed &= test_grouped_aggregation< 90, DATACOUNT_AGGREGATION_TEST, AGGREGATE_SUM | AGGREGATE_MAX >( );
+      passed &= test_grouped_aggregation< 99, DATACOUNT_AGGREGATION_TEST, AGGREGATE_AVG | AGGREGATE_MIN >( );
+   } catch( std::runtime_error const & e ) {
+      std::cout << "WRONG: " << e.what( ) << "\n";
+      return 1;
+   }
+   return passed ? 0 : 1;
+}
+
+int main( int argc, char** argv ) {
+   if( argc < 2 )
+      return 1;
+   if( std::string{"L1"}.compare( argv[ 1 ] ) == 0 ) {
+      return test< DATACOUNT_AGGREGATION_TEST_L1 >( );
+   } else if( std::string{"L2"}.compare( argv[ 1 ] ) == 0 ) {
+      return test< DATACOUNT_AGGREGATION_TEST_L2 >( );
+   } else if( std::string{"L3"}.compare( argv[ 1 ] ) == 0 ) {
+      return test< DATACOUNT_AGGREGATION_TEST_L3 >( );
+   }
+   return 1;
+}
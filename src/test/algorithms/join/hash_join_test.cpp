@@ -0,0 +1,94 @@
+/**
+ * @file hash_join_test.cpp
+ * @brief Compares the pairs of histogramm_hash_join against a nested std::unordered_multimap join.
+ * @author Johannes Pietrzyk
+ * @todo TODOS?
+ */
+
+#include <iostream>
+#include <random>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <utility>
+#include <unordered_map>
+#include "../../test_utils.h"
+
+#include "../../../main/algorithms/join/hash_join.h"
+
+#define DATACOUNT_HASHJOIN_TEST_L1 8000
+#define DATACOUNT_HASHJOIN_TEST_L2 64000
+#define DATACOUNT_HASHJOIN_TEST_L3 4096000
+
+/* build keys are drawn from a domain of a quarter of their count, so most keys occur several times. About half of
+ * the probe keys hit. The output buffers hold Capacity pairs, small capacities split the matches of a key. */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHJOIN_TEST, size_t Capacity >
+bool test_hash_join( void ) {
+   std::mt19937 generator( 65536 );
+   std::uniform_int_distribution< uint32_t > build_dist( 1, DATACOUNT_HASHJOIN_TEST / 4 );
+   std::uniform_int_distribution< uint32_t > probe_dist( 1, DATACOUNT_HASHJOIN_TEST / 2 );
+   std::vector< uint32_t > build_keys( DATACOUNT_HASHJOIN_TEST );
+   std::vector< uint32_t > probe_keys( DATACOUNT_HASHJOIN_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHJOIN_TEST; ++i ) {
+      build_keys[ i ] = build_dist( generator );
+      probe_keys[ i ] = probe_dist( generator );
+   }
+
+   std::unordered_multimap< uint32_t, uint32_t > stl_build;
+   for( size_t i = 0; i < DATACOUNT_HASHJOIN_TEST; ++i )
+      stl_build.emplace( build_keys[ i ], ( uint32_t ) i );
+   std::vector< std::pair< uint32_t, uint32_t > > expected;
+   for( size_t i = 0; i < DATACOUNT_HASHJOIN_TEST; ++i ) {
+      auto range = stl_build.equal_range( probe_keys[ i ] );
+      for( auto it = range.first; it != range.second; ++it )
+         expected.emplace_back( it->second, ( uint32_t ) i );
+   }
+
+   histogramm_hash_join< uint32_t > join{ DATACOUNT_HASHJOIN_TEST, loadFactor };
+   join.build( build_keys.data( ) );
+   ASSERT_EQUAL( join.count_matches( probe_keys.data( ), DATACOUNT_HASHJOIN_TEST ), expected.size( ) );
+
+   std::vector< uint32_t > out_build( Capacity );
+   std::vector< uint32_t > out_probe( Capacity );
+   std::vector< std::pair< uint32_t, uint32_t > > joined;
+   histogramm_hash_join< uint32_t >::probe_cursor cursor;
+   while( cursor.probe_position < DATACOUNT_HASHJOIN_TEST ) {
+      size_t const written = join.probe( probe_keys.data( ), DATACOUNT_HASHJOIN_TEST,
+                                         out_build.data( ), out_probe.data( ), Capacity, cursor );
+      for( size_t i = 0; i < written; ++i )
+         joined.emplace_back( out_build[ i ], out_probe[ i ] );
+   }
+
+   std::sort( expected.begin( ), expected.end( ) );
+   std::sort( joined.begin( ), joined.end( ) );
+   if( joined != expected ) {
+      std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ", Capacity = " << Capacity << ".\n"
+                << "Expected " << expected.size( ) << " pairs, joined " << joined.size( ) << " pairs.\n";
+      return false;
+   }
+   return true;
+}
+
+template< uint32_t DATACOUNT_HASHJOIN_TEST >
+int test( void ) {
+   bool passed = true;
+   passed &= test_hash_join< 50, DATACOUNT_HASHJOIN_TEST, 1 >( );
+   passed &= test_hash_join< 50, DATACOUNT_HASHJOIN_TEST, 7 >( );
+   passed &= test_hash_join< 90, DATACOUNT_HASHJOIN_TEST, 1024 >( );
+   passed &= test_hash_join< 99, DATACOUNT_HASHJOIN_TEST, 65536 >( );
+   return passed ? 0 : 1;
+}
+
+int main( int argc, char** argv ) {
+   if( argc < 2 )
+      return 1;
+   if( std::string{"L1"}.compare( argv[ 1 ] ) == 0 ) {
+      return test< DATACOUNT_HASHJOIN_TEST_L1 >( );
+   } else if( std::string{"L2"}.compare( argv[ 1 ] ) == 0 ) {
+      return test< DATACOUNT_HASHJOIN_TEST_L2 >( );
+   } else if( std::string{"L3"}.compare( argv[ 1 ] ) == 0 ) {
+      return test< DATACOUNT_HASHJOIN_TEST_L3 >( );
+   }
+   return 1;
+}
@@ -12,9 +12,24 @@
 #include <limits>
 #include <cstdint>
 #include <unordered_map>
+#include <vector>
 #include "../../test_utils.h"
 
 #include "../../../main/datastructures/set/hash_set.h"
+#include "../../../main/datastructures/set/partitioned_hash_set.h"
+#include "../../../main/datastructures/set/radix_partitioned_hash_set.h"
+#include "../../../main/datastructures/set/interleaved_hash_set.h"
+#include "../../../main/datastructures/set/cuckoo_hash_set.h"
+#include "../../../main/datastructures/set/robin_hood_hash_set.h"
+#include "../../../main/datastructures/set/filtered_hash_set.h"
+#include "../../../main/datastructures/set/mapped_hash_set.h"
+#include "../../../main/datastructures/set/parallel_merge.h"
+#include "../../../main/datastructures/set/hyperloglog.h"
+#include "../../../main/datastructures/set/count_min_sketch.h"
+#include "../../../main/datastructures/set/histogramm_export.h"
+#include "../../../main/algorithms/hash/multiply_shift.h"
+#include "../../../main/algorithms/hash/crc32c.h"
+#include "../../../main/algorithms/hash/tabulation.h"
 
 
 #define DATACOUNT_HASHSET_TEST_L1 8000
@@ -25,9 +40,9 @@
 
 
 
-template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST >
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, class SlotMapping = slot_mapping_modulo >
 bool test_vectorized_elem_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
-   const_sized_basic_histogramm< uint32_t > vectorized_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   const_sized_basic_histogramm< uint32_t, SlotMapping > vectorized_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
    vectorized_histogramm.build_vectorized_elem( data );
    std::unordered_map< uint32_t, size_t > stl_histo;
    for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
@@ -48,9 +63,9 @@ bool test_vectorized_elem_build( uint32_t const * const data, uint32_t * const r
    }
    return true;
 }
-template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST >
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, class SlotMapping = slot_mapping_modulo >
 bool test_vectorized_batch_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
-   const_sized_basic_histogramm< uint32_t > vectorized_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   const_sized_basic_histogramm< uint32_t, SlotMapping > vectorized_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
    vectorized_histogramm.build_vectorized_batch( data );
    std::unordered_map< uint32_t, size_t > stl_histo;
    for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
@@ -71,9 +86,9 @@ bool test_vectorized_batch_build( uint32_t const * const data, uint32_t * const
    }
    return true;
 }
-template< uint32_t loadFactor,uint32_t DATACOUNT_HASHSET_TEST >
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, class SlotMapping = slot_mapping_modulo >
 bool test_scalar_elem_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
-   const_sized_basic_histogramm< uint32_t > scalar_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   const_sized_basic_histogramm< uint32_t, SlotMapping > scalar_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
    scalar_histogramm.build_scalar_elem( data );
    std::unordered_map< uint32_t, size_t > stl_histo;
    for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
@@ -94,9 +109,9 @@ bool test_scalar_elem_build( uint32_t const * const data, uint32_t * const resul
    }
    return true;
 }
-template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST >
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, class SlotMapping = slot_mapping_modulo >
 bool test_scalar_batch_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
-   const_sized_basic_histogramm< uint32_t > scalar_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   const_sized_basic_histogramm< uint32_t, SlotMapping > scalar_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
    scalar_histogramm.build_scalar_batch( data );
    std::unordered_map< uint32_t, size_t > stl_histo;
    for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
@@ -118,6 +133,1243 @@ bool test_scalar_batch_build( uint32_t const * const data, uint32_t * const resu
    return true;
 }
 
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, bool Batch >
+bool test_growable_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   growable_basic_histogramm< uint32_t > growable_histogramm{ loadFactor };
+   if( Batch )
+      growable_histogramm.build_vectorized_batch( data, DATACOUNT_HASHSET_TEST );
+   else
+      growable_histogramm.build_scalar_elem( data, DATACOUNT_HASHSET_TEST );
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ data[ i ] ] = stl_histo[ data[ i ] ] + 1;
+   if( growable_histogramm.key_count( ) != stl_histo.size( ) ) {
+      std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                << " STL-Distinct: " << stl_histo.size( )
+                << " GROW-Distinct: " << growable_histogramm.key_count( ) << "\n";
+      return false;
+   }
+   size_t checked_key = 0;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      size_t grow_count = growable_histogramm.probe_count_vectorized( data[ i ] );
+      size_t stl_count = stl_histo[ data[ i ] ];
+      if( grow_count != stl_count ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                   << "Key: " << ( unsigned ) data[ i ]
+                   << " STL-Count: " << stl_count
+                   << " GROW-Count: " << ( unsigned ) grow_count << "\n";
+         std::cout << "WRONG ("<<checked_key << " key)\n";
+         return false;
+      }
+      ++checked_key;
+   }
+   return true;
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST >
+bool test_partitioned_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ data[ i ] ] = stl_histo[ data[ i ] ] + 1;
+   for( size_t thread_count = 1; thread_count <= MAX_THREAD_COUNT; ++thread_count ) {
+      partitioned_basic_histogramm< uint32_t > partitioned_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+      partitioned_histogramm.build_vectorized_batch( data, thread_count );
+      size_t checked_key = 0;
+      for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+         size_t part_count = partitioned_histogramm.probe_count_vectorized( data[ i ] );
+         size_t stl_count = stl_histo[ data[ i ] ];
+         if( part_count != stl_count ) {
+            std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ", Threads = " << thread_count << ".\n"
+                      << "Key: " << ( unsigned ) data[ i ]
+                      << " STL-Count: " << stl_count
+                      << " PART-Count: " << ( unsigned ) part_count << "\n";
+            std::cout << "WRONG ("<<checked_key << " key)\n";
+            return false;
+         }
+         ++checked_key;
+      }
+   }
+   return true;
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, typename T, uint32_t FanoutBits, uint32_t Passes >
+bool test_radix_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   std::unordered_map< T, size_t > stl_histo;
+   std::vector< T > keys( data, data + DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ keys[ i ] ] = stl_histo[ keys[ i ] ] + 1;
+   radix_partitioned_histogramm< T > radix_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor, FanoutBits, Passes };
+   radix_histogramm.build_vectorized_batch( keys.data( ) );
+   if( ( radix_histogramm.get_count( ) != DATACOUNT_HASHSET_TEST ) || ( radix_histogramm.key_count( ) != stl_histo.size( ) ) ) {
+      std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ", Fanout = " << FanoutBits
+                << ", Passes = " << Passes << ".\n"
+                << "Count: " << radix_histogramm.get_count( ) << " Distinct: " << radix_histogramm.key_count( )
+                << " STL-Distinct: " << stl_histo.size( ) << "\n";
+      return false;
+   }
+   size_t checked_key = 0;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      size_t radix_count = radix_histogramm.probe_count_vectorized( keys[ i ] );
+      size_t stl_count = stl_histo[ keys[ i ] ];
+      if( radix_count != stl_count ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ", Fanout = " << FanoutBits
+                   << ", Passes = " << Passes << ".\n"
+                   << "Key: " << ( unsigned long long ) keys[ i ]
+                   << " STL-Count: " << stl_count
+                   << " RADIX-Count: " << ( unsigned ) radix_count << "\n";
+         std::cout << "WRONG ("<<checked_key << " key)\n";
+         return false;
+      }
+      ++checked_key;
+   }
+   /* the input has to stay untouched, the build partitions a private copy */
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      if( keys[ i ] != data[ i ] ) {
+         std::cout << "Input changed at " << i << "\n";
+         return false;
+      }
+   }
+   return true;
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, bool Delta >
+bool test_concurrent_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ data[ i ] ] = stl_histo[ data[ i ] ] + 1;
+   for( size_t thread_count = 1; thread_count <= MAX_THREAD_COUNT; ++thread_count ) {
+      const_sized_basic_histogramm< uint32_t > concurrent_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+      run_on_even_chunks( data, DATACOUNT_HASHSET_TEST, thread_count,
+         [ &concurrent_histogramm ]( size_t, uint32_t const * chunk, size_t chunk_size ) {
+            if( Delta )
+               concurrent_histogramm.build_concurrent_delta( chunk, chunk_size );
+            else
+               concurrent_histogramm.build_concurrent_atomic( chunk, chunk_size );
+         } );
+      size_t checked_key = 0;
+      for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+         size_t conc_count = concurrent_histogramm.probe_count_vectorized( data[ i ] );
+         size_t stl_count = stl_histo[ data[ i ] ];
+         if( conc_count != stl_count ) {
+            std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ", Threads = " << thread_count << ".\n"
+                      << "Key: " << ( unsigned ) data[ i ]
+                      << " STL-Count: " << stl_count
+                      << " CONC-Count: " << ( unsigned ) conc_count << "\n";
+            std::cout << "WRONG ("<<checked_key << " key)\n";
+            return false;
+         }
+         ++checked_key;
+      }
+   }
+   return true;
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST >
+bool test_grouped_probe( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   const_sized_basic_histogramm< uint32_t > histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   histogramm.build_vectorized_batch( data );
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ data[ i ] ] = stl_histo[ data[ i ] ] + 1;
+   /* every second probe key is shifted, most of them are absent from the histogramm */
+   std::vector< uint32_t > probe_keys( DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      probe_keys[ i ] = ( i % 2 == 0 ) ? data[ i ] : data[ i ] + 1;
+   size_t result_size = histogramm.probe_grouped( probe_keys.data( ), DATACOUNT_HASHSET_TEST, result, result_count );
+   size_t result_position = 0;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      if( stl_histo.count( probe_keys[ i ] ) == 0 )
+         continue;
+      if( ( result_position >= result_size ) || ( result[ result_position ] != probe_keys[ i ] ) ||
+          ( result_count[ result_position ] != stl_histo[ probe_keys[ i ] ] ) ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                   << "Key: " << ( unsigned ) probe_keys[ i ]
+                   << " STL-Count: " << stl_histo[ probe_keys[ i ] ] << "\n";
+         std::cout << "WRONG ("<< result_position << " result)\n";
+         return false;
+      }
+      ++result_position;
+   }
+   return ( result_position == result_size );
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, bool Avx512, class SlotMapping = slot_mapping_modulo >
+bool test_simd_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   /* the second run folds the keys onto a few distinct values, so lanes of one register collide on their slots */
+   std::vector< uint32_t > skewed( DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      skewed[ i ] = data[ i ] % 64 + 1;
+   for( uint32_t const * keys : { data, ( uint32_t const * ) skewed.data( ) } ) {
+      const_sized_basic_histogramm< uint32_t, SlotMapping > simd_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+#if defined( __AVX512F__ ) && defined( __AVX512CD__ )
+      if( Avx512 )
+         simd_histogramm.build_avx512( keys );
+#endif
+#ifdef __AVX2__
+      if( !Avx512 )
+         simd_histogramm.build_avx2( keys );
+#endif
+      std::unordered_map< uint32_t, size_t > stl_histo;
+      for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+         stl_histo[ keys[ i ] ] = stl_histo[ keys[ i ] ] + 1;
+      if( simd_histogramm.key_count( ) != stl_histo.size( ) || simd_histogramm.get_count( ) != DATACOUNT_HASHSET_TEST ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                   << "STL-Keys: " << stl_histo.size( ) << " SIMD-Keys: " << simd_histogramm.key_count( )
+                   << " SIMD-Sum: " << simd_histogramm.get_count( ) << "\n";
+         return false;
+      }
+      for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+         size_t simd_count = simd_histogramm.probe_count_vectorized( keys[ i ] );
+         size_t stl_count = stl_histo[ keys[ i ] ];
+         if( simd_count != stl_count ) {
+            std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                      << "Key: " << ( unsigned ) keys[ i ]
+                      << " STL-Count: " << stl_count
+                      << " SIMD-Count: " << ( unsigned ) simd_count << "\n";
+            std::cout << "WRONG ("<< i << " key)\n";
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, typename CountT, bool Batch >
+bool test_interleaved_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   /* the second run folds the keys onto 16 distinct values, so narrow counters spill into the overflow table */
+   std::vector< uint32_t > skewed( DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      skewed[ i ] = data[ i ] % 16 + 1;
+   for( uint32_t const * keys : { data, ( uint32_t const * ) skewed.data( ) } ) {
+      interleaved_basic_histogramm< uint32_t, CountT > interleaved_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+      if( Batch )
+         interleaved_histogramm.build_vectorized_batch( keys );
+      else
+         interleaved_histogramm.build_scalar_elem( keys );
+      std::unordered_map< uint32_t, size_t > stl_histo;
+      for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+         stl_histo[ keys[ i ] ] = stl_histo[ keys[ i ] ] + 1;
+      if( interleaved_histogramm.key_count( ) != stl_histo.size( ) || interleaved_histogramm.get_count( ) != DATACOUNT_HASHSET_TEST ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                   << "STL-Keys: " << stl_histo.size( ) << " INTERLEAVED-Keys: " << interleaved_histogramm.key_count( )
+                   << " INTERLEAVED-Sum: " << interleaved_histogramm.get_count( ) << "\n";
+         return false;
+      }
+      for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+         size_t il_count = interleaved_histogramm.probe_count_vectorized( keys[ i ] );
+         size_t stl_count = stl_histo[ keys[ i ] ];
+         if( il_count != stl_count || interleaved_histogramm.get_count( keys[ i ] ) != stl_count ) {
+            std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ", CounterBits = " << 8 * sizeof( CountT ) << ".\n"
+                      << "Key: " << ( unsigned ) keys[ i ]
+                      << " STL-Count: " << stl_count
+                      << " INTERLEAVED-Count: " << ( unsigned ) il_count << "\n";
+            std::cout << "WRONG ("<< i << " key)\n";
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, size_t Ways, bool Vectorized, bool Batch >
+bool test_cuckoo_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   cuckoo_basic_histogramm< uint32_t, Ways > cuckoo_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   if( Vectorized && Batch )
+      cuckoo_histogramm.build_vectorized_batch( data );
+   else if( Vectorized )
+      cuckoo_histogramm.build_vectorized_elem( data );
+   else if( Batch )
+      cuckoo_histogramm.build_scalar_batch( data );
+   else
+      cuckoo_histogramm.build_scalar_elem( data );
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ data[ i ] ] = stl_histo[ data[ i ] ] + 1;
+   if( cuckoo_histogramm.key_count( ) != stl_histo.size( ) || cuckoo_histogramm.get_count( ) != DATACOUNT_HASHSET_TEST ) {
+      std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ", Ways = " << Ways << ".\n"
+                << "STL-Keys: " << stl_histo.size( ) << " CUCKOO-Keys: " << cuckoo_histogramm.key_count( ) << "\n";
+      return false;
+   }
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      size_t cuckoo_count = cuckoo_histogramm.probe_count_vectorized( data[ i ] );
+      size_t stl_count = stl_histo[ data[ i ] ];
+      if( cuckoo_count != stl_count || cuckoo_histogramm.get_count( data[ i ] ) != stl_count ||
+          cuckoo_histogramm.probe_count_vectorized( data[ i ] + 1 ) != stl_histo[ data[ i ] + 1 ] ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ", Ways = " << Ways << ".\n"
+                   << "Key: " << ( unsigned ) data[ i ]
+                   << " STL-Count: " << stl_count
+                   << " CUCKOO-Count: " << ( unsigned ) cuckoo_count << "\n";
+         std::cout << "WRONG ("<< i << " key)\n";
+         return false;
+      }
+   }
+   return true;
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, bool Batch, class SlotMapping = slot_mapping_modulo >
+bool test_robin_hood( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   robin_hood_basic_histogramm< uint32_t, SlotMapping > rh_histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   if( Batch )
+      rh_histogramm.build_vectorized_batch( data );
+   else
+      rh_histogramm.build_scalar_elem( data );
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ data[ i ] ] = stl_histo[ data[ i ] ] + 1;
+   /* every third key is erased, probes for shifted keys are mostly misses */
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; i += 3 ) {
+      if( rh_histogramm.erase( data[ i ] ) != stl_histo[ data[ i ] ] ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                   << "Erase of key " << ( unsigned ) data[ i ] << " returned a wrong count.\n";
+         return false;
+      }
+      stl_histo.erase( data[ i ] );
+   }
+   if( rh_histogramm.key_count( ) != stl_histo.size( ) ) {
+      std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                << "STL-Keys: " << stl_histo.size( ) << " RH-Keys: " << rh_histogramm.key_count( ) << "\n";
+      return false;
+   }
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      for( uint32_t key : { data[ i ], data[ i ] + 1 } ) {
+         size_t rh_count = rh_histogramm.probe_count_vectorized( key );
+         size_t stl_count = ( stl_histo.count( key ) == 0 ) ? 0 : stl_histo[ key ];
+         if( rh_count != stl_count ) {
+            std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                      << "Key: " << ( unsigned ) key
+                      << " STL-Count: " << stl_count
+                      << " RH-Count: " << ( unsigned ) rh_count << "\n";
+            std::cout << "WRONG ("<< i << " key)\n";
+            return false;
+         }
+      }
+   }
+   return true;
+}
+
+/* the filtered probe has to return exactly the keys of the plain probe, the filter must not reject build keys */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, size_t BitsPerKey >
+bool test_bloom_filter( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   bloom_filtered_histogramm< uint32_t > histogramm{ DATACOUNT_HASHSET_TEST, loadFactor, BitsPerKey };
+   histogramm.build_vectorized_batch( data );
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      stl_histo[ data[ i ] ] = stl_histo[ data[ i ] ] + 1;
+      if( !histogramm.get_filter( ).contains( data[ i ] ) ) {
+         std::cout << "Bloom filter rejected build key " << ( unsigned ) data[ i ] << "\n";
+         return false;
+      }
+   }
+   std::vector< uint32_t > probe_keys( DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      probe_keys[ i ] = ( i % 4 == 0 ) ? data[ i ] : data[ i ] + 1;
+   /* the filter is fed from the hashes of the histogramm build, it has to match a filter built from the keys */
+   blocked_bloom_filter< uint32_t > reference{ DATACOUNT_HASHSET_TEST, BitsPerKey };
+   reference.build( data, DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      if( reference.contains( probe_keys[ i ] ) != histogramm.get_filter( ).contains( probe_keys[ i ] ) ) {
+         std::cout << "Filter fed from the build hashes differs at key " << ( unsigned ) probe_keys[ i ] << "\n";
+         return false;
+      }
+   }
+   std::vector< uint32_t > candidates( DATACOUNT_HASHSET_TEST );
+   size_t const candidate_count = histogramm.get_filter( ).filter( probe_keys.data( ), DATACOUNT_HASHSET_TEST, candidates.data( ) );
+   size_t candidate_position = 0;
+   size_t absent_count = 0;
+   size_t false_positives = 0;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      bool const passed = histogramm.get_filter( ).contains( probe_keys[ i ] );
+      if( passed ) {
+         if( ( candidate_position >= candidate_count ) || ( candidates[ candidate_position ] != probe_keys[ i ] ) ) {
+            std::cout << "Filter kernel differs from scalar filter at key " << ( unsigned ) probe_keys[ i ] << "\n";
+            return false;
+         }
+         ++candidate_position;
+      }
+      if( stl_histo.count( probe_keys[ i ] ) == 0 ) {
+         ++absent_count;
+         if( passed )
+            ++false_positives;
+      }
+   }
+   if( candidate_position != candidate_count )
+      return false;
+#ifdef __AVX2__
+   if( histogramm.get_filter( ).filter_avx2( probe_keys.data( ), DATACOUNT_HASHSET_TEST, candidates.data( ) ) != candidate_count ) {
+      std::cout << "AVX2 filter kernel differs\n";
+      return false;
+   }
+#endif
+   /* 10 bits per key with 8 bits set in a 256 bit block stay below 2 % */
+   if( ( BitsPerKey >= 10 ) && ( false_positives * 50 > absent_count + 50 ) ) {
+      std::cout << "False positive rate too high: " << false_positives << " / " << absent_count << "\n";
+      return false;
+   }
+   size_t result_size = histogramm.probe( probe_keys.data( ), DATACOUNT_HASHSET_TEST, result, result_count );
+   size_t result_position = 0;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      if( stl_histo.count( probe_keys[ i ] ) == 0 )
+         continue;
+      if( ( result_position >= result_size ) || ( result[ result_position ] != probe_keys[ i ] ) ||
+          ( result_count[ result_position ] != stl_histo[ probe_keys[ i ] ] ) ||
+          ( histogramm.get_count( probe_keys[ i ] ) != stl_histo[ probe_keys[ i ] ] ) ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                   << "Key: " << ( unsigned ) probe_keys[ i ]
+                   << " STL-Count: " << stl_histo[ probe_keys[ i ] ] << "\n";
+         std::cout << "WRONG ("<< result_position << " result)\n";
+         return false;
+      }
+      ++result_position;
+   }
+   return ( result_position == result_size );
+}
+
+/* 64-bit keys which share their lower half and differ only in the upper one. Build: 0 scalar elem, 1 vectorized elem,
+ * 2 scalar batch, 3 vectorized batch */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, int Build, class SlotMapping = slot_mapping_modulo >
+bool test_uint64_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   murmur3< uint64_t > const hash_fn;
+   if( hash_fn( 1ULL << 32 ) == hash_fn( 2ULL << 32 ) || ( hash_fn( 1ULL << 40 ) >> 32 ) == 0 ) {
+      std::cout << "murmur3< uint64_t > ignores the upper key bits\n";
+      return false;
+   }
+   std::vector< uint64_t > keys( DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      keys[ i ] = ( ( uint64_t ) ( i % 3 ) << 32 ) | data[ i / 2 ];
+   const_sized_basic_histogramm< uint64_t, SlotMapping > histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   if( Build == 0 )
+      histogramm.build_scalar_elem( keys.data( ) );
+   else if( Build == 1 )
+      histogramm.build_vectorized_elem( keys.data( ) );
+   else if( Build == 2 )
+      histogramm.build_scalar_batch( keys.data( ) );
+   else
+      histogramm.build_vectorized_batch( keys.data( ) );
+   std::unordered_map< uint64_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ keys[ i ] ] = stl_histo[ keys[ i ] ] + 1;
+   if( histogramm.key_count( ) != stl_histo.size( ) || histogramm.get_count( ) != DATACOUNT_HASHSET_TEST ) {
+      std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                << "STL-Keys: " << stl_histo.size( ) << " Keys: " << histogramm.key_count( ) << "\n";
+      return false;
+   }
+   std::vector< uint64_t > probe_result( DATACOUNT_HASHSET_TEST );
+   std::vector< uint64_t > probe_result_count( DATACOUNT_HASHSET_TEST );
+   size_t const result_size = histogramm.probe( keys.data( ), DATACOUNT_HASHSET_TEST, probe_result.data( ), probe_result_count.data( ) );
+   if( result_size != DATACOUNT_HASHSET_TEST )
+      return false;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      size_t const stl_count = stl_histo[ keys[ i ] ];
+      if( ( histogramm.probe_count_vectorized( keys[ i ] ) != stl_count ) || ( histogramm.get_count( keys[ i ] ) != stl_count ) ||
+          ( probe_result[ i ] != keys[ i ] ) || ( probe_result_count[ i ] != stl_count ) ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                   << "Key: " << keys[ i ] << " STL-Count: " << stl_count
+                   << " Count: " << histogramm.get_count( keys[ i ] ) << "\n";
+         std::cout << "WRONG (" << i << " key)\n";
+         return false;
+      }
+   }
+   /* absent keys: same lower half, upper half not generated */
+   if( histogramm.probe_count_vectorized( ( 7ULL << 32 ) | data[ 0 ] ) != 0 )
+      return false;
+   return true;
+}
+
+/* dense keys 1..N/2 and random keys, every key twice, through the given hash policy */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, class HashFunction, bool Batch >
+bool test_hash_function( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   std::vector< uint32_t > keys( DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      keys[ i ] = ( i % 4 < 2 ) ? ( uint32_t ) ( i / 2 + 1 ) : data[ i / 2 ];
+   const_sized_basic_histogramm< uint32_t, slot_mapping_modulo, HashFunction > histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   if( Batch )
+      histogramm.build_vectorized_batch( keys.data( ) );
+   else
+      histogramm.build_scalar_elem( keys.data( ) );
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ keys[ i ] ] = stl_histo[ keys[ i ] ] + 1;
+   if( histogramm.key_count( ) != stl_histo.size( ) ) {
+      std::cout << "STL-Keys: " << stl_histo.size( ) << " Keys: " << histogramm.key_count( ) << "\n";
+      return false;
+   }
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      size_t const stl_count = stl_histo[ keys[ i ] ];
+      if( ( histogramm.probe_count_vectorized( keys[ i ] ) != stl_count ) || ( histogramm.get_count( keys[ i ] ) != stl_count ) ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                   << "Key: " << ( unsigned ) keys[ i ] << " STL-Count: " << stl_count
+                   << " Count: " << histogramm.get_count( keys[ i ] ) << "\n";
+         std::cout << "WRONG (" << i << " key)\n";
+         return false;
+      }
+   }
+   return true;
+}
+
+/* PartCount thread local histogramms over chunks of the keys, merged with the parallel tree merge ( SameSize: all
+ * parts have the merged size ) or folded into one table of the merged size ( chunk sized parts ) */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, typename T, size_t PartCount, size_t ThreadCount, bool SameSize >
+bool test_merge( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   typedef const_sized_basic_histogramm< T > histogramm_t;
+   std::vector< T > keys( DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      keys[ i ] = ( T ) ( ( i % 3 == 0 ) ? data[ i / 2 ] : data[ i ] );
+   size_t const chunk = ( DATACOUNT_HASHSET_TEST + PartCount - 1 ) / PartCount;
+   std::vector< histogramm_t * > parts( PartCount );
+   std::unordered_map< T, size_t > stl_histo;
+   for( size_t p = 0; p < PartCount; ++p ) {
+      size_t const begin = std::min( p * chunk, ( size_t ) DATACOUNT_HASHSET_TEST );
+      size_t const count = std::min( chunk, DATACOUNT_HASHSET_TEST - begin );
+      parts[ p ] = new histogramm_t( SameSize ? DATACOUNT_HASHSET_TEST : ( uint32_t ) std::max( count, ( size_t ) 1 ), loadFactor );
+      parts[ p ]->begin_build( );
+      parts[ p ]->consume( keys.data( ) + begin, count );
+      parts[ p ]->finish_build( );
+      /* a few tombstones in every part: the first keys of the chunk are deleted from it */
+      size_t const deleted = ( count > 8 ) ? 4 : 0;
+      parts[ p ]->delete_batch( keys.data( ) + begin, deleted );
+      for( size_t i = begin; i < begin + count; ++i ) {
+         /* deleted keys stay in the map with their other occurrences only, a count of 0 has to be reported absent */
+         bool const is_deleted =
+            std::find( keys.begin( ) + begin, keys.begin( ) + begin + deleted, keys[ i ] ) != keys.begin( ) + begin + deleted;
+         stl_histo[ keys[ i ] ] += is_deleted ? 0 : 1;
+      }
+   }
+   histogramm_t * merged;
+   histogramm_t * target = nullptr;
+   if( SameSize ) {
+      merged = tree_merge_histogramms( parts.data( ), PartCount, ThreadCount );
+   } else {
+      target = new histogramm_t( DATACOUNT_HASHSET_TEST, loadFactor );
+      for( size_t p = 0; p < PartCount; ++p )
+         target->merge( *parts[ p ] );
+      merged = target;
+   }
+   bool passed = true;
+   size_t stl_keys = 0;
+   for( auto const & entry : stl_histo ) {
+      stl_keys += ( entry.second != 0 ) ? 1 : 0;
+      if( merged->get_count( entry.first ) != entry.second ) {
+         std::cout << "Parts " << PartCount << " Threads " << ThreadCount << " Key: " << ( uint64_t ) entry.first
+                   << " STL-Count: " << entry.second << " Count: " << merged->get_count( entry.first ) << "\n";
+         passed = false;
+         break;
+      }
+   }
+   if( passed && ( merged->key_count( ) != stl_keys ) ) {
+      std::cout << "STL-Keys: " << stl_keys << " Keys: " << merged->key_count( ) << "\n";
+      passed = false;
+   }
+   delete target;
+   for( size_t p = 0; p < PartCount; ++p )
+      delete parts[ p ];
+   return passed;
+}
+
+/* decrement / delete against std::unordered_map, then a sliding window which has to pass several compactions */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, class Allocation >
+bool test_allocation( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   /* a container of a few huge pages plus a partial one, independent of the data size, has to come back zeroed */
+   size_t const raw_count = 3 * ( 2 * 1024 * 1024 / sizeof( uint64_t ) ) + 5;
+   uint64_t * const raw = Allocation::template allocate< uint64_t >( raw_count );
+   for( size_t i = 0; i < raw_count; ++i ) {
+      if( raw[ i ] != 0 ) {
+         std::cout << "Container not zeroed at " << i << "\n";
+         return false;
+      }
+      raw[ i ] = i;
+   }
+   Allocation::deallocate( raw, raw_count );
+
+   const_sized_basic_histogramm< uint32_t, slot_mapping_modulo, murmur3< uint32_t >, Allocation > histogramm{
+      DATACOUNT_HASHSET_TEST, loadFactor };
+   if( histogramm.get_count( ) != 0 ) {
+      std::cout << "Fresh histogramm holds " << histogramm.get_count( ) << " keys\n";
+      return false;
+   }
+   histogramm.build_vectorized_batch( data );
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ data[ i ] ] = stl_histo[ data[ i ] ] + 1;
+   size_t checked_key = 0;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      size_t alloc_count = histogramm.probe_count_vectorized( data[ i ] );
+      size_t stl_count = stl_histo[ data[ i ] ];
+      if( alloc_count != stl_count ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                   << "Key: " << ( unsigned ) data[ i ]
+                   << " STL-Count: " << stl_count
+                   << " ALLOC-Count: " << ( unsigned ) alloc_count << "\n";
+         std::cout << "WRONG ("<<checked_key << " key)\n";
+         return false;
+      }
+      ++checked_key;
+   }
+   return true;
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, class SlotMapping = slot_mapping_modulo >
+bool test_remove( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   std::vector< uint32_t > keys( data, data + DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; i += 3 )
+      keys[ i ] = keys[ i / 2 ];
+   const_sized_basic_histogramm< uint32_t, SlotMapping > histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   histogramm.set_compaction_threshold( 100 - loadFactor );
+   histogramm.build_vectorized_batch( keys.data( ) );
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ keys[ i ] ] = stl_histo[ keys[ i ] ] + 1;
+   /* first quarter decremented once per occurrence, second quarter deleted, absent keys on top */
+   size_t const quarter = DATACOUNT_HASHSET_TEST / 4;
+   size_t expected_missing = 0;
+   for( size_t i = 0; i < quarter; ++i ) {
+      if( stl_histo[ keys[ i ] ] == 0 )
+         ++expected_missing;
+      else
+         --stl_histo[ keys[ i ] ];
+   }
+   size_t missing = histogramm.decrement_batch( keys.data( ), quarter );
+   for( size_t i = quarter; i < 2 * quarter; ++i ) {
+      if( stl_histo[ keys[ i ] ] == 0 )
+         ++expected_missing;
+      stl_histo[ keys[ i ] ] = 0;
+   }
+   missing += histogramm.delete_batch( keys.data( ) + quarter, quarter );
+   uint32_t const absent[ 3 ] = { 0x7FFFFFFF, 0x12345, 0xFFFFFFFE };
+   for( size_t i = 0; i < 3; ++i ) {
+      if( stl_histo[ absent[ i ] ] == 0 )
+         ++expected_missing;
+      else
+         --stl_histo[ absent[ i ] ];
+   }
+   missing += histogramm.decrement_batch( absent, 3 );
+   size_t stl_keys = 0;
+   for( auto const & entry : stl_histo )
+      stl_keys += ( entry.second != 0 ) ? 1 : 0;
+   if( ( missing != expected_missing ) || ( histogramm.key_count( ) != stl_keys ) ) {
+      std::cout << "Missing " << missing << " expected " << expected_missing << " Keys " << histogramm.key_count( )
+                << " STL-Keys " << stl_keys << "\n";
+      return false;
+   }
+   size_t const result_size = histogramm.probe_grouped( keys.data( ), DATACOUNT_HASHSET_TEST, result, result_count );
+   size_t expected_result_size = 0;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      size_t const stl_count = stl_histo[ keys[ i ] ];
+      expected_result_size += ( stl_count != 0 ) ? 1 : 0;
+      if( ( histogramm.get_count( keys[ i ] ) != stl_count ) || ( histogramm.probe_count_vectorized( keys[ i ] ) != stl_count ) ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                   << "Key: " << keys[ i ] << " STL-Count: " << stl_count
+                   << " Count: " << histogramm.get_count( keys[ i ] ) << "\n";
+         std::cout << "WRONG (" << i << " key)\n";
+         return false;
+      }
+   }
+   if( result_size != expected_result_size )
+      return false;
+   /* revive a deleted key */
+   histogramm.begin_build( );
+   histogramm.consume( keys.data( ) + quarter, 1 );
+   histogramm.finish_build( );
+   if( histogramm.get_count( keys[ quarter ] ) != 1 )
+      return false;
+
+   /* sliding window of a quarter of the keys, moved by chunks of an eighth of the window */
+   size_t const step = std::max( ( size_t ) 1, quarter / 8 );
+   /* the window holds up to quarter + step keys between insert and expiry */
+   const_sized_basic_histogramm< uint32_t, SlotMapping > window{ ( uint32_t ) ( quarter + step ), loadFactor };
+   window.set_compaction_threshold( ( 100 - loadFactor ) / 2 );
+   std::unordered_map< uint32_t, size_t > stl_window;
+   for( size_t position = 0; position + step <= DATACOUNT_HASHSET_TEST; position += step ) {
+      window.begin_build( );
+      window.consume( keys.data( ) + position, step );
+      window.finish_build( );
+      for( size_t i = position; i < position + step; ++i )
+         ++stl_window[ keys[ i ] ];
+      if( position >= quarter ) {
+         window.decrement_batch( keys.data( ) + position - quarter, step );
+         for( size_t i = position - quarter; i < position - quarter + step; ++i )
+            --stl_window[ keys[ i ] ];
+      }
+      if( window.get_tombstone_count( ) * 100 > ( size_t ) window.get_size( ) * ( ( 100 - loadFactor ) / 2 ) )
+         return false;
+   }
+   for( auto const & entry : stl_window ) {
+      if( window.get_count( entry.first ) != entry.second ) {
+         std::cout << "Window Key: " << entry.first << " STL-Count: " << entry.second
+                   << " Count: " << window.get_count( entry.first ) << "\n";
+         return false;
+      }
+   }
+   return true;
+}
+
+/* slots with key != 0 and count == 0 */
+template< class Histogramm >
+size_t scan_tombstones( Histogramm const & histogramm ) {
+   size_t result = 0;
+   for( size_t slot = 0; slot < histogramm.get_size( ); ++slot ) {
+      result += ( ( histogramm.get_key_container( )[ slot ] != 0 ) && ( histogramm.get_key_count_container( )[ slot ] == 0 ) ) ? 1 : 0;
+   }
+   return result;
+}
+
+/* tombstone_count against a scan of the containers after keys were removed and inserted again by every build and merge */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, class SlotMapping = slot_mapping_modulo >
+bool test_revive( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   typedef const_sized_basic_histogramm< uint32_t, SlotMapping > histogramm_t;
+   ( void ) result;
+   ( void ) result_count;
+   bool passed = true;
+   /* one key expired and inserted again, as in a sliding window */
+   {
+      histogramm_t histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+      histogramm.set_compaction_threshold( 100 );
+      histogramm.build_vectorized_batch( data );
+      for( size_t round = 0; round < 5; ++round ) {
+         histogramm.delete_batch( data + 5, 1 );
+         histogramm.begin_build( );
+         histogramm.consume( data + 5, 1 );
+         histogramm.finish_build( );
+      }
+      histogramm.delete_batch( data + 5, 1 );
+      passed &= ( histogramm.get_tombstone_count( ) == 1 ) && ( scan_tombstones( histogramm ) == 1 );
+   }
+   /* the first half of the keys deleted, then the keys built again */
+   size_t const half = DATACOUNT_HASHSET_TEST / 2;
+   for( size_t variant = 0; variant < 9; ++variant ) {
+      histogramm_t histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+      histogramm.set_compaction_threshold( 100 );
+      histogramm.build_vectorized_batch( data );
+      histogramm.delete_batch( data, half );
+      size_t const tombstones = histogramm.get_tombstone_count( );
+      passed &= ( tombstones == scan_tombstones( histogramm ) );
+      if( variant == 0 ) {
+         histogramm.build_scalar_elem( data );
+      } else if( variant == 1 ) {
+         histogramm.build_vectorized_elem( data );
+      } else if( variant == 2 ) {
+         histogramm.build_scalar_batch( data );
+      } else if( variant == 3 ) {
+         histogramm.build_vectorized_batch( data );
+      } else if( variant == 4 ) {
+         histogramm.build_concurrent_delta( data, DATACOUNT_HASHSET_TEST );
+      } else if( variant == 5 ) {
+#if defined( __AVX512F__ ) && defined( __AVX512CD__ )
+         histogramm.build_avx512( data );
+#else
+         histogramm.build_scalar_elem( data );
+#endif
+      } else if( variant == 6 ) {
+#ifdef __AVX2__
+         histogramm.build_avx2( data );
+#else
+         histogramm.build_scalar_elem( data );
+#endif
+      } else if( variant == 7 ) {
+         /* same size: slot by slot */
+         histogramm_t other{ DATACOUNT_HASHSET_TEST, loadFactor };
+         other.build_vectorized_batch( data );
+         histogramm.merge( other );
+      } else {
+         /* other size: key by key */
+         histogramm_t other{ DATACOUNT_HASHSET_TEST, ( loadFactor > 25 ) ? loadFactor - 20 : loadFactor + 20 };
+         other.build_vectorized_batch( data );
+         histogramm.merge( other );
+      }
+      if( ( histogramm.get_tombstone_count( ) != 0 ) || ( scan_tombstones( histogramm ) != 0 ) ) {
+         std::cout << "Revive variant " << variant << " Tombstones before " << tombstones << " after "
+                   << histogramm.get_tombstone_count( ) << " Scan " << scan_tombstones( histogramm ) << "\n";
+         passed = false;
+      }
+   }
+   return passed;
+}
+
+/* streaming build from chunks of ChunkSize keys (0: random sizes) copied into one reused buffer */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, size_t ChunkSize, class SlotMapping = slot_mapping_modulo >
+bool test_stream_build( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   std::vector< uint32_t > keys( data, data + DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; i += 3 )
+      keys[ i ] = keys[ i / 2 ];
+   const_sized_basic_histogramm< uint32_t, SlotMapping > histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   std::vector< uint32_t > chunk( 4096 );
+   std::mt19937 generator( 4711 );
+   std::uniform_int_distribution< size_t > chunk_size_dist( 0, 4096 );
+   histogramm.begin_build( );
+   for( size_t position = 0; position < DATACOUNT_HASHSET_TEST; ) {
+      size_t const chunk_size = std::min( ( ChunkSize == 0 ) ? chunk_size_dist( generator ) : ChunkSize,
+                                          DATACOUNT_HASHSET_TEST - position );
+      std::copy( keys.begin( ) + position, keys.begin( ) + position + chunk_size, chunk.begin( ) );
+      histogramm.consume( chunk.data( ), chunk_size );
+      std::fill( chunk.begin( ), chunk.end( ), 0 );
+      position += chunk_size;
+   }
+   histogramm.finish_build( );
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ keys[ i ] ] = stl_histo[ keys[ i ] ] + 1;
+   if( ( histogramm.key_count( ) != stl_histo.size( ) ) || ( histogramm.get_count( ) != DATACOUNT_HASHSET_TEST ) ) {
+      std::cout << "Chunk size " << ChunkSize << " STL-Keys: " << stl_histo.size( ) << " Keys: " << histogramm.key_count( )
+                << " Count: " << histogramm.get_count( ) << "\n";
+      return false;
+   }
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      size_t const stl_count = stl_histo[ keys[ i ] ];
+      if( histogramm.get_count( keys[ i ] ) != stl_count ) {
+         std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << " Chunk size " << ChunkSize << ".\n"
+                   << "Key: " << keys[ i ] << " STL-Count: " << stl_count
+                   << " Count: " << histogramm.get_count( keys[ i ] ) << "\n";
+         std::cout << "WRONG (" << i << " key)\n";
+         return false;
+      }
+   }
+   return true;
+}
+
+/* save, map and probe the mapped containers, one deleted key has to stay a tombstone in the file; files of other
+ * policies, versions or sizes must be rejected */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, class SlotMapping = slot_mapping_modulo >
+bool test_mapped( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   std::string const path = "hash_set_test_" + std::to_string( ( long ) getpid( ) ) + ".histo";
+   std::vector< uint32_t > keys( data, data + DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; i += 3 )
+      keys[ i ] = keys[ i / 2 ];
+   bool passed = true;
+   size_t tombstone_count = 0;
+   {
+      const_sized_basic_histogramm< uint32_t, SlotMapping > histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+      histogramm.build_vectorized_batch( keys.data( ) );
+      histogramm.delete_batch( keys.data( ) + 1, 1 );
+      tombstone_count = histogramm.get_tombstone_count( );
+      if( !save_histogramm( histogramm, path.c_str( ) ) ) {
+         std::cout << "Could not write " << path << "\n";
+         return false;
+      }
+   }
+   passed &= ( tombstone_count == 1 );
+   std::unordered_map< uint32_t, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ keys[ i ] ] = stl_histo[ keys[ i ] ] + 1;
+   stl_histo.erase( keys[ 1 ] );
+   {
+      mapped_histogramm< uint32_t, SlotMapping > mapped{ path.c_str( ) };
+      if( !mapped.is_valid( ) ) {
+         std::cout << "Could not map " << path << "\n";
+         ::unlink( path.c_str( ) );
+         return false;
+      }
+      auto const & histogramm = mapped.get_histogramm( );
+      passed &= ( histogramm.key_count( ) == stl_histo.size( ) );
+      passed &= ( histogramm.get_tombstone_count( ) == tombstone_count );
+      for( size_t i = 0; passed && ( i < DATACOUNT_HASHSET_TEST ); ++i ) {
+         size_t const stl_count = stl_histo[ keys[ i ] ];
+         if( ( histogramm.probe_count_vectorized( keys[ i ] ) != stl_count ) || ( histogramm.get_count( keys[ i ] ) != stl_count ) ) {
+            std::cout << "LoadFactor = " << (float)(((float)loadFactor)/100.0f) << ".\n"
+                      << "Key: " << keys[ i ] << " STL-Count: " << stl_count
+                      << " Count: " << histogramm.get_count( keys[ i ] ) << "\n";
+            std::cout << "WRONG (" << i << " key)\n";
+            passed = false;
+         }
+      }
+      size_t const result_size = histogramm.probe_grouped( keys.data( ), DATACOUNT_HASHSET_TEST, result, result_count );
+      size_t result_position = 0;
+      for( size_t i = 0; passed && ( i < DATACOUNT_HASHSET_TEST ); ++i ) {
+         if( stl_histo[ keys[ i ] ] == 0 )
+            continue;
+         passed &= ( result_position < result_size ) && ( result[ result_position ] == keys[ i ] ) &&
+                   ( result_count[ result_position ] == stl_histo[ keys[ i ] ] );
+         ++result_position;
+      }
+      passed &= ( result_position == result_size );
+      passed &= ( histogramm.probe_count_vectorized( 0x7FFFFFFF ) == stl_histo[ 0x7FFFFFFF ] );
+   }
+   passed &= !mapped_histogramm< uint64_t, SlotMapping >{ path.c_str( ) }.is_valid( );
+   passed &= !mapped_histogramm< uint32_t, SlotMapping, multiply_shift< uint32_t > >{ path.c_str( ) }.is_valid( );
+   passed &= !mapped_histogramm< uint32_t, slot_mapping_power_of_two >{ path.c_str( ) }.is_valid( ) ||
+             std::is_same< SlotMapping, slot_mapping_power_of_two >::value;
+   passed &= !mapped_histogramm< uint32_t, SlotMapping >{ ( path + ".missing" ).c_str( ) }.is_valid( );
+   uint32_t const next_version = HISTOGRAMM_FILE_VERSION + 1;
+   int fd = ::open( path.c_str( ), O_WRONLY );
+   passed &= ( ::pwrite( fd, &next_version, sizeof( next_version ), offsetof( histogramm_file_header, version ) ) == sizeof( next_version ) );
+   ::close( fd );
+   passed &= !mapped_histogramm< uint32_t, SlotMapping >{ path.c_str( ) }.is_valid( );
+   passed &= ( ::truncate( path.c_str( ), 4096 ) == 0 );
+   passed &= !mapped_histogramm< uint32_t, SlotMapping >{ path.c_str( ) }.is_valid( );
+   ::unlink( path.c_str( ) );
+   if( !passed )
+      std::cout << "Mapped histogramm LoadFactor = " << loadFactor << " WRONG\n";
+   return passed;
+}
+
+/* kernel 0: dispatching hash_batch, 1: scalar, 2: AVX-512, 3: AVX2; unavailable kernels fall back to scalar */
+void hash_batch_kernel( murmur3< uint32_t > const & hash_fn, size_t const kernel,
+                        uint32_t const * const keys, size_t const count, uint32_t * const out ) {
+   if( kernel == 0 ) {
+      hash_fn.hash_batch( keys, count, out );
+#ifdef __AVX512F__
+   } else if( kernel == 2 ) {
+      hash_fn.hash_batch_avx512( keys, count, out );
+#endif
+#ifdef __AVX2__
+   } else if( kernel == 3 ) {
+      hash_fn.hash_batch_avx2( keys, count, out );
+#endif
+   } else {
+      hash_fn.hash_batch_scalar( keys, count, out );
+   }
+}
+void hash_batch_kernel( murmur3< uint64_t > const & hash_fn, size_t const kernel,
+                        uint64_t const * const keys, size_t const count, uint64_t * const out ) {
+   if( kernel == 0 ) {
+      hash_fn.hash_batch( keys, count, out );
+#if defined( __AVX512F__ ) && defined( __AVX512DQ__ )
+   } else if( kernel == 2 ) {
+      hash_fn.hash_batch_avx512( keys, count, out );
+#endif
+   } else {
+      hash_fn.hash_batch_scalar( keys, count, out );
+   }
+}
+
+/* longest run of occupied slots over the containers laid out twice, so a run across the end is seen in one piece */
+template< class Histogramm >
+size_t longest_cluster_scan( Histogramm const & histogramm ) {
+   size_t const size = histogramm.get_size( );
+   size_t result = 0;
+   size_t run = 0;
+   for( size_t i = 0; i < 2 * size; ++i ) {
+      run = ( histogramm.get_key_container( )[ i % size ] != 0 ) ? run + 1 : 0;
+      result = std::max( result, std::min( run, size ) );
+   }
+   return result;
+}
+
+/**
+ * Checks the longest cluster and, with HASH_SET_STATISTICS, the counters of a histogramm built from count keys.
+ * In the 256-lane builds every retry moves the lane one slot further, so the retries sum up to the insert probe
+ * lengths.
+ */
+template< class Histogramm >
+bool check_statistics( Histogramm & histogramm, uint32_t const * const keys, size_t const count, bool const lane_build,
+                       uint32_t * const result, uint32_t * const result_count, char const * const name ) {
+   size_t const cluster = histogramm.longest_cluster( );
+   if( cluster != longest_cluster_scan( histogramm ) ) {
+      std::cout << name << " Longest cluster: " << cluster << " Scan: " << longest_cluster_scan( histogramm ) << "\n";
+      return false;
+   }
+#ifdef HASH_SET_STATISTICS
+   histogramm_statistics const & statistics = histogramm.get_statistics( );
+   size_t const buckets = histogramm_statistics::PROBE_LENGTH_BUCKETS;
+   if( ( statistics.occupied_slots != histogramm.key_count( ) ) ||
+       ( histogramm_statistics::total( statistics.insert_probe_lengths ) != count ) ) {
+      std::cout << name << " Occupied: " << statistics.occupied_slots << " Keys: " << histogramm.key_count( )
+                << " Inserts: " << histogramm_statistics::total( statistics.insert_probe_lengths ) << "\n";
+      return false;
+   }
+   uint64_t probed_slots = 0;
+   for( size_t i = 0; i < buckets; ++i ) {
+      probed_slots += i * statistics.insert_probe_lengths[ i ];
+   }
+   if( lane_build && ( statistics.insert_probe_lengths[ buckets - 1 ] == 0 ) &&
+       ( statistics.batch_lane_retries != probed_slots ) ) {
+      std::cout << name << " Retries: " << statistics.batch_lane_retries << " Probed slots: " << probed_slots << "\n";
+      return false;
+   }
+   histogramm.reset_statistics( );
+   histogramm.probe_grouped( keys, count, result, result_count );
+   for( size_t i = 0; i < count; ++i ) {
+      histogramm.get_count( keys[ i ] );
+   }
+   /* a key found d slots behind its home slot sits in a run of at least d + 1 occupied slots */
+   size_t const longest_lookup = histogramm_statistics::percentile( statistics.lookup_probe_lengths, 1000 );
+   if( ( histogramm_statistics::total( statistics.lookup_probe_lengths ) != 2 * count ) ||
+       ( ( cluster < buckets - 1 ) && ( longest_lookup >= cluster ) ) ||
+       ( statistics.batch_lane_retries != 0 ) || ( histogramm_statistics::total( statistics.insert_probe_lengths ) != 0 ) ) {
+      std::cout << name << " Lookups: " << histogramm_statistics::total( statistics.lookup_probe_lengths )
+                << " Longest lookup: " << longest_lookup << " Longest cluster: " << cluster << "\n";
+      return false;
+   }
+#else
+   ( void ) keys;
+   ( void ) count;
+   ( void ) lane_build;
+   ( void ) result;
+   ( void ) result_count;
+#endif
+   return true;
+}
+
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, class SlotMapping = slot_mapping_modulo >
+bool test_statistics( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   typedef const_sized_basic_histogramm< uint32_t, SlotMapping > histogramm_t;
+   std::vector< uint32_t > keys( data, data + DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; i += 3 )
+      keys[ i ] = keys[ i / 2 ];
+   bool passed = true;
+   {
+      histogramm_t histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+      histogramm.build_scalar_elem( keys.data( ) );
+      passed &= check_statistics( histogramm, keys.data( ), DATACOUNT_HASHSET_TEST, false, result, result_count, "SCALAR_ELEM" );
+   }
+   {
+      histogramm_t histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+      histogramm.build_scalar_batch( keys.data( ) );
+      passed &= check_statistics( histogramm, keys.data( ), DATACOUNT_HASHSET_TEST, true, result, result_count, "SCALAR_BATCH" );
+   }
+   {
+      histogramm_t histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+      histogramm.begin_build( );
+      for( size_t position = 0; position < DATACOUNT_HASHSET_TEST; position += 1000 )
+         histogramm.consume( keys.data( ) + position, std::min( ( size_t ) 1000, DATACOUNT_HASHSET_TEST - position ) );
+      histogramm.finish_build( );
+      passed &= check_statistics( histogramm, keys.data( ), DATACOUNT_HASHSET_TEST, true, result, result_count, "STREAM" );
+   }
+#if defined( __AVX512F__ ) && defined( __AVX512CD__ )
+   {
+      histogramm_t histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+      histogramm.build_avx512( keys.data( ) );
+      passed &= check_statistics( histogramm, keys.data( ), DATACOUNT_HASHSET_TEST, false, result, result_count, "AVX512" );
+   }
+#endif
+   {
+      histogramm_t histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+      histogramm.build_vectorized_batch( keys.data( ) );
+      passed &= check_statistics( histogramm, keys.data( ), DATACOUNT_HASHSET_TEST, true, result, result_count, "AUTOVEC_BATCH" );
+      /* tombstones keep their slots until the compaction */
+      histogramm.set_compaction_threshold( 100 );
+      size_t const half = DATACOUNT_HASHSET_TEST / 2;
+      histogramm.delete_batch( keys.data( ), half );
+      passed &= ( histogramm.longest_cluster( ) == longest_cluster_scan( histogramm ) );
+#ifdef HASH_SET_STATISTICS
+      passed &= ( histogramm.get_occupied_count( ) == histogramm.key_count( ) + histogramm.get_tombstone_count( ) );
+#endif
+      histogramm.compact( );
+      passed &= ( histogramm.longest_cluster( ) == longest_cluster_scan( histogramm ) );
+#ifdef HASH_SET_STATISTICS
+      passed &= ( histogramm.get_occupied_count( ) == histogramm.key_count( ) );
+#endif
+   }
+   return passed;
+}
+
+/* hash_batch of every kernel against the scalar hash, for all tail lengths up to 40 and the full array */
+template< uint32_t DATACOUNT_HASHSET_TEST, typename T >
+bool test_hash_batch( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   typedef typename murmur3< T >::hash_type hash_t;
+   std::vector< T > keys( DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      keys[ i ] = ( T ) ( ( ( uint64_t ) data[ ( i * 7 ) % DATACOUNT_HASHSET_TEST ] << ( sizeof( T ) * 4 ) ) ^ data[ i ] );
+   std::vector< hash_t > hashes( DATACOUNT_HASHSET_TEST + 1 );
+   murmur3< T > const seeded[ 2 ] = { murmur3< T >{ }, murmur3< T >{ 0x5bd1e995 } };
+   for( size_t s = 0; s < 2; ++s ) {
+      murmur3< T > const & hash_fn = seeded[ s ];
+      for( size_t step = 0; step <= 41; ++step ) {
+         size_t const count = ( step <= 40 ) ? step : DATACOUNT_HASHSET_TEST;
+         for( size_t kernel = 0; kernel < 4; ++kernel ) {
+            /* the slot behind the batch must stay untouched by masked tails */
+            hashes[ count ] = ( hash_t ) 0xDEADBEEF;
+            hash_batch_kernel( hash_fn, kernel, keys.data( ), count, hashes.data( ) );
+            if( hashes[ count ] != ( hash_t ) 0xDEADBEEF ) {
+               std::cout << "Kernel " << kernel << " wrote behind " << count << " keys.\n";
+               return false;
+            }
+            for( size_t i = 0; i < count; ++i ) {
+               if( hashes[ i ] != hash_fn( keys[ i ] ) ) {
+                  std::cout << "Kernel " << kernel << " Count: " << count << " Key: " << ( uint64_t ) keys[ i ]
+                            << " Hash: " << ( uint64_t ) hashes[ i ] << " Expected: " << ( uint64_t ) hash_fn( keys[ i ] ) << "\n";
+                  std::cout << "WRONG (" << i << " key)\n";
+                  return false;
+               }
+            }
+         }
+      }
+   }
+   return true;
+}
+
+/* estimate within five standard errors of the exact distinct count, SIMD and scalar build and the merge of chunk
+ * sketches have to end in the same registers */
+template< uint32_t DATACOUNT_HASHSET_TEST, typename T, size_t Precision >
+bool test_hyperloglog( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   size_t const distinct_steps[ 3 ] = { DATACOUNT_HASHSET_TEST / 100, DATACOUNT_HASHSET_TEST / 4, DATACOUNT_HASHSET_TEST };
+   std::vector< T > keys( DATACOUNT_HASHSET_TEST );
+   for( size_t step = 0; step < 3; ++step ) {
+      for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+         size_t const position = i % distinct_steps[ step ];
+         keys[ i ] = ( T ) ( ( ( uint64_t ) data[ ( position * 7 ) % DATACOUNT_HASHSET_TEST ] << ( sizeof( T ) * 4 ) ) ^ data[ position ] );
+      }
+      std::unordered_map< T, size_t > stl_histo;
+      for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+         stl_histo[ keys[ i ] ] = stl_histo[ keys[ i ] ] + 1;
+      hyperloglog< T > sketch{ Precision };
+      sketch.build( keys.data( ), DATACOUNT_HASHSET_TEST );
+      double const exact = ( double ) stl_histo.size( );
+      double const estimate = sketch.estimate( );
+      if( std::fabs( estimate - exact ) > 5.0 * sketch.get_standard_error( ) * exact + 1.0 ) {
+         std::cout << "Precision: " << Precision << " Exact: " << exact << " Estimate: " << estimate << "\n";
+         return false;
+      }
+      if( sketch.estimate_upper_bound( ) < ( size_t ) exact ) {
+         std::cout << "Precision: " << Precision << " Exact: " << exact << " Upper bound: " << sketch.estimate_upper_bound( ) << "\n";
+         return false;
+      }
+      hyperloglog< T > scalar_sketch{ Precision };
+      scalar_sketch.build_scalar( keys.data( ), DATACOUNT_HASHSET_TEST );
+      /* uneven chunks, so the SIMD kernel sees all tail lengths */
+      hyperloglog< T > merged_sketch{ Precision };
+      size_t chunk_start = 0;
+      for( size_t chunk = 1; chunk_start < DATACOUNT_HASHSET_TEST; ++chunk ) {
+         size_t const chunk_size = std::min( chunk * 37, DATACOUNT_HASHSET_TEST - chunk_start );
+         hyperloglog< T > chunk_sketch{ Precision };
+         chunk_sketch.build( keys.data( ) + chunk_start, chunk_size );
+         merged_sketch.merge( chunk_sketch );
+         chunk_start += chunk_size;
+      }
+      for( size_t i = 0; i < sketch.get_register_count( ); ++i ) {
+         if( ( scalar_sketch.get_registers( )[ i ] != sketch.get_registers( )[ i ] ) ||
+             ( merged_sketch.get_registers( )[ i ] != sketch.get_registers( )[ i ] ) ) {
+            std::cout << "Register " << i << " Build: " << ( unsigned ) sketch.get_registers( )[ i ]
+                      << " Scalar: " << ( unsigned ) scalar_sketch.get_registers( )[ i ]
+                      << " Merged: " << ( unsigned ) merged_sketch.get_registers( )[ i ] << "\n";
+            return false;
+         }
+      }
+      hyperloglog< T > other_precision{ Precision + 1 };
+      if( merged_sketch.merge( other_precision ) )
+         return false;
+   }
+   return true;
+}
+
+/* batched and scalar build, chunk sketches merged and the batched lookup have to agree exactly. The count-min estimate
+ * is never below the exact count, both stay within e * N / Width for all but a few keys */
+template< uint32_t DATACOUNT_HASHSET_TEST, typename T, bool Signed, size_t Width, size_t Depth >
+bool test_count_min_sketch( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   typedef count_min_sketch< T, Signed > sketch_t;
+   typedef typename sketch_t::counter_t counter_t;
+   size_t const distinct = DATACOUNT_HASHSET_TEST / 8;
+   std::vector< T > keys( DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      /* skewed counts: key position p occurs about distinct / ( p + 1 ) times more often than the last one */
+      size_t const position = ( i * i ) % distinct * ( i % distinct ) / distinct;
+      keys[ i ] = ( T ) ( ( ( uint64_t ) data[ ( position * 7 ) % DATACOUNT_HASHSET_TEST ] << ( sizeof( T ) * 4 ) ) ^ data[ position ] );
+   }
+   std::unordered_map< T, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ keys[ i ] ] = stl_histo[ keys[ i ] ] + 1;
+   sketch_t sketch{ Width, Depth };
+   sketch.build( keys.data( ), DATACOUNT_HASHSET_TEST );
+   sketch_t scalar_sketch{ Width, Depth };
+   scalar_sketch.build_scalar( keys.data( ), DATACOUNT_HASHSET_TEST );
+   /* uneven chunks, so the SIMD kernel sees all tail lengths */
+   sketch_t merged_sketch{ Width, Depth };
+   size_t chunk_start = 0;
+   for( size_t chunk = 1; chunk_start < DATACOUNT_HASHSET_TEST; ++chunk ) {
+      size_t const chunk_size = std::min( chunk * 37, DATACOUNT_HASHSET_TEST - chunk_start );
+      sketch_t chunk_sketch{ Width, Depth };
+      chunk_sketch.build( keys.data( ) + chunk_start, chunk_size );
+      merged_sketch.merge( chunk_sketch );
+      chunk_start += chunk_size;
+   }
+   if( ( sketch.get_total_count( ) != DATACOUNT_HASHSET_TEST ) || ( merged_sketch.get_total_count( ) != DATACOUNT_HASHSET_TEST ) )
+      return false;
+   for( size_t i = 0; i < Width * sketch.get_depth( ); ++i ) {
+      if( ( scalar_sketch.get_counters( )[ i ] != sketch.get_counters( )[ i ] ) ||
+          ( merged_sketch.get_counters( )[ i ] != sketch.get_counters( )[ i ] ) ) {
+         std::cout << "Counter " << i << " Build: " << ( int64_t ) sketch.get_counters( )[ i ]
+                   << " Scalar: " << ( int64_t ) scalar_sketch.get_counters( )[ i ]
+                   << " Merged: " << ( int64_t ) merged_sketch.get_counters( )[ i ] << "\n";
+         return false;
+      }
+   }
+   sketch_t other_width{ Width + 1, Depth };
+   if( merged_sketch.merge( other_width ) )
+      return false;
+   std::vector< counter_t > counts( DATACOUNT_HASHSET_TEST );
+   sketch.get_counts( keys.data( ), DATACOUNT_HASHSET_TEST, counts.data( ) );
+   double const bound = 2.718281828 * ( double ) DATACOUNT_HASHSET_TEST / ( double ) Width;
+   size_t outside_bound = 0;
+   for( auto const & entry : stl_histo ) {
+      counter_t const estimate = sketch.get_count( entry.first );
+      double const error = ( double ) ( int64_t ) estimate - ( double ) entry.second;
+      if( !Signed && ( error < 0.0 ) ) {
+         std::cout << "Key: " << ( uint64_t ) entry.first << " Exact: " << entry.second << " Estimate: " << ( int64_t ) estimate << "\n";
+         return false;
+      }
+      outside_bound += ( error > bound || -error > bound ) ? 1 : 0;
+   }
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i ) {
+      if( counts[ i ] != sketch.get_count( keys[ i ] ) ) {
+         std::cout << "Key: " << ( uint64_t ) keys[ i ] << " Batched: " << ( int64_t ) counts[ i ]
+                   << " Single: " << ( int64_t ) sketch.get_count( keys[ i ] ) << "\n";
+         return false;
+      }
+   }
+   /* e^-Depth of the keys may miss the bound, 5 % leaves room for the small samples */
+   if( outside_bound * 20 > stl_histo.size( ) ) {
+      std::cout << "Width: " << Width << " Depth: " << Depth << " " << outside_bound << " of " << stl_histo.size( )
+                << " keys beyond " << bound << "\n";
+      return false;
+   }
+   return true;
+}
+
+/* export in slot order and sorted by key against the containers and the STL histogramm, with tombstones of deleted
+ * keys in the table */
+template< uint32_t loadFactor, uint32_t DATACOUNT_HASHSET_TEST, typename T, size_t ThreadCount, class SlotMapping = slot_mapping_modulo >
+bool test_export( uint32_t const * const data, uint32_t * const result, uint32_t * const result_count ) {
+   std::vector< T > keys( DATACOUNT_HASHSET_TEST );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      keys[ i ] = ( T ) ( ( ( uint64_t ) data[ ( i * 7 ) % DATACOUNT_HASHSET_TEST ] << ( sizeof( T ) * 4 ) ) ^ data[ i ] );
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; i += 3 )
+      keys[ i ] = keys[ i / 2 ];
+   const_sized_basic_histogramm< T, SlotMapping > histogramm{ DATACOUNT_HASHSET_TEST, loadFactor };
+   histogramm.set_compaction_threshold( 100 );
+   histogramm.build_vectorized_batch( keys.data( ) );
+   size_t const deleted = DATACOUNT_HASHSET_TEST / 10;
+   histogramm.delete_batch( keys.data( ), deleted );
+   std::unordered_map< T, size_t > stl_histo;
+   for( size_t i = 0; i < DATACOUNT_HASHSET_TEST; ++i )
+      stl_histo[ keys[ i ] ] = stl_histo[ keys[ i ] ] + 1;
+   for( size_t i = 0; i < deleted; ++i )
+      stl_histo.erase( keys[ i ] );
+   if( histogramm.get_tombstone_count( ) == 0 )
+      return false;
+   size_t const expected = histogramm.key_count( );
+   std::vector< T > exported_keys( expected + 1 );
+   std::vector< uint64_t > exported_counts( expected + 1 );
+   /* slot order */
+   exported_keys[ expected ] = ( T ) 0xDEADBEEF;
+   if( export_histogramm( histogramm, exported_keys.data( ), exported_counts.data( ), false, ThreadCount ) != expected )
+      return false;
+   size_t position = 0;
+   for( size_t slot = 0; slot < histogramm.get_size( ); ++slot ) {
+      if( histogramm.get_key_count_container( )[ slot ] == 0 )
+         continue;
+      if( ( exported_keys[ position ] != histogramm.get_key_container( )[ slot ] ) ||
+          ( exported_counts[ position ] != histogramm.get_key_count_container( )[ slot ] ) ) {
+         std::cout << "Slot " << slot << " Key: " << ( uint64_t ) histogramm.get_key_container( )[ slot ]
+                   << " Exported: " << ( uint64_t ) exported_keys[ position ] << "\n";
+         return false;
+      }
+      ++position;
+   }
+   /* key order */
+   if( ( exported_keys[ expected ] != ( T ) 0xDEADBEEF ) ||
+       ( export_histogramm( histogramm, exported_keys.data( ), exported_counts.data( ), true, ThreadCount ) != expected ) ||
+       ( expected != stl_histo.size( ) ) )
+      return false;
+   for( size_t i = 0; i < expected; ++i ) {
+      auto const entry = stl_histo.find( exported_keys[ i ] );
+      if( ( ( i > 0 ) && !( exported_keys[ i - 1 ] < exported_keys[ i ] ) ) || ( entry == stl_histo.end( ) ) ||
+          ( entry->second != exported_counts[ i ] ) ) {
+         std::cout << "Sorted position " << i << " Key: " << ( uint64_t ) exported_keys[ i ]
+                   << " Count: " << exported_counts[ i ] << "\n";
+         return false;
+      }
+   }
+   return exported_keys[ expected ] == ( T ) 0xDEADBEEF;
+}
+
 template< uint32_t DATACOUNT_HASHSET_TEST >
 int test( char * argv ) {
    uint32_t * data = ( uint32_t * ) malloc( DATACOUNT_HASHSET_TEST * sizeof( uint32_t ) );
@@ -209,6 +1461,222 @@ int test( char * argv ) {
       passed &= test_vectorized_batch_build< 97, DATACOUNT_HASHSET_TEST >( data, result, result_count );
       passed &= test_vectorized_batch_build< 98, DATACOUNT_HASHSET_TEST >( data, result, result_count );
       passed &= test_vectorized_batch_build< 99, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+   }else if( std::string{"ge"}.compare( argv ) == 0 ) {
+      passed &= test_growable_build< 10, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 20, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 30, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 40, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 50, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 60, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 70, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 80, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 90, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 91, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 92, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 93, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 94, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 95, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 96, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 97, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 98, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_growable_build< 99, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+   }else if( std::string{"gb"}.compare( argv ) == 0 ) {
+      passed &= test_growable_build< 10, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 20, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 30, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 40, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 50, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 60, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 70, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 80, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 90, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 91, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 92, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 93, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 94, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 95, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 96, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 97, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 98, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_growable_build< 99, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+   }else if( std::string{"p2"}.compare( argv ) == 0 ) {
+      passed &= test_scalar_elem_build< 10, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_scalar_elem_build< 50, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_scalar_elem_build< 90, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_scalar_elem_build< 99, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_scalar_batch_build< 10, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_scalar_batch_build< 50, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_scalar_batch_build< 90, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_scalar_batch_build< 99, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_vectorized_elem_build< 10, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_vectorized_elem_build< 50, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_vectorized_elem_build< 90, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_vectorized_elem_build< 99, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_vectorized_batch_build< 10, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_vectorized_batch_build< 50, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_vectorized_batch_build< 90, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_vectorized_batch_build< 99, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+   }else if( std::string{"fr"}.compare( argv ) == 0 ) {
+      passed &= test_scalar_elem_build< 10, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_scalar_elem_build< 50, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_scalar_elem_build< 90, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_scalar_elem_build< 99, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_scalar_batch_build< 10, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_scalar_batch_build< 50, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_scalar_batch_build< 90, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_scalar_batch_build< 99, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_vectorized_elem_build< 10, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_vectorized_elem_build< 50, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_vectorized_elem_build< 90, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_vectorized_elem_build< 99, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_vectorized_batch_build< 10, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_vectorized_batch_build< 50, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_vectorized_batch_build< 90, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_vectorized_batch_build< 99, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+   }else if( std::string{"pb"}.compare( argv ) == 0 ) {
+      passed &= test_partitioned_build< 10, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_partitioned_build< 50, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_partitioned_build< 90, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_partitioned_build< 99, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+   }else if( std::string{"rx"}.compare( argv ) == 0 ) {
+      passed &= test_radix_build< 50, DATACOUNT_HASHSET_TEST, uint32_t, 1, 1 >( data, result, result_count );
+      passed &= test_radix_build< 90, DATACOUNT_HASHSET_TEST, uint32_t, 6, 1 >( data, result, result_count );
+      passed &= test_radix_build< 90, DATACOUNT_HASHSET_TEST, uint32_t, 4, 2 >( data, result, result_count );
+      passed &= test_radix_build< 99, DATACOUNT_HASHSET_TEST, uint32_t, 5, 3 >( data, result, result_count );
+      passed &= test_radix_build< 90, DATACOUNT_HASHSET_TEST, uint32_t, 12, 1 >( data, result, result_count );
+      passed &= test_radix_build< 90, DATACOUNT_HASHSET_TEST, uint64_t, 4, 2 >( data, result, result_count );
+   }else if( std::string{"ca"}.compare( argv ) == 0 ) {
+      passed &= test_concurrent_build< 10, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_concurrent_build< 50, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_concurrent_build< 90, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_concurrent_build< 99, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+   }else if( std::string{"cd"}.compare( argv ) == 0 ) {
+      passed &= test_concurrent_build< 10, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_concurrent_build< 50, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_concurrent_build< 90, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_concurrent_build< 99, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+   }else if( std::string{"pg"}.compare( argv ) == 0 ) {
+      passed &= test_grouped_probe< 10, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_grouped_probe< 50, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_grouped_probe< 90, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_grouped_probe< 99, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+   }else if( std::string{"x2"}.compare( argv ) == 0 ) {
+      passed &= test_simd_build< 10, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_simd_build< 50, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_simd_build< 90, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_simd_build< 99, DATACOUNT_HASHSET_TEST, false, slot_mapping_fastrange >( data, result, result_count );
+   }else if( std::string{"x5"}.compare( argv ) == 0 ) {
+      passed &= test_simd_build< 10, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_simd_build< 50, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_simd_build< 90, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_simd_build< 99, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_simd_build< 90, DATACOUNT_HASHSET_TEST, true, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_simd_build< 99, DATACOUNT_HASHSET_TEST, true, slot_mapping_fastrange >( data, result, result_count );
+   }else if( std::string{"il"}.compare( argv ) == 0 ) {
+      passed &= test_interleaved_build< 50, DATACOUNT_HASHSET_TEST, uint8_t, false >( data, result, result_count );
+      passed &= test_interleaved_build< 90, DATACOUNT_HASHSET_TEST, uint8_t, true >( data, result, result_count );
+      passed &= test_interleaved_build< 50, DATACOUNT_HASHSET_TEST, uint16_t, true >( data, result, result_count );
+      passed &= test_interleaved_build< 90, DATACOUNT_HASHSET_TEST, uint16_t, false >( data, result, result_count );
+      passed &= test_interleaved_build< 50, DATACOUNT_HASHSET_TEST, uint32_t, false >( data, result, result_count );
+      passed &= test_interleaved_build< 99, DATACOUNT_HASHSET_TEST, uint32_t, true >( data, result, result_count );
+   }else if( std::string{"ck"}.compare( argv ) == 0 ) {
+      passed &= test_cuckoo_build< 50, DATACOUNT_HASHSET_TEST, 8, false, false >( data, result, result_count );
+      passed &= test_cuckoo_build< 90, DATACOUNT_HASHSET_TEST, 8, true, false >( data, result, result_count );
+      passed &= test_cuckoo_build< 95, DATACOUNT_HASHSET_TEST, 8, false, true >( data, result, result_count );
+      passed &= test_cuckoo_build< 99, DATACOUNT_HASHSET_TEST, 8, true, true >( data, result, result_count );
+      passed &= test_cuckoo_build< 50, DATACOUNT_HASHSET_TEST, 4, true, true >( data, result, result_count );
+      passed &= test_cuckoo_build< 90, DATACOUNT_HASHSET_TEST, 4, false, true >( data, result, result_count );
+      passed &= test_cuckoo_build< 95, DATACOUNT_HASHSET_TEST, 4, true, false >( data, result, result_count );
+   }else if( std::string{"rh"}.compare( argv ) == 0 ) {
+      passed &= test_robin_hood< 10, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_robin_hood< 50, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_robin_hood< 90, DATACOUNT_HASHSET_TEST, false >( data, result, result_count );
+      passed &= test_robin_hood< 99, DATACOUNT_HASHSET_TEST, true >( data, result, result_count );
+      passed &= test_robin_hood< 90, DATACOUNT_HASHSET_TEST, true, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_robin_hood< 99, DATACOUNT_HASHSET_TEST, false, slot_mapping_fastrange >( data, result, result_count );
+   }else if( std::string{"bf"}.compare( argv ) == 0 ) {
+      passed &= test_bloom_filter< 50, DATACOUNT_HASHSET_TEST, 10 >( data, result, result_count );
+      passed &= test_bloom_filter< 90, DATACOUNT_HASHSET_TEST, 10 >( data, result, result_count );
+      passed &= test_bloom_filter< 99, DATACOUNT_HASHSET_TEST, 16 >( data, result, result_count );
+      passed &= test_bloom_filter< 90, DATACOUNT_HASHSET_TEST, 4 >( data, result, result_count );
+   }else if( std::string{"64"}.compare( argv ) == 0 ) {
+      passed &= test_uint64_build< 50, DATACOUNT_HASHSET_TEST, 0 >( data, result, result_count );
+      passed &= test_uint64_build< 90, DATACOUNT_HASHSET_TEST, 1 >( data, result, result_count );
+      passed &= test_uint64_build< 90, DATACOUNT_HASHSET_TEST, 2 >( data, result, result_count );
+      passed &= test_uint64_build< 99, DATACOUNT_HASHSET_TEST, 3 >( data, result, result_count );
+      passed &= test_uint64_build< 90, DATACOUNT_HASHSET_TEST, 3, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_uint64_build< 90, DATACOUNT_HASHSET_TEST, 3, slot_mapping_fastrange >( data, result, result_count );
+   }else if( std::string{"hf"}.compare( argv ) == 0 ) {
+      passed &= test_hash_function< 90, DATACOUNT_HASHSET_TEST, murmur3< uint32_t >, true >( data, result, result_count );
+      passed &= test_hash_function< 90, DATACOUNT_HASHSET_TEST, multiply_shift< uint32_t >, true >( data, result, result_count );
+      passed &= test_hash_function< 50, DATACOUNT_HASHSET_TEST, multiply_shift< uint32_t >, false >( data, result, result_count );
+      passed &= test_hash_function< 90, DATACOUNT_HASHSET_TEST, crc32c< uint32_t >, true >( data, result, result_count );
+      passed &= test_hash_function< 50, DATACOUNT_HASHSET_TEST, crc32c< uint32_t >, false >( data, result, result_count );
+      passed &= test_hash_function< 90, DATACOUNT_HASHSET_TEST, tabulation< uint32_t >, true >( data, result, result_count );
+      passed &= test_hash_function< 50, DATACOUNT_HASHSET_TEST, tabulation< uint32_t >, false >( data, result, result_count );
+   }else if( std::string{"hb"}.compare( argv ) == 0 ) {
+      passed &= test_hash_batch< DATACOUNT_HASHSET_TEST, uint32_t >( data, result, result_count );
+      passed &= test_hash_batch< DATACOUNT_HASHSET_TEST, uint64_t >( data, result, result_count );
+   }else if( std::string{"mm"}.compare( argv ) == 0 ) {
+      passed &= test_mapped< 50, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_mapped< 90, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_mapped< 90, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+   }else if( std::string{"st"}.compare( argv ) == 0 ) {
+      passed &= test_stream_build< 50, DATACOUNT_HASHSET_TEST, 1 >( data, result, result_count );
+      passed &= test_stream_build< 90, DATACOUNT_HASHSET_TEST, 7 >( data, result, result_count );
+      passed &= test_stream_build< 90, DATACOUNT_HASHSET_TEST, 255 >( data, result, result_count );
+      passed &= test_stream_build< 90, DATACOUNT_HASHSET_TEST, 4096 >( data, result, result_count );
+      passed &= test_stream_build< 90, DATACOUNT_HASHSET_TEST, 0 >( data, result, result_count );
+      passed &= test_stream_build< 99, DATACOUNT_HASHSET_TEST, 0, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_stream_build< 99, DATACOUNT_HASHSET_TEST, 1000, slot_mapping_fastrange >( data, result, result_count );
+   }else if( std::string{"dl"}.compare( argv ) == 0 ) {
+      passed &= test_remove< 50, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_remove< 80, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_remove< 80, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_remove< 80, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+      passed &= test_revive< 50, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_revive< 80, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+   }else if( std::string{"al"}.compare( argv ) == 0 ) {
+      passed &= test_allocation< 90, DATACOUNT_HASHSET_TEST, container_allocation_new >( data, result, result_count );
+      passed &= test_allocation< 90, DATACOUNT_HASHSET_TEST,
+         container_allocation_mapped< huge_pages::none, numa_placement::first_touch, 1 > >( data, result, result_count );
+      passed &= test_allocation< 50, DATACOUNT_HASHSET_TEST,
+         container_allocation_mapped< huge_pages::transparent, numa_placement::first_touch > >( data, result, result_count );
+      passed &= test_allocation< 90, DATACOUNT_HASHSET_TEST,
+         container_allocation_mapped< huge_pages::transparent, numa_placement::interleave, 3 > >( data, result, result_count );
+      passed &= test_allocation< 90, DATACOUNT_HASHSET_TEST,
+         container_allocation_mapped< huge_pages::reserved, numa_placement::local > >( data, result, result_count );
+   }else if( std::string{"sx"}.compare( argv ) == 0 ) {
+      passed &= test_statistics< 50, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_statistics< 90, DATACOUNT_HASHSET_TEST >( data, result, result_count );
+      passed &= test_statistics< 99, DATACOUNT_HASHSET_TEST, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_statistics< 99, DATACOUNT_HASHSET_TEST, slot_mapping_fastrange >( data, result, result_count );
+   }else if( std::string{"hl"}.compare( argv ) == 0 ) {
+      passed &= test_hyperloglog< DATACOUNT_HASHSET_TEST, uint32_t, 4 >( data, result, result_count );
+      passed &= test_hyperloglog< DATACOUNT_HASHSET_TEST, uint32_t, 12 >( data, result, result_count );
+      passed &= test_hyperloglog< DATACOUNT_HASHSET_TEST, uint32_t, 14 >( data, result, result_count );
+      passed &= test_hyperloglog< DATACOUNT_HASHSET_TEST, uint64_t, 10 >( data, result, result_count );
+      passed &= test_hyperloglog< DATACOUNT_HASHSET_TEST, uint64_t, 16 >( data, result, result_count );
+   }else if( std::string{"cm"}.compare( argv ) == 0 ) {
+      passed &= test_count_min_sketch< DATACOUNT_HASHSET_TEST, uint32_t, false, 1024, 4 >( data, result, result_count );
+      passed &= test_count_min_sketch< DATACOUNT_HASHSET_TEST, uint32_t, false, 100, 1 >( data, result, result_count );
+      passed &= test_count_min_sketch< DATACOUNT_HASHSET_TEST, uint32_t, true, 1024, 5 >( data, result, result_count );
+      passed &= test_count_min_sketch< DATACOUNT_HASHSET_TEST, uint64_t, false, 4096, 8 >( data, result, result_count );
+      passed &= test_count_min_sketch< DATACOUNT_HASHSET_TEST, uint64_t, true, 333, 4 >( data, result, result_count );
+   }else if( std::string{"ex"}.compare( argv ) == 0 ) {
+      passed &= test_export< 50, DATACOUNT_HASHSET_TEST, uint32_t, 1 >( data, result, result_count );
+      passed &= test_export< 90, DATACOUNT_HASHSET_TEST, uint32_t, 3 >( data, result, result_count );
+      passed &= test_export< 90, DATACOUNT_HASHSET_TEST, uint32_t, 8, slot_mapping_power_of_two >( data, result, result_count );
+      passed &= test_export< 90, DATACOUNT_HASHSET_TEST, uint64_t, 1 >( data, result, result_count );
+      passed &= test_export< 90, DATACOUNT_HASHSET_TEST, uint64_t, 4, slot_mapping_fastrange >( data, result, result_count );
+   }else if( std::string{"mg"}.compare( argv ) == 0 ) {
+      passed &= test_merge< 50, DATACOUNT_HASHSET_TEST, uint32_t, 1, 1, true >( data, result, result_count );
+      passed &= test_merge< 50, DATACOUNT_HASHSET_TEST, uint32_t, 2, 1, true >( data, result, result_count );
+      passed &= test_merge< 90, DATACOUNT_HASHSET_TEST, uint32_t, 5, 3, true >( data, result, result_count );
+      passed &= test_merge< 90, DATACOUNT_HASHSET_TEST, uint32_t, 8, 4, true >( data, result, result_count );
+      passed &= test_merge< 90, DATACOUNT_HASHSET_TEST, uint32_t, 8, 4, false >( data, result, result_count );
+      passed &= test_merge< 90, DATACOUNT_HASHSET_TEST, uint64_t, 4, 2, true >( data, result, result_count );
+      passed &= test_merge< 90, DATACOUNT_HASHSET_TEST, uint64_t, 3, 1, false >( data, result, result_count );
    }
    free( ( void * ) result_count );
    free( ( void * ) result );